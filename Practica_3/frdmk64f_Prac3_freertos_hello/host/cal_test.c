@@ -0,0 +1,71 @@
+/*
+ * cal_test.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * CAL_Convert contra las fórmulas enteras que reemplazó (monitor_core antes
+ * de calibration), para las 4096 lecturas de 12 bits:
+ *   - display y alarma: idénticos (truncan igual, mismos umbrales 15/285 y
+ *     340/370);
+ *   - pixel: las fórmulas viejas dividían entre 4096 y el display entre 4095;
+ *     calibration usa 4095 para los dos, así que en unas cuantas lecturas la
+ *     fila sube uno. Se reporta cuántas y se exige que no pase de uno.
+ */
+
+#include <stdio.h>
+
+#include "monitor_cfg.h"
+
+/* ======= Fórmulas originales ======= */
+static uint16_t old_heart_centimV(uint16_t raw) { return (uint16_t)(((uint32_t)raw * 300U) / 4095U); }
+static uint16_t old_temp_deciC(uint16_t raw)    { return (uint16_t)(340U + (((uint32_t)raw * 60U) / 4095U)); }
+static uint16_t old_heart_pixel(uint16_t raw)   { return (uint16_t)((((uint32_t)raw * MON_HALF_H) / 4096U) + MON_HALF_H); }
+static uint16_t old_temp_pixel(uint16_t raw)    { return (uint16_t)(((uint32_t)raw * MON_HALF_H) / 4096U); }
+static bool     old_heart_fault(uint16_t v)     { return (v >= 285U) || (v <= 15U); }
+static bool     old_temp_fault(uint16_t v)      { return (v >= 370U) || (v <= 340U); }
+
+int main(void)
+{
+    uint32_t failures = 0, pix_diff[2] = { 0, 0 };
+
+    if (!CAL_Init(MON_SRC_HEART, &mon_cal_heart) || !CAL_Init(MON_SRC_TEMP, &mon_cal_temp))
+    {
+        printf("CAL_Init falló\n");
+        return 2;
+    }
+
+    for (uint16_t raw = 0; raw < 4096U; raw++)
+    {
+        for (uint8_t ch = 0; ch < 2U; ch++)
+        {
+            cal_result_t r;
+            uint16_t d   = (ch == MON_SRC_HEART) ? old_heart_centimV(raw) : old_temp_deciC(raw);
+            uint16_t pix = (ch == MON_SRC_HEART) ? old_heart_pixel(raw) : old_temp_pixel(raw);
+            bool     f   = (ch == MON_SRC_HEART) ? old_heart_fault(d) : old_temp_fault(d);
+
+            (void)CAL_Convert(ch, raw, &r);
+            if ((r.display != d) || (r.fault != f))
+            {
+                if (failures++ < 10U)
+                {
+                    printf("FALLA: canal %u raw %u: display %u (antes %u), alarma %d (antes %d)\n",
+                           (unsigned)ch, (unsigned)raw, r.display, d, r.fault, f);
+                }
+            }
+            if (r.pixel != pix)
+            {
+                pix_diff[ch]++;
+                if ((r.pixel != pix + 1U) && (failures++ < 10U))
+                {
+                    printf("FALLA: canal %u raw %u: fila %u (antes %u)\n", (unsigned)ch, (unsigned)raw, r.pixel, pix);
+                }
+            }
+        }
+    }
+
+    printf("display/alarma idénticos en 4096 lecturas x 2 canales; fila +1 en %u (HR) y %u (TEMP) lecturas\n",
+           (unsigned)pix_diff[0], (unsigned)pix_diff[1]);
+    printf("%s\n", (failures == 0U) ? "OK" : "FALLÓ");
+    return (failures == 0U) ? 0 : 1;
+}
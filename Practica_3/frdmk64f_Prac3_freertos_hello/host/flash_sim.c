@@ -0,0 +1,231 @@
+/*
+ * flash_sim.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "flash_sim.h"
+
+#include <string.h>
+#include <sys/mman.h>
+
+#include "fsl_flash.h"
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    uint8_t     *mem;
+    uint32_t     ops_left;      /* 0 = sin corte */
+    jmp_buf     *jmp;
+    uint32_t     rng;
+    fsim_stats_t stats;
+    uint8_t      torn[FSIM_SIZE / FSIM_PHRASE];   /* 1 = frase a medias */
+} fsim_ctx_t;
+
+static fsim_ctx_t s_sim = { .rng = 1U };
+
+/* ======= Prototipos locales ======= */
+static bool prv_in_range(uint32_t start, uint32_t len);
+static bool prv_cut_now(void);
+static void prv_mark_torn(uint32_t off, uint32_t len, uint8_t torn);
+
+/* ======= Helpers ======= */
+static bool prv_in_range(uint32_t start, uint32_t len)
+{
+    return (start >= FSIM_BASE) && (len <= FSIM_SIZE) && ((start - FSIM_BASE) <= (FSIM_SIZE - len));
+}
+
+/* Cuenta una operación; true si es la que se corta */
+static bool prv_cut_now(void)
+{
+    if (s_sim.ops_left == 0U)
+    {
+        return false;
+    }
+    return (--s_sim.ops_left == 0U);
+}
+
+static void prv_mark_torn(uint32_t off, uint32_t len, uint8_t torn)
+{
+    memset(&s_sim.torn[off / FSIM_PHRASE], torn, len / FSIM_PHRASE);
+}
+
+/* ======= API del simulador ======= */
+bool FSIM_Init(void)
+{
+    void *p = mmap((void *)(uintptr_t)FSIM_BASE, FSIM_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if ((p == MAP_FAILED) || (p != (void *)(uintptr_t)FSIM_BASE))
+    {
+        return false;
+    }
+    s_sim.mem = p;
+    FSIM_EraseAll();
+    return true;
+}
+
+void FSIM_EraseAll(void)
+{
+    memset(s_sim.mem, 0xFF, FSIM_SIZE);
+    prv_mark_torn(0U, FSIM_SIZE, 0U);
+}
+
+void FSIM_ArmPowerCut(uint32_t ops_left, jmp_buf *jmp)
+{
+    s_sim.ops_left = ops_left;
+    s_sim.jmp      = jmp;
+}
+
+/* xorshift32: reproducible con la misma semilla */
+void FSIM_Seed(uint32_t seed)
+{
+    s_sim.rng = (seed != 0U) ? seed : 1U;
+}
+
+uint32_t FSIM_Rand(void)
+{
+    s_sim.rng ^= s_sim.rng << 13;
+    s_sim.rng ^= s_sim.rng >> 17;
+    s_sim.rng ^= s_sim.rng << 5;
+    return s_sim.rng;
+}
+
+const fsim_stats_t *FSIM_Stats(void)
+{
+    return &s_sim.stats;
+}
+
+void FSIM_ResetStats(void)
+{
+    memset(&s_sim.stats, 0, sizeof(s_sim.stats));
+}
+
+bool FSIM_IsTorn(uint32_t addr, uint32_t len)
+{
+    if (!prv_in_range(addr, len))
+    {
+        return false;
+    }
+    for (uint32_t off = addr - FSIM_BASE; off < (addr - FSIM_BASE + len); off += FSIM_PHRASE)
+    {
+        if (s_sim.torn[off / FSIM_PHRASE] != 0U)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t FSIM_EstimatedUs(void)
+{
+    return ((uint64_t)s_sim.stats.phrases * FSIM_T_PHRASE_US) + ((uint64_t)s_sim.stats.erases * FSIM_T_ERASE_US);
+}
+
+/* ======= Driver FTFx simulado ======= */
+status_t FLASH_Init(flash_config_t *config)
+{
+    (void)config;
+    return (s_sim.mem != NULL) ? kStatus_FTFx_Success : kStatus_FTFx_AccessError;
+}
+
+status_t FTFx_CACHE_Init(ftfx_cache_config_t *config)
+{
+    (void)config;
+    return kStatus_FTFx_Success;
+}
+
+status_t FTFx_CACHE_ClearCachePrefetchSpeculation(ftfx_cache_config_t *config, bool isPreProcess)
+{
+    (void)config;
+    (void)isPreProcess;
+    return kStatus_FTFx_Success;
+}
+
+status_t FLASH_Program(flash_config_t *config, uint32_t start, uint8_t *src, uint32_t lengthInBytes)
+{
+    (void)config;
+    if (((start % FSIM_PHRASE) != 0U) || ((lengthInBytes % FSIM_PHRASE) != 0U))
+    {
+        return kStatus_FTFx_AlignmentError;
+    }
+    if (!prv_in_range(start, lengthInBytes))
+    {
+        return kStatus_FTFx_AddressError;
+    }
+
+    s_sim.stats.program_cmds++;
+    for (uint32_t off = 0; off < lengthInBytes; off += FSIM_PHRASE)
+    {
+        uint8_t *dst   = &s_sim.mem[start - FSIM_BASE + off];
+        bool     erased = true;
+
+        for (uint32_t i = 0; i < FSIM_PHRASE; i++)
+        {
+            erased = erased && (dst[i] == 0xFFU);
+        }
+        if (!erased)
+        {
+            s_sim.stats.overprograms++;
+        }
+
+        if (prv_cut_now())
+        {
+            /* Frase a medias: solo algunos de los bits que bajaban */
+            for (uint32_t i = 0; i < FSIM_PHRASE; i++)
+            {
+                dst[i] &= (uint8_t)(src[off + i] | (uint8_t)FSIM_Rand());
+            }
+            prv_mark_torn(start - FSIM_BASE + off, FSIM_PHRASE, 1U);
+            longjmp(*s_sim.jmp, 1);
+        }
+        for (uint32_t i = 0; i < FSIM_PHRASE; i++)
+        {
+            dst[i] &= src[off + i];
+        }
+        s_sim.stats.phrases++;
+    }
+    return kStatus_FTFx_Success;
+}
+
+status_t FLASH_Erase(flash_config_t *config, uint32_t start, uint32_t lengthInBytes, uint32_t key)
+{
+    (void)config;
+    if (key != kFTFx_ApiEraseKey)
+    {
+        return kStatus_FTFx_InvalidArgument;
+    }
+    if (((start % FLOG_SECTOR_SIZE) != 0U) || ((lengthInBytes % FLOG_SECTOR_SIZE) != 0U))
+    {
+        return kStatus_FTFx_AlignmentError;
+    }
+    if (!prv_in_range(start, lengthInBytes))
+    {
+        return kStatus_FTFx_AddressError;
+    }
+
+    for (uint32_t off = 0; off < lengthInBytes; off += FLOG_SECTOR_SIZE)
+    {
+        uint8_t *dst = &s_sim.mem[start - FSIM_BASE + off];
+
+        if (prv_cut_now())
+        {
+            /* Borrado a medias: cada palabra puede haber subido a 0xFF o no */
+            for (uint32_t i = 0; i < FLOG_SECTOR_SIZE; i += 4U)
+            {
+                if (FSIM_Rand() & 1U)
+                {
+                    memset(&dst[i], 0xFF, 4U);
+                }
+            }
+            prv_mark_torn(start - FSIM_BASE + off, FLOG_SECTOR_SIZE, 1U);
+            longjmp(*s_sim.jmp, 1);
+        }
+        memset(dst, 0xFF, FLOG_SECTOR_SIZE);
+        prv_mark_torn(start - FSIM_BASE + off, FLOG_SECTOR_SIZE, 0U);
+        s_sim.stats.erases++;
+        s_sim.stats.sector_erases[(start - FSIM_BASE + off) / FLOG_SECTOR_SIZE]++;
+    }
+    return kStatus_FTFx_Success;
+}
@@ -0,0 +1,61 @@
+/*
+ * flash_sim.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * P-Flash simulada en RAM para correr flash_log en la PC. La región se mapea
+ * en la misma dirección que en la K64F (FLOG_BASE_ADDR), así flash_log.c la
+ * lee por puntero sin cambios. Reglas de la FTFE: borrado por sector a 0xFF,
+ * programación por frase de 8 bytes alineada que solo baja bits.
+ *
+ * Corte de energía: tras N operaciones (frase o sector) la siguiente queda a
+ * medias (bits al azar) y se regresa con longjmp al punto del arnés.
+ */
+
+#ifndef FLASH_SIM_H_
+#define FLASH_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+
+#include "flash_log.h"
+
+#define FSIM_BASE           FLOG_BASE_ADDR
+#define FSIM_SIZE           (FLOG_SECTOR_COUNT * FLOG_SECTOR_SIZE)
+#define FSIM_PHRASE         8U
+
+/* Tiempos típicos de la hoja de datos del K64 (ejecución del comando) */
+#define FSIM_T_PHRASE_US    90U         /* Program Phrase, tpgm8 */
+#define FSIM_T_ERASE_US     15000U      /* Erase Flash Sector, tersscr */
+
+typedef struct
+{
+    uint32_t program_cmds;      /* llamadas a FLASH_Program */
+    uint32_t phrases;           /* frases programadas */
+    uint32_t erases;            /* sectores borrados */
+    uint32_t overprograms;      /* frases programadas sin estar borradas (error) */
+    uint32_t sector_erases[FLOG_SECTOR_COUNT];
+} fsim_stats_t;
+
+/* Mapea la región y la deja borrada */
+bool     FSIM_Init(void);
+void     FSIM_EraseAll(void);
+
+/* ops_left = 0 desactiva el corte. jmp: a dónde regresar al cortar */
+void     FSIM_ArmPowerCut(uint32_t ops_left, jmp_buf *jmp);
+void     FSIM_Seed(uint32_t seed);
+uint32_t FSIM_Rand(void);
+
+const fsim_stats_t *FSIM_Stats(void);
+void     FSIM_ResetStats(void);
+
+/* true si alguna frase de [addr, addr+len) quedó a medias por un corte y no
+   se ha vuelto a borrar: ahí solo el CRC separa basura de un registro */
+bool     FSIM_IsTorn(uint32_t addr, uint32_t len);
+
+/* Tiempo de flash estimado con los contadores actuales (us) */
+uint64_t FSIM_EstimatedUs(void);
+
+#endif /* FLASH_SIM_H_ */
@@ -0,0 +1,346 @@
+/*
+ * flog_fuzz.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Pruebas de flash_log en la PC sobre flash_sim:
+ *  1) Cortes de energía al azar: cada ciclo monta, escribe y hace flush
+ *     hasta que se corta en una frase o un borrado cualquiera; después se
+ *     vuelve a montar y se revisa que:
+ *       - el montaje nunca falla y ninguna frase se programa dos veces,
+ *       - los registros salen en orden, completos y sin inventar nada,
+ *       - todo registro confirmado (FLOG_Flush == true) sigue ahí, salvo
+ *         los del sector más viejo, que la rotación puede estar borrando.
+ *     Un registro cortado que pasa el CRC16 (1 en 65536) no es falla del
+ *     montaje: se reporta aparte, y solo falla si son varios a la vez.
+ *  2) Throughput: registros por segundo con los tiempos típicos de la FTFE
+ *     y reparto del desgaste entre sectores.
+ *
+ * Uso: flog_fuzz [ciclos] [semilla]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "flash_log.h"
+#include "flash_sim.h"
+
+#define FUZZ_MAX_IDS        4000000U
+#define FUZZ_MAX_OPS        400U        /* operaciones de flash antes del corte */
+#define FUZZ_MAX_RECORDS    300U        /* registros por ciclo */
+#define FUZZ_RETAINED_MAX   (FLOG_SECTOR_COUNT * FLOG_SLOTS_PER_SECTOR)
+#define FLOG_MAGIC          0x474F4C46U /* igual que flash_log.c */
+#define FUZZ_MAX_ESCAPES    2U          /* por montaje; con un CRC16 sano casi siempre 0 */
+#define BENCH_RECORDS       200000U
+
+TickType_t g_host_tick;
+
+/* ======= Estado del arnés (static: sobrevive al longjmp) ======= */
+static uint8_t  s_acked[FUZZ_MAX_IDS];
+static uint32_t s_next_id = 1U;
+static uint32_t s_pending[FLOG_BATCH_RECORDS];
+static uint32_t s_pending_count;
+static uint32_t s_retained[FUZZ_RETAINED_MAX];
+static uint32_t s_retained_count;
+static uint32_t s_failures;
+static uint32_t s_crc_escapes;  /* registros a medias que pasaron el CRC16 (en este montaje) */
+static uint32_t s_max_escapes;
+
+/* ======= Contenido determinista por id ======= */
+static void prv_make(uint32_t id, uint8_t *type, uint8_t payload[FLOG_PAYLOAD_SIZE])
+{
+    uint32_t mix = id * 2654435761U;
+
+    *type = ((id % 5U) == 0U) ? (uint8_t)FLOG_TYPE_ALARM : (uint8_t)FLOG_TYPE_SUMMARY;
+    memcpy(&payload[0], &id, 4);
+    memcpy(&payload[4], &mix, 4);
+}
+
+static bool prv_matches(const flog_record_t *rec, uint32_t *id_out)
+{
+    uint8_t  type;
+    uint8_t  payload[FLOG_PAYLOAD_SIZE];
+    uint32_t id;
+
+    memcpy(&id, rec->payload, 4);
+    if ((id == 0U) || (id >= s_next_id))
+    {
+        return false;
+    }
+    prv_make(id, &type, payload);
+    *id_out = id;
+    return (rec->type == type) && (rec->len == FLOG_PAYLOAD_SIZE) && (rec->timestamp == id) &&
+           (memcmp(rec->payload, payload, FLOG_PAYLOAD_SIZE) == 0);
+}
+
+#define FAIL(...)  do { s_failures++; printf("FALLA: " __VA_ARGS__); printf("\n"); } while (0)
+
+/* ======= Carga de trabajo ======= */
+static bool prv_append_next(void)
+{
+    uint8_t  type;
+    uint8_t  payload[FLOG_PAYLOAD_SIZE];
+    uint32_t id = s_next_id;
+
+    prv_make(id, &type, payload);
+    g_host_tick = id;
+    if (!FLOG_Append(type, payload, FLOG_PAYLOAD_SIZE))
+    {
+        return false;
+    }
+    s_next_id++;
+    s_pending[s_pending_count++] = id;
+    return true;
+}
+
+static void prv_flush(void)
+{
+    if (FLOG_Flush())
+    {
+        for (uint32_t i = 0; i < s_pending_count; i++)
+        {
+            s_acked[s_pending[i]] = 1U;
+        }
+    }
+    s_pending_count = 0;
+}
+
+static void prv_workload(uint32_t records)
+{
+    for (uint32_t i = 0; i < records; i++)
+    {
+        if (!prv_append_next())
+        {
+            FAIL("append rechazado con el lote en %u", (unsigned)FLOG_Pending());
+            return;
+        }
+        if ((FLOG_Pending() == FLOG_BATCH_RECORDS) || ((FSIM_Rand() % 8U) == 0U))
+        {
+            prv_flush();
+        }
+    }
+    prv_flush();
+}
+
+/* ======= Revisión después de montar ======= */
+static bool prv_collect(const flog_record_t *rec, void *ctx)
+{
+    uint32_t id = 0;
+
+    (void)ctx;
+    if (!prv_matches(rec, &id))
+    {
+        /* Un registro cortado pasa el CRC16 con probabilidad 2^-16: se cuenta
+           aparte. Cualquier otro registro desconocido es una falla */
+        if (FSIM_IsTorn((uint32_t)(uintptr_t)rec, FLOG_RECORD_SIZE))
+        {
+            s_crc_escapes++;
+        }
+        else
+        {
+            FAIL("registro que nunca se escribió en 0x%08X", (unsigned)(uintptr_t)rec);
+        }
+        return true;
+    }
+    if ((s_retained_count > 0U) && (id <= s_retained[s_retained_count - 1U]))
+    {
+        FAIL("orden: id %u después de %u", (unsigned)id, (unsigned)s_retained[s_retained_count - 1U]);
+    }
+    if (s_retained_count < FUZZ_RETAINED_MAX)
+    {
+        s_retained[s_retained_count++] = id;
+    }
+    return true;
+}
+
+/* Primer id del segundo sector más viejo: de ahí en adelante la rotación no
+   ha tocado nada. Caja blanca: lee los encabezados de la flash simulada */
+static uint32_t prv_protected_from(void)
+{
+    uint32_t seqs[FLOG_SECTOR_COUNT];
+    uint8_t  secs[FLOG_SECTOR_COUNT];
+    uint8_t  n = 0;
+
+    for (uint8_t s = 0; s < FLOG_SECTOR_COUNT; s++)
+    {
+        const uint32_t *h = (const uint32_t *)(uintptr_t)(FLOG_BASE_ADDR + (uint32_t)s * FLOG_SECTOR_SIZE);
+        if ((h[0] == FLOG_MAGIC) && (h[1] == ~h[2]))
+        {
+            uint8_t k = n++;
+            while ((k > 0U) && (seqs[k - 1U] > h[1]))
+            {
+                seqs[k] = seqs[k - 1U];
+                secs[k] = secs[k - 1U];
+                k--;
+            }
+            seqs[k] = h[1];
+            secs[k] = s;
+        }
+    }
+    if (n < 2U)
+    {
+        return 0U;
+    }
+    const flog_record_t *recs = (const flog_record_t *)(uintptr_t)(FLOG_BASE_ADDR + (uint32_t)secs[1] * FLOG_SECTOR_SIZE);
+    for (uint16_t slot = 1; slot < FLOG_SLOTS_PER_SECTOR; slot++)
+    {
+        uint32_t id;
+        if (prv_matches(&recs[slot], &id))
+        {
+            return id;
+        }
+    }
+    return s_next_id;
+}
+
+static void prv_check(void)
+{
+    uint32_t from;
+    uint32_t r = 0;
+
+    if (!FLOG_Init())
+    {
+        FAIL("FLOG_Init falló al montar");
+        return;
+    }
+    s_retained_count = 0;
+    s_crc_escapes    = 0;
+    (void)FLOG_Iterate(prv_collect, NULL);
+    if (s_crc_escapes > s_max_escapes)
+    {
+        s_max_escapes = s_crc_escapes;
+    }
+    if (s_crc_escapes > FUZZ_MAX_ESCAPES)
+    {
+        FAIL("%u registros cortados pasaron el CRC en un solo montaje", (unsigned)s_crc_escapes);
+    }
+
+    /* Todo confirmado a partir de 'from' debe estar, sin huecos */
+    from = prv_protected_from();
+    for (uint32_t id = from; id < s_next_id; id++)
+    {
+        if (!s_acked[id])
+        {
+            continue;
+        }
+        while ((r < s_retained_count) && (s_retained[r] < id))
+        {
+            r++;
+        }
+        if ((r == s_retained_count) || (s_retained[r] != id))
+        {
+            FAIL("registro confirmado perdido: id %u (protegidos desde %u)", (unsigned)id, (unsigned)from);
+            return;
+        }
+    }
+}
+
+/* ======= Pruebas ======= */
+static void prv_fuzz(uint32_t cycles)
+{
+    static jmp_buf  jb;
+    static uint32_t cuts;
+    static uint32_t cycle;
+    uint32_t max_retained = 0;
+
+    FSIM_EraseAll();
+    FSIM_ResetStats();
+    for (cycle = 0; (cycle < cycles) && (s_failures == 0U); cycle++)
+    {
+        s_pending_count = 0;
+        FSIM_ArmPowerCut(1U + (FSIM_Rand() % FUZZ_MAX_OPS), &jb);
+        if (setjmp(jb) == 0)
+        {
+            if (!FLOG_Init())
+            {
+                FAIL("FLOG_Init falló");
+            }
+            prv_workload(FSIM_Rand() % FUZZ_MAX_RECORDS);
+        }
+        else
+        {
+            cuts++;
+        }
+        FSIM_ArmPowerCut(0U, NULL);
+        if (s_next_id + FUZZ_MAX_RECORDS >= FUZZ_MAX_IDS)
+        {
+            break;
+        }
+        prv_check();
+        if (s_retained_count > max_retained)
+        {
+            max_retained = s_retained_count;
+        }
+    }
+    if (FSIM_Stats()->overprograms != 0U)
+    {
+        FAIL("%u frases programadas sin borrar", (unsigned)FSIM_Stats()->overprograms);
+    }
+    printf("fuzz: %u ciclos, %u cortes, %u registros escritos, hasta %u retenidos, hasta %u cortados que pasaron el CRC\n",
+           (unsigned)cycle, (unsigned)cuts, (unsigned)(s_next_id - 1U), (unsigned)max_retained,
+           (unsigned)s_max_escapes);
+}
+
+static void prv_bench(void)
+{
+    struct timespec t0, t1;
+    const fsim_stats_t *st = FSIM_Stats();
+    uint32_t emin = UINT32_MAX, emax = 0;
+    double   host_s, flash_s;
+
+    FSIM_EraseAll();
+    FSIM_ResetStats();
+    s_pending_count = 0;
+    (void)FLOG_Init();
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++)
+    {
+        (void)prv_append_next();
+        if (FLOG_Pending() == FLOG_BATCH_RECORDS)
+        {
+            prv_flush();
+        }
+    }
+    prv_flush();
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    for (uint8_t s = 0; s < FLOG_SECTOR_COUNT; s++)
+    {
+        emin = (st->sector_erases[s] < emin) ? st->sector_erases[s] : emin;
+        emax = (st->sector_erases[s] > emax) ? st->sector_erases[s] : emax;
+    }
+    host_s  = (double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) * 1e-9);
+    flash_s = (double)FSIM_EstimatedUs() * 1e-6;
+    printf("throughput: %u registros en lotes de %u: %u comandos de programación, %u frases, %u borrados\n",
+           (unsigned)BENCH_RECORDS, (unsigned)FLOG_BATCH_RECORDS, (unsigned)st->program_cmds,
+           (unsigned)st->phrases, (unsigned)st->erases);
+    printf("  K64F estimado (%u us/frase, %u us/borrado): %.1f us/registro, %.0f registros/s\n",
+           (unsigned)FSIM_T_PHRASE_US, (unsigned)FSIM_T_ERASE_US, flash_s * 1e6 / BENCH_RECORDS,
+           BENCH_RECORDS / flash_s);
+    printf("  desgaste: %u..%u borrados por sector; PC: %.0f registros/s\n",
+           (unsigned)emin, (unsigned)emax, BENCH_RECORDS / host_s);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t cycles = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 20000U;
+    uint32_t seed   = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1U;
+
+    if (!FSIM_Init())
+    {
+        printf("no se pudo mapear la flash simulada en 0x%08X\n", (unsigned)FSIM_BASE);
+        return 2;
+    }
+    FSIM_Seed(seed);
+    prv_fuzz(cycles);
+    if (s_failures == 0U)
+    {
+        prv_bench();
+    }
+    printf("%s\n", (s_failures == 0U) ? "OK" : "FALLÓ");
+    return (s_failures == 0U) ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/*
+ * monitor_bench.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Cadena del monitor en la PC, sin RTOS: adc_sim -> CAL_Convert ->
+ * monitor_core, igual que GraphProcess/NumberProcess/LCDprint por muestra.
+ * Revisa rangos de display y pixel, que las alarmas se prendan y apaguen y
+ * que el cursor dé la vuelta cuando debe; después mide throughput y latencia
+ * por muestra (lotes de BENCH_BATCH, percentiles sobre los lotes).
+ *
+ * Uso: monitor_bench [muestras]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "adc_sim.h"
+#include "monitor_cfg.h"
+
+#define BENCH_BATCH     256U
+#define BENCH_DEFAULT   4000000U
+
+typedef struct
+{
+    uint32_t samples;
+    uint32_t faults;
+    uint32_t wraps;
+    uint16_t d_min, d_max;
+    uint8_t  p_min, p_max;
+} chan_stats_t;
+
+static chan_stats_t s_ch[2];
+static mon_trace_t  s_trace[2];
+static uint32_t     s_failures;
+static volatile uint32_t s_sink;   /* evita que el compilador quite el trabajo */
+
+#define FAIL(...)  do { s_failures++; printf("FALLA: " __VA_ARGS__); printf("\n"); } while (0)
+
+/* Una muestra por la cadena completa, modo "both" y escala 1 */
+static void prv_process(adc_sim_t *sim, uint8_t src)
+{
+    cal_result_t  r;
+    chan_stats_t *c = &s_ch[src];
+    uint8_t       row;
+
+    if (!CAL_Convert(src, ADC_SIM_Next(sim, src), &r))
+    {
+        FAIL("canal %u sin calibrar", (unsigned)src);
+        return;
+    }
+    row = (src == MON_SRC_HEART) ? MON_HeartRowForMode(r.pixel, both) : r.pixel;
+    if (MON_TraceAdvance(&s_trace[src], row, 1U))
+    {
+        c->wraps++;
+    }
+
+    c->samples++;
+    c->faults += r.fault ? 1U : 0U;
+    if (r.display < c->d_min) c->d_min = r.display;
+    if (r.display > c->d_max) c->d_max = r.display;
+    if (row < c->p_min)       c->p_min = row;
+    if (row > c->p_max)       c->p_max = row;
+    s_sink += r.display;
+}
+
+static int prv_cmp(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double prv_now_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((double)t.tv_sec * 1e9) + (double)t.tv_nsec;
+}
+
+static void prv_check(uint8_t src, const cal_config_t *cfg)
+{
+    const chan_stats_t *c = &s_ch[src];
+    uint32_t expect_wraps = c->samples / MON_SCREEN_W;
+
+    if ((c->d_min < cfg->unit_min) || (c->d_max > cfg->unit_max))
+    {
+        FAIL("canal %u: display %u..%u fuera de %u..%u", (unsigned)src, c->d_min, c->d_max,
+             cfg->unit_min, cfg->unit_max);
+    }
+    if ((c->p_min < cfg->pix_base) || (c->p_max >= (cfg->pix_base + cfg->pix_span)))
+    {
+        FAIL("canal %u: fila %u..%u fuera de la mitad de pantalla", (unsigned)src, c->p_min, c->p_max);
+    }
+    if ((c->faults == 0U) || (c->faults == c->samples))
+    {
+        FAIL("canal %u: la alarma nunca cambia (%u de %u)", (unsigned)src, c->faults, c->samples);
+    }
+    if ((c->wraps != expect_wraps) && (c->wraps != expect_wraps - 1U))
+    {
+        FAIL("canal %u: %u vueltas del cursor, se esperaban ~%u", (unsigned)src, c->wraps, expect_wraps);
+    }
+    printf("canal %u: display %u..%u, fila %u..%u, %.1f%% en alarma\n", (unsigned)src,
+           c->d_min, c->d_max, c->p_min, c->p_max, 100.0 * c->faults / c->samples);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t n = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT;
+    uint32_t batches = n / BENCH_BATCH;
+    double  *lat;
+    double   t0, t_total = 0.0;
+    adc_sim_t sim;
+
+    if (batches == 0U)
+    {
+        batches = 1U;
+    }
+    lat = malloc(batches * sizeof(double));
+    if ((lat == NULL) || !CAL_Init(MON_SRC_HEART, &mon_cal_heart) || !CAL_Init(MON_SRC_TEMP, &mon_cal_temp))
+    {
+        printf("no se pudo inicializar\n");
+        return 2;
+    }
+    for (uint8_t s = 0; s < 2U; s++)
+    {
+        s_ch[s].d_min = 0xFFFFU;
+        s_ch[s].p_min = 0xFFU;
+        MON_TraceReset(&s_trace[s]);
+    }
+
+    /* Canales alternados, como el muestreo del driver */
+    ADC_SIM_Init(&sim, 0U);
+    for (uint32_t b = 0; b < batches; b++)
+    {
+        t0 = prv_now_ns();
+        for (uint32_t i = 0; i < BENCH_BATCH; i++)
+        {
+            prv_process(&sim, (uint8_t)(i & 1U));
+        }
+        lat[b] = (prv_now_ns() - t0) / BENCH_BATCH;
+        t_total += lat[b] * BENCH_BATCH;
+    }
+
+    prv_check(MON_SRC_HEART, &mon_cal_heart);
+    prv_check(MON_SRC_TEMP, &mon_cal_temp);
+
+    qsort(lat, batches, sizeof(double), prv_cmp);
+    printf("throughput: %u muestras, %.1f M muestras/s\n", (unsigned)(batches * BENCH_BATCH),
+           (batches * BENCH_BATCH) / t_total * 1e3);
+    printf("latencia por muestra (ns): p50 %.1f  p99 %.1f  máx %.1f\n",
+           lat[batches / 2U], lat[(batches * 99U) / 100U], lat[batches - 1U]);
+    free(lat);
+
+    printf("%s\n", (s_failures == 0U) ? "OK" : "FALLÓ");
+    return (s_failures == 0U) ? 0 : 1;
+}
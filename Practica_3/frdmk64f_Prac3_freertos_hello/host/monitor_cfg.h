@@ -0,0 +1,19 @@
+/*
+ * monitor_cfg.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Configuración del monitor para las pruebas en la PC: la calibración es la
+ * misma de la tarjeta (source/monitor_cal.h).
+ */
+
+#ifndef MONITOR_CFG_H_
+#define MONITOR_CFG_H_
+
+#include "monitor_cal.h"
+
+#define MON_SRC_HEART   0U
+#define MON_SRC_TEMP    1U
+
+#endif /* MONITOR_CFG_H_ */
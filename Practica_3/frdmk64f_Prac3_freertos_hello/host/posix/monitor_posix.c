@@ -0,0 +1,250 @@
+/*
+ * monitor_posix.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * La cadena del monitor sobre FreeRTOS en Linux (port GCC/Posix): un timer
+ * hace de driver ADC con adc_sim, la convierte una vez con calibration y la
+ * manda dos veces a AdcConversionQueue como AdcForwarder_task;
+ * GraphProcess/NumberProcess solo avanzan la traza de monitor_core. Mide:
+ *   - latencia: timer cada SAMPLE_PERIOD_MS, de la conversión al consumo;
+ *   - throughput: un productor llena la cola tan rápido como puede.
+ * Los tiempos son de Linux, no de la K64F: sirven para comparar cambios en CI.
+ *
+ * Uso: monitor_posix [periodos]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+#include "adc_sim.h"
+#include "monitor_cfg.h"
+
+#define SAMPLE_PERIOD_MS    1U
+#define CONV_QUEUE_LEN      8U
+#define FLOOD_SAMPLES       200000U
+#define DEFAULT_PERIODS     2000U
+
+/* Prioridades como en main.c: ADC arriba, procesamiento en medio */
+#define PROC_PRIORITY       (tskIDLE_PRIORITY + 2)
+#define FLOOD_PRIORITY      (tskIDLE_PRIORITY + 1)
+#define REPORT_PRIORITY     (tskIDLE_PRIORITY + 3)
+
+typedef struct
+{
+    uint8_t      convSource;
+    cal_result_t r;
+    uint64_t     t_ns;      /* hora de envío (solo para medir) */
+} msg_t;
+
+typedef struct
+{
+    QueueHandle_t conv;
+    TimerHandle_t sampler;
+    TaskHandle_t  report;
+    adc_sim_t     sim;
+    uint8_t       next_src;
+    uint32_t      periods;
+    uint32_t      sent;
+    uint32_t      done;         /* conversiones hechas (ambas tareas) */
+    uint32_t      target;
+    uint32_t      dropped;      /* cola llena en el timer */
+    uint32_t      failures;     /* CAL_Convert falló (muestra descartada) */
+    double       *lat_us;
+    mon_trace_t   trace[2];
+} posix_ctx_t;
+
+static posix_ctx_t s_ctx;
+
+/* ======= Prototipos locales ======= */
+static uint64_t prv_now_ns(void);
+static void prv_sampler_cb(TimerHandle_t t);
+static void prv_proc_task(void *pvParameters);
+static void prv_flood_task(void *pvParameters);
+static void prv_report_task(void *pvParameters);
+static int  prv_cmp(const void *a, const void *b);
+static void prv_expect_less(uint32_t n);
+
+/* ======= Helpers ======= */
+static uint64_t prv_now_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((uint64_t)t.tv_sec * 1000000000ULL) + (uint64_t)t.tv_nsec;
+}
+
+static int prv_cmp(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* n copias que ya no van a llegar a los consumidores */
+static void prv_expect_less(uint32_t n)
+{
+    taskENTER_CRITICAL();
+    s_ctx.target -= n;
+    if ((s_ctx.target != 0U) && (s_ctx.done == s_ctx.target))
+    {
+        xTaskNotifyGive(s_ctx.report);
+    }
+    taskEXIT_CRITICAL();
+}
+
+void vAssertCalled(const char *file, unsigned long line)
+{
+    printf("configASSERT: %s:%lu\n", file, line);
+    exit(3);
+}
+
+/* ======= Tareas ======= */
+/* "ISR" del ADC: una muestra por periodo, canales alternados, dos copias */
+static void prv_sampler_cb(TimerHandle_t t)
+{
+    msg_t m;
+
+    (void)t;
+    if (s_ctx.sent >= s_ctx.periods)
+    {
+        return;
+    }
+    m.convSource   = s_ctx.next_src;
+    s_ctx.next_src ^= 1U;
+    s_ctx.sent++;
+    if (!CAL_Convert(m.convSource, ADC_SIM_Next(&s_ctx.sim, m.convSource), &m.r))
+    {
+        s_ctx.failures++;
+        prv_expect_less(2U);
+        return;
+    }
+    m.t_ns         = prv_now_ns();
+    for (uint8_t k = 0; k < 2U; k++)
+    {
+        if (xQueueSend(s_ctx.conv, &m, 0) != pdPASS)
+        {
+            s_ctx.dropped++;
+            prv_expect_less(1U);
+        }
+    }
+}
+
+/* GraphProcess + NumberProcess: la muestra ya viene convertida, una copia cada una */
+static void prv_proc_task(void *pvParameters)
+{
+    msg_t m;
+
+    (void)pvParameters;
+    for (;;)
+    {
+        if (xQueueReceive(s_ctx.conv, &m, portMAX_DELAY) != pdPASS)
+        {
+            continue;
+        }
+        taskENTER_CRITICAL();
+        (void)MON_TraceAdvance(&s_ctx.trace[m.convSource],
+                               (m.convSource == MON_SRC_HEART) ? MON_HeartRowForMode(m.r.pixel, both) : m.r.pixel, 1U);
+        if ((s_ctx.lat_us != NULL) && (s_ctx.done < s_ctx.target))
+        {
+            s_ctx.lat_us[s_ctx.done] = (double)(prv_now_ns() - m.t_ns) / 1000.0;
+        }
+        s_ctx.done++;
+        if (s_ctx.done == s_ctx.target)
+        {
+            xTaskNotifyGive(s_ctx.report);
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+
+static void prv_flood_task(void *pvParameters)
+{
+    msg_t m;
+
+    (void)pvParameters;
+    for (uint32_t i = 0; i < FLOOD_SAMPLES; i++)
+    {
+        m.convSource = (uint8_t)(i & 1U);
+        m.t_ns       = 0U;
+        if (!CAL_Convert(m.convSource, ADC_SIM_Next(&s_ctx.sim, m.convSource), &m.r))
+        {
+            s_ctx.failures++;
+            prv_expect_less(1U);
+            continue;
+        }
+        (void)xQueueSend(s_ctx.conv, &m, portMAX_DELAY);
+    }
+    vTaskSuspend(NULL);
+}
+
+static void prv_report_task(void *pvParameters)
+{
+    uint32_t n;
+    uint64_t t0;
+    double   secs;
+
+    (void)pvParameters;
+
+    /* 1) Latencia con el timer */
+    (void)xTimerStart(s_ctx.sampler, portMAX_DELAY);
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    (void)xTimerStop(s_ctx.sampler, portMAX_DELAY);
+    n = s_ctx.target;
+    qsort(s_ctx.lat_us, n, sizeof(double), prv_cmp);
+    printf("latencia (timer %u ms, %u conversiones, %u perdidas): p50 %.1f us  p99 %.1f us  máx %.1f us\n",
+           (unsigned)SAMPLE_PERIOD_MS, (unsigned)n, (unsigned)s_ctx.dropped,
+           s_ctx.lat_us[n / 2U], s_ctx.lat_us[(n * 99U) / 100U], s_ctx.lat_us[n - 1U]);
+
+    /* 2) Throughput con la cola siempre llena */
+    taskENTER_CRITICAL();
+    free(s_ctx.lat_us);
+    s_ctx.lat_us = NULL;
+    s_ctx.done   = 0U;
+    s_ctx.target = FLOOD_SAMPLES;
+    taskEXIT_CRITICAL();
+    t0 = prv_now_ns();
+    (void)xTaskCreate(prv_flood_task, "Flood", configMINIMAL_STACK_SIZE, NULL, FLOOD_PRIORITY, NULL);
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    secs = (double)(prv_now_ns() - t0) * 1e-9;
+    printf("throughput (cola de %u, 2 consumidores): %u muestras en %.3f s, %.0f muestras/s\n",
+           (unsigned)CONV_QUEUE_LEN, (unsigned)FLOOD_SAMPLES, secs, FLOOD_SAMPLES / secs);
+
+    if (s_ctx.dropped > (s_ctx.periods / 100U))
+    {
+        s_ctx.failures++;
+    }
+    printf("%s\n", (s_ctx.failures == 0U) ? "OK" : "FALLÓ");
+    exit((s_ctx.failures == 0U) ? 0 : 1);
+}
+
+int main(int argc, char **argv)
+{
+    s_ctx.periods = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : DEFAULT_PERIODS;
+    s_ctx.target  = s_ctx.periods * 2U;
+    s_ctx.lat_us  = malloc(s_ctx.target * sizeof(double));
+    s_ctx.conv    = xQueueCreate(CONV_QUEUE_LEN, sizeof(msg_t));
+    s_ctx.sampler = xTimerCreate("adc", pdMS_TO_TICKS(SAMPLE_PERIOD_MS), pdTRUE, NULL, prv_sampler_cb);
+    if ((s_ctx.lat_us == NULL) || (s_ctx.conv == NULL) || (s_ctx.sampler == NULL) ||
+        !CAL_Init(MON_SRC_HEART, &mon_cal_heart) || !CAL_Init(MON_SRC_TEMP, &mon_cal_temp))
+    {
+        printf("no se pudo inicializar\n");
+        return 2;
+    }
+    ADC_SIM_Init(&s_ctx.sim, 0U);
+    MON_TraceReset(&s_ctx.trace[0]);
+    MON_TraceReset(&s_ctx.trace[1]);
+
+    (void)xTaskCreate(prv_proc_task, "GraphProcess", configMINIMAL_STACK_SIZE, NULL, PROC_PRIORITY, NULL);
+    (void)xTaskCreate(prv_proc_task, "NumberProcess", configMINIMAL_STACK_SIZE, NULL, PROC_PRIORITY, NULL);
+    (void)xTaskCreate(prv_report_task, "Report", configMINIMAL_STACK_SIZE * 4, NULL, REPORT_PRIORITY,
+                      &s_ctx.report);
+
+    vTaskStartScheduler();
+    return 2;
+}
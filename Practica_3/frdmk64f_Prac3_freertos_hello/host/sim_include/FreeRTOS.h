@@ -0,0 +1,41 @@
+/*
+ * FreeRTOS.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Sustituto mínimo para compilar en la PC los módulos que solo usan
+ * secciones críticas, el contador de ticks, un mutex y una tarea auxiliar
+ * (flash_log, telemetry). Un solo hilo: las secciones críticas y el mutex
+ * no hacen nada, las tareas no corren y el tick lo avanza el arnés.
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t      TickType_t;
+typedef long          BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t      StackType_t;
+
+typedef struct { uint8_t dummy; } StaticTask_t;
+typedef struct { uint8_t dummy; } StaticSemaphore_t;
+
+#define pdTRUE   1
+#define pdFALSE  0
+#define pdPASS   pdTRUE
+
+#define portMAX_DELAY             ((TickType_t)0xFFFFFFFFU)
+#define pdMS_TO_TICKS(ms)         ((TickType_t)(ms))
+#define tskIDLE_PRIORITY          0U
+#define configMINIMAL_STACK_SIZE  90U
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+/* Tick simulado (lo define el arnés) */
+extern TickType_t g_host_tick;
+
+#endif /* FREERTOS_H */
@@ -0,0 +1,39 @@
+/*
+ * fsl_flash.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Mismas firmas que el driver FTFx del SDK que usa flash_log, implementadas
+ * en flash_sim.c sobre RAM.
+ */
+
+#ifndef FSL_FLASH_H_
+#define FSL_FLASH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int32_t status_t;
+
+enum
+{
+    kStatus_FTFx_Success          = 0,
+    kStatus_FTFx_InvalidArgument  = 4,
+    kStatus_FTFx_AlignmentError   = 101,
+    kStatus_FTFx_AddressError     = 102,
+    kStatus_FTFx_AccessError      = 103,
+};
+
+#define kFTFx_ApiEraseKey   0x6b65666bU     /* "kefk" */
+
+typedef struct { uint32_t unused; } flash_config_t;
+typedef struct { uint32_t unused; } ftfx_cache_config_t;
+
+status_t FLASH_Init(flash_config_t *config);
+status_t FLASH_Program(flash_config_t *config, uint32_t start, uint8_t *src, uint32_t lengthInBytes);
+status_t FLASH_Erase(flash_config_t *config, uint32_t start, uint32_t lengthInBytes, uint32_t key);
+status_t FTFx_CACHE_Init(ftfx_cache_config_t *config);
+status_t FTFx_CACHE_ClearCachePrefetchSpeculation(ftfx_cache_config_t *config, bool isPreProcess);
+
+#endif /* FSL_FLASH_H_ */
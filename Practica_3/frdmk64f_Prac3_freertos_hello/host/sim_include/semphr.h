@@ -0,0 +1,33 @@
+/*
+ * semphr.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef SEMPHR_H
+#define SEMPHR_H
+
+#include "FreeRTOS.h"
+
+typedef void *SemaphoreHandle_t;
+
+/* Un solo hilo: el mutex siempre está libre */
+static inline SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buf)
+{
+    return (SemaphoreHandle_t)buf;
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t m, TickType_t wait)
+{
+    (void)m; (void)wait;
+    return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t m)
+{
+    (void)m;
+    return pdTRUE;
+}
+
+#endif /* SEMPHR_H */
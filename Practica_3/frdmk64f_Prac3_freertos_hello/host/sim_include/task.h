@@ -0,0 +1,46 @@
+/*
+ * task.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+static inline TickType_t xTaskGetTickCount(void)
+{
+    return g_host_tick;
+}
+
+/* La tarea no corre: el arnés llama directo a lo que haría */
+static inline TaskHandle_t xTaskCreateStatic(TaskFunction_t fn, const char *name, uint32_t depth, void *param,
+                                             UBaseType_t prio, StackType_t *stack, StaticTask_t *tcb)
+{
+    (void)fn; (void)name; (void)depth; (void)param; (void)prio; (void)stack;
+    return (TaskHandle_t)tcb;
+}
+
+static inline BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    (void)task;
+    return pdPASS;
+}
+
+static inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait)
+{
+    (void)clear; (void)wait;
+    return 0U;
+}
+
+static inline void vTaskDelay(TickType_t ticks)
+{
+    g_host_tick += ticks;
+}
+
+#endif /* TASK_H */
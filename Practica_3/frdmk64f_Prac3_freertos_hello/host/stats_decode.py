@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# stats_decode.py
+#
+#  Created on: 19 oct 2026
+#      Author: luisg
+#
+# Decodifica las tramas de rtos_stats.h que salen por la UART de debug
+# (mezcladas con el texto de PRINTF) y resume % de CPU por tarea y % del
+# tiempo dormido (STOP/VLPS).
+#
+#   stats_decode.py /dev/ttyACM0 [segundos]     (requiere pyserial)
+#   stats_decode.py captura.bin                 (bytes crudos ya capturados)
+
+import struct
+import sys
+import time
+
+SYNC = b"\xA5\x5A"
+FRAME_TASKS, FRAME_NAMES, FRAME_POWER = 0x01, 0x02, 0x03
+TASKS_OVERFLOW = 0xFF
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, igual que crc16.c"""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def frames(buf):
+    """(tipo, payload) de cada trama válida; regresa también lo no consumido"""
+    out = []
+    i = 0
+    while True:
+        i = buf.find(SYNC, i)
+        if i < 0 or i + 4 > len(buf):
+            return out, buf[i:] if i >= 0 else buf[-1:]
+        ftype, n = buf[i + 2], buf[i + 3]
+        if i + 6 + n > len(buf):
+            return out, buf[i:]
+        crc = buf[i + 4 + n] | (buf[i + 5 + n] << 8)
+        if crc16(buf[i + 2:i + 4 + n]) == crc:
+            out.append((ftype, bytes(buf[i + 4:i + 4 + n])))
+            i += 6 + n
+        else:
+            i += 1          # sync falso dentro de texto o datos
+
+
+class Summary:
+    def __init__(self):
+        self.names = {}
+        self.cpu = {}       # task_num -> [centipct...]
+        self.hwm = {}
+        self.sleep = []
+        self.overflows = 0
+        self.wakeups = self.vlps = 0
+
+    def feed(self, ftype, p):
+        if ftype == FRAME_NAMES:
+            i = 0
+            while i < len(p):
+                end = p.index(0, i + 1)
+                self.names[p[i]] = p[i + 1:end].decode(errors="replace")
+                i = end + 1
+        elif ftype == FRAME_TASKS:
+            if p[0] == TASKS_OVERFLOW:
+                self.overflows += 1
+                return
+            for k in range(p[0]):
+                num, cpu, hwm = struct.unpack_from("<BHH", p, 1 + 5 * k)
+                self.cpu.setdefault(num, []).append(cpu)
+                self.hwm[num] = min(hwm, self.hwm.get(num, hwm))
+        elif ftype == FRAME_POWER:
+            pct, self.wakeups, self.vlps = struct.unpack_from("<HII", p)
+            self.sleep.append(pct)
+
+    def report(self):
+        print("tarea                 CPU prom  CPU máx  stack libre (palabras)")
+        for num in sorted(self.cpu):
+            v = self.cpu[num]
+            print("%-20s %7.2f%% %7.2f%%  %d" % (self.names.get(num, "#%d" % num),
+                  sum(v) / len(v) / 100.0, max(v) / 100.0, self.hwm[num]))
+        if self.sleep:
+            v = self.sleep
+            print("dormido: %.2f%% prom, %.2f..%.2f%% por periodo (%d periodos)"
+                  % (sum(v) / len(v) / 100.0, min(v) / 100.0, max(v) / 100.0, len(v)))
+            print("despertares: %d, VLPS: %d" % (self.wakeups, self.vlps))
+        if self.overflows:
+            print("¡%d periodos con más tareas que STATS_MAX_TASKS!" % self.overflows)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__ or "uso: stats_decode.py <puerto|archivo> [segundos]")
+        return 2
+    s = Summary()
+    src = sys.argv[1]
+    if src.startswith("/dev/") or src.upper().startswith("COM"):
+        import serial
+        secs = float(sys.argv[2]) if len(sys.argv) > 2 else 60.0
+        port = serial.Serial(src, 115200, timeout=0.5)
+        buf, end = b"", time.time() + secs
+        while time.time() < end:
+            buf += port.read(4096)
+            got, buf = frames(buf)
+            for f in got:
+                s.feed(*f)
+    else:
+        with open(src, "rb") as fh:
+            got, _ = frames(fh.read())
+            for f in got:
+                s.feed(*f)
+    s.report()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+#
+# telem_decode.py
+#
+#  Created on: 19 oct 2026
+#      Author: luisg
+#
+# Decodifica las tramas de telemetry.h que salen por la UART de debug
+# (mezcladas con el texto de PRINTF): COBS hasta cada 0x00, CRC-16 y seq por
+# canal. Escribe una línea CSV por trama y al final un resumen por canal con
+# tramas buenas, tramas con CRC malo y tramas perdidas según seq.
+#
+#   telem_decode.py /dev/ttyACM0 [--secs N] [--record captura.tlm]   (requiere pyserial)
+#   telem_decode.py captura.bin | captura.tlm | -                    (bytes ya capturados)
+#
+#   --csv archivo      tramas en CSV (t_s, canal, nombre, seq, tipo, valores...)
+#   --record archivo   guarda lo leído del puerto con tiempos, para telem_replay.py
+#   --expect B,M,P     sale con 1 si buenas/CRC malo/perdidas no son esas (pruebas)
+#
+# Una captura .tlm (de --record) es "TLM1" y luego registros
+# <u32 ms desde el inicio><u16 largo><bytes>; cualquier otra cosa se toma
+# como bytes crudos.
+
+import argparse
+import struct
+import sys
+import time
+
+TLM_MAGIC = b"TLM1"
+
+# telem_type_t
+TYPES = {
+    0: ("u8", "B"),
+    1: ("u16", "H"),
+    2: ("i16", "h"),
+    3: ("u32", "I"),
+    4: ("i32", "i"),
+    5: ("f32", "f"),
+    6: ("text", None),
+}
+
+# Canales de main.c (TELEM_CH_*)
+CHANNELS = {
+    0: "adc_heart",
+    1: "adc_temp",
+    8: "hr_centimV",
+    9: "temp_deciC",
+}
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, igual que crc16.c"""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Bytes de una trama sin el 0x00 final; None si el COBS no cuadra"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def payload_values(ftype, payload):
+    name, fmt = TYPES.get(ftype, ("?", None))
+    if fmt is None:
+        if name == "text":
+            return name, [payload.decode(errors="replace")]
+        return name, [payload.hex()]
+    size = struct.calcsize("<" + fmt)
+    if len(payload) % size:
+        return name, [payload.hex()]
+    return name, list(struct.unpack("<%d%s" % (len(payload) // size, fmt), payload))
+
+
+class Decoder:
+    def __init__(self, csv=None):
+        self.buf = bytearray()
+        self.csv = csv
+        self.good = {}      # canal -> tramas
+        self.lost = {}      # canal -> tramas perdidas según seq
+        self.last_seq = {}
+        self.bad = 0        # CRC o COBS malos
+        self.t0 = time.time()
+
+    def feed(self, data, t=None):
+        self.buf += data
+        while True:
+            end = self.buf.find(0)
+            if end < 0:
+                return
+            raw = bytes(self.buf[:end])
+            del self.buf[:end + 1]
+            if raw:
+                self.frame(raw, time.time() - self.t0 if t is None else t)
+
+    def frame(self, raw, t):
+        f = cobs_decode(raw)
+        if f is None or len(f) < 5 or crc16(f[:-2]) != (f[-2] | (f[-1] << 8)):
+            self.bad += 1
+            return
+        ch, ftype, seq = f[0], f[1], f[2]
+        if ch in self.last_seq:
+            self.lost[ch] = self.lost.get(ch, 0) + ((seq - self.last_seq[ch] - 1) & 0xFF)
+        self.last_seq[ch] = seq
+        self.good[ch] = self.good.get(ch, 0) + 1
+        if self.csv:
+            tname, vals = payload_values(ftype, f[3:-2])
+            self.csv.write(",".join(["%.3f" % t, str(ch), CHANNELS.get(ch, ""), str(seq), tname]
+                                    + [str(v) for v in vals]) + "\n")
+
+    def totals(self):
+        return sum(self.good.values()), self.bad, sum(self.lost.values())
+
+    def report(self):
+        print("canal  nombre        tramas  perdidas")
+        for ch in sorted(self.good):
+            print("%5d  %-12s %7d  %8d" % (ch, CHANNELS.get(ch, ""), self.good[ch], self.lost.get(ch, 0)))
+        good, bad, lost = self.totals()
+        print("total: %d buenas, %d con CRC malo, %d perdidas" % (good, bad, lost))
+
+
+def read_capture(data):
+    """(t_s, bytes) de una captura .tlm, o un solo bloque si son bytes crudos"""
+    if not data.startswith(TLM_MAGIC):
+        yield None, data
+        return
+    i = len(TLM_MAGIC)
+    while i + 6 <= len(data):
+        ms, n = struct.unpack_from("<IH", data, i)
+        yield ms / 1000.0, data[i + 6:i + 6 + n]
+        i += 6 + n
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decodificador de telemetry.h")
+    ap.add_argument("src", help="puerto serie, archivo o - (stdin)")
+    ap.add_argument("--secs", type=float, default=60.0)
+    ap.add_argument("--csv")
+    ap.add_argument("--record")
+    ap.add_argument("--expect")
+    args = ap.parse_args()
+
+    csv = open(args.csv, "w") if args.csv else None
+    d = Decoder(csv)
+    src = args.src
+    if src.startswith("/dev/") or src.upper().startswith("COM"):
+        import serial
+        port = serial.Serial(src, 115200, timeout=0.1)
+        rec = open(args.record, "wb") if args.record else None
+        if rec:
+            rec.write(TLM_MAGIC)
+        end = time.time() + args.secs
+        while time.time() < end:
+            chunk = port.read(4096)
+            if chunk:
+                if rec:
+                    rec.write(struct.pack("<IH", int((time.time() - d.t0) * 1000), len(chunk)) + chunk)
+                d.feed(chunk)
+        if rec:
+            rec.close()
+    elif src == "-":
+        while True:
+            chunk = sys.stdin.buffer.read1(4096)
+            if not chunk:
+                break
+            d.feed(chunk)
+    else:
+        with open(src, "rb") as fh:
+            for t, chunk in read_capture(fh.read()):
+                d.feed(chunk, t)
+    if csv:
+        csv.close()
+
+    d.report()
+    if args.expect:
+        want = tuple(int(v) for v in args.expect.split(","))
+        if d.totals() != want:
+            print("esperado %s, decodificado %s" % (want, d.totals()))
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,165 @@
+/*
+ * telem_gen.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Genera con telemetry.c (el mismo código de la tarjeta) una captura de
+ * tramas para probar telem_decode.py y telem_replay.py sin la tarjeta:
+ *   - TELEM_GEN_SAMPLES rondas con ADC crudo en los canales 0/1 y, cada
+ *     tanto, lecturas, texto y todos los tipos (payloads con ceros para
+ *     ejercitar COBS);
+ *   - envíos inválidos (canal o payload fuera de rango) que deben contarse
+ *     como descartados sin gastar seq;
+ *   - texto de PRINTF intercalado y un byte alterado en algunos lotes: cada
+ *     uno debe costar exactamente una trama (falla el CRC) y el decodificador
+ *     debe verla como un salto de seq en su canal.
+ * Al final imprime lo que el decodificador debe reportar, en el formato de
+ * telem_decode.py --expect.
+ *
+ * Uso: telem_gen captura.bin
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "telemetry.h"
+#include "console.h"
+
+#define TELEM_GEN_SAMPLES     2000U
+#define TELEM_GEN_TEXT_EVERY  7U     /* lotes entre textos de PRINTF */
+#define TELEM_GEN_FLIP_EVERY  11U    /* lotes entre bytes alterados */
+
+TickType_t g_host_tick;
+
+/* ======= "UART": la salida con las fallas inyectadas ======= */
+static FILE    *s_out;
+static uint32_t s_batches;
+static uint32_t s_corrupted;    /* tramas dañadas a propósito */
+static uint32_t s_failures;
+
+/* Envío crudo del debug console que usa telemetry.c */
+int DbgConsole_SendDataReliable(uint8_t *ch, size_t size)
+{
+    static const char text[] = "HR 72.15 mV, TEMP 36.6 C\r\n";
+
+    /* Una falla por lote como mucho: cada una daña solo la primera trama */
+    s_batches++;
+    if ((s_batches % TELEM_GEN_TEXT_EVERY) == 0U)
+    {
+        /* Sin 0x00: se pega a la primera trama del lote */
+        fwrite(text, 1, sizeof(text) - 1U, s_out);
+        s_corrupted++;
+    }
+    else if (((s_batches % TELEM_GEN_FLIP_EVERY) == 0U) && (size > 4U) && ((ch[2] ^ 0x10U) != 0U))
+    {
+        /* Dentro de la primera trama, sin tocar delimitadores */
+        ch[2] ^= 0x10U;
+        fwrite(ch, 1, size, s_out);
+        ch[2] ^= 0x10U;
+        s_corrupted++;
+        return 0;
+    }
+    fwrite(ch, 1, size, s_out);
+    return 0;
+}
+
+/* ======= Helpers ======= */
+static void prv_check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        fprintf(stderr, "FALLA: %s\n", what);
+        s_failures++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t  small[8];
+    uint8_t  big[TELEM_PAYLOAD_MAX + 1U];
+    telem_enc_t e;
+    uint32_t frames = 0U;
+    uint32_t i;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "uso: telem_gen captura.bin\n");
+        return 2;
+    }
+    s_out = fopen(argv[1], "wb");
+    if (s_out == NULL)
+    {
+        perror(argv[1]);
+        return 2;
+    }
+
+    /* Trama que no cabe: End regresa 0 */
+    TELEM_EncBegin(&e, small, sizeof(small));
+    TELEM_EncPut(&e, "0123456789", 10U);
+    prv_check(TELEM_EncEnd(&e) == 0U, "EncEnd con buffer chico debe regresar 0");
+
+    prv_check(TELEM_Init(), "TELEM_Init");
+
+    memset(big, 0xA5, sizeof(big));
+    prv_check(!TELEM_Send(TELEM_CHANNELS_MAX, TELEM_T_U8, big, 1U), "canal fuera de rango aceptado");
+    prv_check(!TELEM_Send(0U, TELEM_T_U8, big, TELEM_PAYLOAD_MAX + 1U), "payload de más aceptado");
+
+    for (i = 0; i < TELEM_GEN_SAMPLES; i++)
+    {
+        uint16_t heart = (uint16_t)(2048U + ((i * 37U) % 1024U));
+        uint16_t temp  = (uint16_t)(i & 0x0F00U);       /* bytes en cero seguido */
+
+        frames += TELEM_Send(0U, TELEM_T_U16, &heart, sizeof(heart)) ? 1U : 0U;
+        frames += TELEM_Send(1U, TELEM_T_U16, &temp, sizeof(temp)) ? 1U : 0U;
+
+        if ((i % 10U) == 0U)
+        {
+            uint16_t centimv = (uint16_t)(7000U + i);
+            int16_t  decic   = (int16_t)(365 - (int16_t)(i % 50U) * 10);
+            int32_t  i32     = -(int32_t)i * 1000;
+            uint32_t u32     = i << 16;
+            float    f32     = (float)i * 0.25f;
+            uint8_t  u8[4]   = { 0U, (uint8_t)i, 0U, 0U };
+
+            frames += TELEM_Send(8U, TELEM_T_U16, &centimv, sizeof(centimv)) ? 1U : 0U;
+            frames += TELEM_Send(9U, TELEM_T_I16, &decic, sizeof(decic)) ? 1U : 0U;
+            frames += TELEM_Send(4U, TELEM_T_F32, &f32, sizeof(f32)) ? 1U : 0U;
+            frames += TELEM_Send(5U, TELEM_T_U32, &u32, sizeof(u32)) ? 1U : 0U;
+            frames += TELEM_Send(6U, TELEM_T_I32, &i32, sizeof(i32)) ? 1U : 0U;
+            frames += TELEM_Send(7U, TELEM_T_U8, u8, sizeof(u8)) ? 1U : 0U;
+        }
+        if ((i % 100U) == 0U)
+        {
+            char txt[TELEM_PAYLOAD_MAX];
+            int  n = snprintf(txt, sizeof(txt), "ronda %u", (unsigned)i);
+
+            frames += TELEM_Send(3U, TELEM_T_TEXT, txt, (uint8_t)n) ? 1U : 0U;
+        }
+        /* El payload más grande: 32 bytes, con y sin ceros */
+        if ((i % 250U) == 0U)
+        {
+            memset(big, (i % 500U) ? 0x00 : 0xFF, TELEM_PAYLOAD_MAX);
+            frames += TELEM_Send(2U, TELEM_T_U8, big, TELEM_PAYLOAD_MAX) ? 1U : 0U;
+        }
+    }
+    /* Canal 0 sigue después del último daño: cualquier trama perdida se ve en seq */
+    for (i = 0; i < 64U; i++)
+    {
+        uint16_t v = (uint16_t)i;
+
+        frames += TELEM_Send(0U, TELEM_T_U16, &v, sizeof(v)) ? 1U : 0U;
+        frames += TELEM_Send(1U, TELEM_T_U16, &v, sizeof(v)) ? 1U : 0U;
+    }
+    TELEM_Flush();
+    fclose(s_out);
+
+    prv_check(TELEM_GetSentCount() == frames, "TELEM_GetSentCount");
+    prv_check(TELEM_GetDroppedCount() == 2U, "TELEM_GetDroppedCount");
+
+    /* frames buenas, con CRC malo, perdidas según seq */
+    printf("%u,%u,%u\n", (unsigned)(frames - s_corrupted), (unsigned)s_corrupted, (unsigned)s_corrupted);
+    return (s_failures == 0U) ? 0 : 1;
+}
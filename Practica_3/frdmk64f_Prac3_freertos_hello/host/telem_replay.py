@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+#
+# telem_replay.py
+#
+#  Created on: 19 oct 2026
+#      Author: luisg
+#
+# Reproduce una captura de telemetría como si viniera de la tarjeta, para
+# probar decodificadores y gráficas sin ella:
+#   - .tlm (telem_decode.py --record): con los tiempos originales;
+#   - bytes crudos: al ritmo de la UART (--baud, 8N1).
+#
+#   telem_replay.py captura.tlm | telem_decode.py -
+#   telem_replay.py captura.bin --port /dev/pts/3      (requiere pyserial)
+#
+#   --speed X   X veces más rápido (0 = sin esperas)
+#   --loop      repetir la captura sin fin
+
+import argparse
+import sys
+import time
+
+from telem_decode import read_capture
+
+CHUNK = 64
+
+
+def chunks(data, baud):
+    """(t_s, bytes) a reproducir, con tiempos de la captura o de la UART"""
+    t_byte = 10.0 / baud
+    for t, block in read_capture(data):
+        if t is not None:
+            yield t, block
+            continue
+        for i in range(0, len(block), CHUNK):
+            yield i * t_byte, block[i:i + CHUNK]
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Reproductor de capturas de telemetry.h")
+    ap.add_argument("capture")
+    ap.add_argument("--port", help="puerto serie destino (por omisión stdout)")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--speed", type=float, default=1.0)
+    ap.add_argument("--loop", action="store_true")
+    args = ap.parse_args()
+
+    with open(args.capture, "rb") as fh:
+        data = fh.read()
+    if args.port:
+        import serial
+        out = serial.Serial(args.port, args.baud)
+        write = out.write
+    else:
+        write = sys.stdout.buffer.write
+
+    while True:
+        start = time.time()
+        for t, block in chunks(data, args.baud):
+            if args.speed > 0:
+                wait = start + (t / args.speed) - time.time()
+                if wait > 0:
+                    time.sleep(wait)
+            write(block)
+        if not args.port:
+            sys.stdout.buffer.flush()
+        if not args.loop:
+            return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
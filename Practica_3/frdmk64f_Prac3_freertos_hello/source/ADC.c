@@ -7,6 +7,10 @@
 
 #include "ADC.h"
 #include "fsl_common.h"
+#include "rtos_static.h"
+#if ADC_USE_SIMULATED_SOURCE
+#include "adc_sim.h"
+#endif
 
 /* Barrera para salir de ISR si el SDK no la define */
 #ifndef SDK_ISR_EXIT_BARRIER
@@ -21,46 +25,90 @@ typedef struct
     TimerHandle_t          hTimer;
     uint32_t               period_ms;
     bool                   started;
-    uint8_t                next_src;  /* 0=HEART, 1=TEMP; alterna cada tick */
+
+    /* Lista de barrido */
+    adc_scan_entry_t       scan[ADC_SCAN_MAX];
+    uint8_t                n_scan;
+    uint32_t               tick;              /* ticks del timer desde el arranque */
+    uint8_t                due[ADC_SCAN_MAX]; /* índices a convertir en este tick */
+    uint8_t                n_due;
+    uint8_t                pos;               /* posición en due[] de la conversión en curso */
+    volatile bool          busy;              /* barrido en curso (lo libera la ISR) */
+    uint32_t               overruns;          /* ticks saltados por barrido sin terminar */
+    uint8_t                stuck;             /* overruns seguidos del barrido en curso */
+    uint32_t               aborts;            /* barridos abortados por no terminar */
+
+    uint32_t               os_acc;    /* suma del sobremuestreo en curso */
+    uint16_t               os_left;   /* conversiones que faltan */
+    uint8_t                os_shift;  /* os_bits de la fuente en curso */
+#if ADC_USE_SIMULATED_SOURCE
+    adc_sim_t              sim;
+#endif
 } adc_ctx_t;
 
 static adc_ctx_t s_adc;
 
+/* Cola y timer en memoria estática: la cola se dimensiona al máximo */
+RTOS_STATIC_QUEUE(adc_queue, ADC_QUEUE_MAX_LEN, sizeof(adcConv_str));
+RTOS_STATIC_TIMER(adc_timer);
+
 /* ======= Prototipos locales ======= */
 static void prv_config_adc_12bit(void);
 static void prv_timer_cb(TimerHandle_t xTimer);
+static void prv_start_entry(uint8_t idx);
+static adc_scan_entry_t *prv_find(uint8_t tag);
+static void prv_apply_opts(const adc_chan_opts_t *o);
+static bool prv_opts_valid(const adc_chan_opts_t *o);
+static uint32_t prv_isqrt(uint64_t v);
 
 /* ======= Implementación ======= */
 bool ADC_Init(uint8_t queue_len)
 {
     s_adc.started   = false;
     s_adc.period_ms = 100; /* 100 ms por requisito */
-    s_adc.next_src  = (uint8_t)ADC_SRC_HEART;
+    s_adc.n_scan    = 0U;
+    s_adc.tick      = 0U;
+    s_adc.busy      = false;
+    s_adc.overruns  = 0U;
+    s_adc.stuck     = 0U;
+    s_adc.aborts    = 0U;
 
-    if (queue_len == 0u) queue_len = 10u;
+    if (queue_len == 0u || queue_len > ADC_QUEUE_MAX_LEN) queue_len = ADC_QUEUE_MAX_LEN;
 
 
-    s_adc.hQueue = xQueueCreate(queue_len, sizeof(adcConv_str));
+    s_adc.hQueue = xQueueCreateStatic(queue_len, sizeof(adcConv_str),
+                                      adc_queue_storage, &adc_queue_qcb);
     if (s_adc.hQueue == NULL)
     {
         return false;
     }
 
     /* Timer de muestreo periódico */
-    s_adc.hTimer = xTimerCreate("adc_100ms",
-                                pdMS_TO_TICKS(s_adc.period_ms),
-                                pdTRUE,
-                                NULL,
-                                prv_timer_cb);
+    s_adc.hTimer = xTimerCreateStatic("adc_100ms",
+                                      pdMS_TO_TICKS(s_adc.period_ms),
+                                      pdTRUE,
+                                      NULL,
+                                      prv_timer_cb,
+                                      &adc_timer_tcb);
     if (s_adc.hTimer == NULL)
     {
         return false;
     }
 
+#if ADC_USE_SIMULATED_SOURCE
+    ADC_SIM_Init(&s_adc.sim, 0U);
+#else
     /* ADC0: 12 bits, SW trigger */
     prv_config_adc_12bit();
+#endif
 
-    /* Config común de canal (variamos channelNumber en cada tick) */
+    /* HEART y TEMP alternados, como siempre: cada uno cada 2 ticks, desfasados */
+    (void)ADC_ScanAdd(&(adc_scan_entry_t){ HM_ADC16_HEART_CHANNEL, ADC_SRC_HEART, 2U, 0U,
+                                           { ADC_AVG_OFF, false, 0U } });
+    (void)ADC_ScanAdd(&(adc_scan_entry_t){ HM_ADC16_TEMP_CHANNEL, ADC_SRC_TEMP, 2U, 1U,
+                                           { ADC_AVG_OFF, false, 0U } });
+
+    /* Config común de canal (variamos channelNumber en cada conversión) */
     s_adc.chan_cfg.enableInterruptOnConversionCompleted = true;
 #if defined(FSL_FEATURE_ADC16_HAS_DIFF_MODE) && FSL_FEATURE_ADC16_HAS_DIFF_MODE
     s_adc.chan_cfg.enableDifferentialConversion = false;
@@ -68,7 +116,9 @@ bool ADC_Init(uint8_t queue_len)
 
     /* Prioridad/enable de IRQ (seguro para FreeRTOS FromISR) */
     NVIC_SetPriority(HM_ADC16_IRQn, 3);
+#if !ADC_USE_SIMULATED_SOURCE
     EnableIRQ(HM_ADC16_IRQn);
+#endif
 
     return true;
 }
@@ -109,6 +159,109 @@ QueueHandle_t ADC_GetQueueHandle(void)
     return s_adc.hQueue;
 }
 
+bool ADC_ScanAdd(const adc_scan_entry_t *e)
+{
+    if (!e || s_adc.started || s_adc.n_scan >= ADC_SCAN_MAX) return false;
+    if (e->divider == 0U || e->phase >= e->divider || !prv_opts_valid(&e->opts)) return false;
+    if (prv_find(e->tag) != NULL) return false;   /* el tag identifica al resultado */
+
+    s_adc.scan[s_adc.n_scan++] = *e;
+    return true;
+}
+
+uint32_t ADC_GetOverruns(void)
+{
+    return s_adc.overruns;
+}
+
+uint32_t ADC_GetAborts(void)
+{
+    return s_adc.aborts;
+}
+
+bool ADC_SetChannelOptions(uint8_t src, const adc_chan_opts_t *opts)
+{
+    adc_scan_entry_t *e = prv_find(src);
+
+    if (!e || !prv_opts_valid(opts)) return false;
+    /* El timer las lee al lanzar la siguiente muestra */
+    taskENTER_CRITICAL();
+    e->opts = *opts;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+uint16_t ADC_GetFullScale(uint8_t src)
+{
+    const adc_scan_entry_t *e = prv_find(src);
+    if (!e) return 0U;
+    return (uint16_t)((e->opts.res16 ? 0xFFFFUL : 0x0FFFUL) << e->opts.os_bits);
+}
+
+bool ADC_MeasureNoise(uint8_t src, const adc_chan_opts_t *opts, uint16_t n, adc_noise_t *out)
+{
+    adc16_channel_config_t cfg;
+    uint64_t sum = 0U;
+    int64_t  dsum = 0, dsumsq = 0;    /* relativo a la primera muestra: sin perder precisión */
+    int32_t  d;
+    uint32_t t0, cycles, k, os_n, acc, v, v0 = 0U;
+    float    dmean, var;
+    uint16_t i;
+
+    const adc_scan_entry_t *e = prv_find(src);
+
+    if (s_adc.started || s_adc.busy || !e || !out || n < 2U || !prv_opts_valid(opts)) return false;
+
+    /* Polling: sin IRQ de fin de conversión */
+    cfg.channelNumber = e->channel;
+    cfg.enableInterruptOnConversionCompleted = false;
+#if defined(FSL_FEATURE_ADC16_HAS_DIFF_MODE) && FSL_FEATURE_ADC16_HAS_DIFF_MODE
+    cfg.enableDifferentialConversion = false;
+#endif
+
+    prv_apply_opts(opts);
+    os_n = 1UL << (2U * opts->os_bits);
+
+    /* DWT->CYCCNT como cronómetro (el scheduler aún no lo habilita) */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    t0 = DWT->CYCCNT;
+    for (i = 0; i < n; i++)
+    {
+        acc = 0U;
+        for (k = 0; k < os_n; k++)
+        {
+            ADC16_SetChannelConfig(HM_HEART_ADC16_BASE, HM_ADC16_CHANNEL_GROUP, &cfg);
+            while ((ADC16_GetChannelStatusFlags(HM_HEART_ADC16_BASE, HM_ADC16_CHANNEL_GROUP) &
+                    (uint32_t)kADC16_ChannelConversionDoneFlag) == 0U)
+            {
+            }
+            acc += ADC16_GetChannelConversionValue(HM_HEART_ADC16_BASE, HM_ADC16_CHANNEL_GROUP);
+        }
+        v = acc >> opts->os_bits;
+        if (i == 0U) v0 = v;
+        d       = (int32_t)v - (int32_t)v0;
+        sum    += v;
+        dsum   += d;
+        dsumsq += (int64_t)d * d;
+    }
+    cycles = DWT->CYCCNT - t0;
+
+    /* var = E[d^2] - E[d]^2 (no cambia con el corrimiento v0) */
+    dmean = (float)dsum / (float)n;
+    var   = ((float)dsumsq / (float)n) - dmean * dmean;
+    if (var < 0.0f) var = 0.0f;
+
+    out->bits          = (uint8_t)((opts->res16 ? 16U : 12U) + opts->os_bits);
+    out->mean          = (uint32_t)(sum / n);
+    out->rms_milli_lsb = prv_isqrt((uint64_t)(var * 1000000.0f));
+    out->samples_per_s = (cycles != 0U)
+                       ? (uint32_t)(((uint64_t)n * SystemCoreClock) / cycles) : 0U;
+
+    return true;
+}
+
 /* ======= IRQ handler ======= */
 void ADC0_IRQHandler(void)
 {
@@ -119,19 +272,35 @@ void ADC0_IRQHandler(void)
     uint32_t val = ADC16_GetChannelConversionValue(HM_HEART_ADC16_BASE,
                                                    HM_ADC16_CHANNEL_GROUP);
 
-    /* ¿Cuál canal se convirtió? El timer preparó A y cambió next_src a B,
-       así que aquí el convertido es el PREVIO a next_src. */
-    uint8_t converted_src = (s_adc.next_src == (uint8_t)ADC_SRC_HEART)
-                          ? (uint8_t)ADC_SRC_TEMP
-                          : (uint8_t)ADC_SRC_HEART;
+    /* Sobremuestreo: acumula y relanza hasta completar 4^n conversiones */
+    s_adc.os_acc += val;
+    if (s_adc.os_left > 1U)
+    {
+        s_adc.os_left--;
+        ADC16_SetChannelConfig(HM_HEART_ADC16_BASE, HM_ADC16_CHANNEL_GROUP, &s_adc.chan_cfg);
+        SDK_ISR_EXIT_BARRIER;
+        return;
+    }
+    val = s_adc.os_acc >> s_adc.os_shift;
 
-    msg.convSource = converted_src;          /* 0=HEART, 1=TEMP */
+    /* El tag viaja con la entrada que se lanzó: no se deduce de nada */
+    msg.convSource = s_adc.scan[s_adc.due[s_adc.pos]].tag;
     msg.data       = (uint16_t)val;
 
     (void)xQueueSendFromISR(s_adc.hQueue, &msg, &xHPW);
     xHPW = pdFALSE;
     (void)xQueueSendFromISR(s_adc.hQueue, &msg, &xHPW);
 
+    /* Siguiente canal del barrido, encadenado desde aquí */
+    if (++s_adc.pos < s_adc.n_due)
+    {
+        prv_start_entry(s_adc.due[s_adc.pos]);
+    }
+    else
+    {
+        s_adc.busy = false;
+    }
+
     portYIELD_FROM_ISR(xHPW);
     SDK_ISR_EXIT_BARRIER;
 }
@@ -151,27 +320,150 @@ static void prv_config_adc_12bit(void)
     ADC16_EnableHardwareTrigger(HM_HEART_ADC16_BASE, false);
 
 #if defined(FSL_FEATURE_ADC16_HAS_CALIBRATION) && FSL_FEATURE_ADC16_HAS_CALIBRATION
+    /* El RM recomienda calibrar con el máximo promedio */
+    ADC16_SetHardwareAverage(HM_HEART_ADC16_BASE, kADC16_HardwareAverageCount32);
     (void)ADC16_DoAutoCalibration(HM_HEART_ADC16_BASE);
+    ADC16_SetHardwareAverage(HM_HEART_ADC16_BASE, kADC16_HardwareAverageDisabled);
 #endif
 }
 
-/* Timer 100 ms: alterna canal y lanza conversión por SW */
+/* Escribe promedio HW y modo (CFG1[MODE]) antes de lanzar la conversión */
+static void prv_apply_opts(const adc_chan_opts_t *o)
+{
+    static const adc16_hardware_average_mode_t avg_mode[] = {
+        kADC16_HardwareAverageDisabled,
+        kADC16_HardwareAverageCount4,
+        kADC16_HardwareAverageCount8,
+        kADC16_HardwareAverageCount16,
+        kADC16_HardwareAverageCount32,
+    };
+
+    ADC16_SetHardwareAverage(HM_HEART_ADC16_BASE, avg_mode[o->hw_avg]);
+    HM_HEART_ADC16_BASE->CFG1 = (HM_HEART_ADC16_BASE->CFG1 & ~ADC_CFG1_MODE_MASK) |
+                                ADC_CFG1_MODE(o->res16 ? kADC16_ResolutionSE16Bit
+                                                       : kADC16_ResolutionSE12Bit);
+}
+
+/* El resultado tiene que caber en los 16 bits de adcConv_str.data */
+static bool prv_opts_valid(const adc_chan_opts_t *o)
+{
+    if (!o) return false;
+    if (o->hw_avg > (uint8_t)ADC_AVG_32) return false;
+    if (o->os_bits > ADC_OS_MAX_BITS) return false;
+    return ((o->res16 ? 16U : 12U) + o->os_bits) <= 16U;
+}
+
+/* Raíz cuadrada entera (bit a bit) */
+static uint32_t prv_isqrt(uint64_t v)
+{
+    uint64_t res = 0U;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > v) bit >>= 2;
+    while (bit != 0U)
+    {
+        if (v >= res + bit)
+        {
+            v   -= res + bit;
+            res  = (res >> 1) + bit;
+        }
+        else
+        {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+/* Timer 100 ms: arma la lista de canales que tocan en este tick y lanza el
+   primero; la ISR encadena los demás */
 static void prv_timer_cb(TimerHandle_t xTimer)
 {
-    /* Selecciona canal a convertir y alterna para el próximo tick */
-    if (s_adc.next_src == (uint8_t)ADC_SRC_HEART)
+    uint8_t i;
+    uint32_t t = s_adc.tick++;
+
+    (void)xTimer;
+
+    if (s_adc.busy)
     {
-        s_adc.chan_cfg.channelNumber = HM_ADC16_HEART_CHANNEL; /* ADC0_SE12 */
-        s_adc.next_src = (uint8_t)ADC_SRC_TEMP;
+        /* El barrido anterior no terminó: se salta este tick completo */
+        s_adc.overruns++;
+        if (++s_adc.stuck < ADC_STUCK_TICKS)
+        {
+            return;
+        }
+
+        /* Se perdió la interrupción (o la conversión nunca terminó): sin
+           esto busy queda en true y no se vuelve a muestrear. ADCH = 0x1F
+           aborta la conversión en curso y se empieza un barrido nuevo */
+        taskENTER_CRITICAL();
+        HM_HEART_ADC16_BASE->SC1[HM_ADC16_CHANNEL_GROUP] = ADC_SC1_ADCH(0x1FU);
+        NVIC_ClearPendingIRQ(HM_ADC16_IRQn);
+        s_adc.pos  = 0U;
+        s_adc.busy = false;
+        taskEXIT_CRITICAL();
+        s_adc.aborts++;
     }
-    else
+    s_adc.stuck = 0U;
+
+    s_adc.n_due = 0U;
+    for (i = 0; i < s_adc.n_scan; i++)
     {
-        s_adc.chan_cfg.channelNumber = HM_ADC16_TEMP_CHANNEL;  /* ADC0_SE13 */
-        s_adc.next_src = (uint8_t)ADC_SRC_HEART;
+        if ((t % s_adc.scan[i].divider) == s_adc.scan[i].phase)
+        {
+            s_adc.due[s_adc.n_due++] = i;
+        }
     }
+    if (s_adc.n_due == 0U)
+    {
+        return;
+    }
+
+#if ADC_USE_SIMULATED_SOURCE
+    /* Mismos mensajes que la ISR, sin tocar el ADC */
+    for (i = 0; i < s_adc.n_due; i++)
+    {
+        adcConv_str msg;
+        uint8_t tag = s_adc.scan[s_adc.due[i]].tag;
 
-    /* Dispara conversión: al terminar, cae a ISR -> cola */
+        /* La fuente simulada es de 12 bits: se escala a la resolución configurada */
+        msg.convSource = tag;
+        msg.data       = (uint16_t)(((uint32_t)ADC_SIM_Next(&s_adc.sim, tag) *
+                                     ADC_GetFullScale(tag)) / 4095U);
+        (void)xQueueSend(s_adc.hQueue, &msg, 0);
+        (void)xQueueSend(s_adc.hQueue, &msg, 0);
+    }
+#else
+    s_adc.pos  = 0U;
+    s_adc.busy = true;
+    prv_start_entry(s_adc.due[0]);
+#endif
+}
+
+/* Opciones + canal de la entrada y dispara la conversión por SW;
+   al terminar cae a la ISR -> cola */
+static void prv_start_entry(uint8_t idx)
+{
+    const adc_scan_entry_t *e = &s_adc.scan[idx];
+
+    prv_apply_opts(&e->opts);
+    s_adc.os_acc   = 0U;
+    s_adc.os_shift = e->opts.os_bits;
+    s_adc.os_left  = (uint16_t)(1U << (2U * s_adc.os_shift));
+
+    s_adc.chan_cfg.channelNumber = e->channel;
     ADC16_SetChannelConfig(HM_HEART_ADC16_BASE,
                            HM_ADC16_CHANNEL_GROUP,
                            &s_adc.chan_cfg);
 }
+
+static adc_scan_entry_t *prv_find(uint8_t tag)
+{
+    uint8_t i;
+    for (i = 0; i < s_adc.n_scan; i++)
+    {
+        if (s_adc.scan[i].tag == tag) return &s_adc.scan[i];
+    }
+    return NULL;
+}
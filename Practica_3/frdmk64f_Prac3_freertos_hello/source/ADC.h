@@ -27,28 +27,99 @@
 #define HM_ADC16_IRQn                  ADC0_IRQn
 #define HM_ADC16_IRQ_HANDLER_FUNC      ADC0_IRQHandler
 
-/* Identificador para distinguir la fuente en la cola */
+/* 1 = el timer encola muestras de adc_sim en vez de convertir (sin sensores) */
+#ifndef ADC_USE_SIMULATED_SOURCE
+#define ADC_USE_SIMULATED_SOURCE       0
+#endif
+
+/* Longitud máxima de la cola interna (memoria estática) */
+#define ADC_QUEUE_MAX_LEN              10U
+
+/* Entradas máximas de la lista de barrido */
+#define ADC_SCAN_MAX                   6U
+
+/* Overruns seguidos tras los que se aborta el barrido en curso */
+#define ADC_STUCK_TICKS                3U
+
+/* Bits extra máximos por sobremuestreo (4^n conversiones por muestra) */
+#define ADC_OS_MAX_BITS                4U
+
+/* Promedio por hardware del ADC16 (SC3[AVGE/AVGS]) */
+typedef enum
+{
+    ADC_AVG_OFF = 0,
+    ADC_AVG_4,
+    ADC_AVG_8,
+    ADC_AVG_16,
+    ADC_AVG_32
+} adc_hwavg_t;
+
+/* Opciones de conversión por canal; el resultado tiene
+   (res16 ? 16 : 12) + os_bits bits, hasta 16 en total */
+typedef struct
+{
+    uint8_t hw_avg;    /* adc_hwavg_t */
+    bool    res16;     /* conversión de 16 bits en vez de 12 */
+    uint8_t os_bits;   /* sobremuestreo y decimación: 4^os_bits conversiones, suma >> os_bits */
+} adc_chan_opts_t;
+
+/* Resultado de ADC_MeasureNoise */
+typedef struct
+{
+    uint8_t  bits;           /* resolución efectiva del resultado */
+    uint32_t mean;           /* promedio, en cuentas del resultado */
+    uint32_t rms_milli_lsb;  /* ruido: desviación estándar en milésimas de LSB */
+    uint32_t samples_per_s;  /* resultados por segundo (con promedio y sobremuestreo) */
+} adc_noise_t;
+
+/* Identificador para distinguir la fuente en la cola (tag de la lista
+   de barrido); entradas nuevas usan tags a partir de ADC_SRC_COUNT */
 typedef enum
 {
     ADC_SRC_HEART = 0,
-    ADC_SRC_TEMP  = 1
+    ADC_SRC_TEMP  = 1,
+    ADC_SRC_COUNT
 } adc_src_t;
 
+/* Entrada de la lista de barrido: en cada tick del timer se convierten, en
+   orden y encadenadas desde la ISR, las entradas con tick % divider == phase */
+typedef struct
+{
+    uint8_t         channel;   /* ADC0_SEn */
+    uint8_t         tag;       /* va en convSource de cada resultado */
+    uint8_t         divider;   /* 1 = cada tick, 2 = uno sí uno no, ... */
+    uint8_t         phase;     /* 0..divider-1, para repartir canales entre ticks */
+    adc_chan_opts_t opts;
+} adc_scan_entry_t;
+
 /* MISMA estructura que usas (con convSource poblado) */
 typedef struct
 {
-    uint8_t  convSource;  /* 0 = HEART, 1 = TEMP */
-    uint16_t data;        /* Valor crudo 12 bits (0..4095) */
+    uint8_t  convSource;  /* tag de la entrada: 0 = HEART, 1 = TEMP, ... */
+    uint16_t data;        /* Valor crudo (0..ADC_GetFullScale(convSource)) */
 } adcConv_str;
 
 /* ======= API ======= */
+/* Registra HEART (div 2, fase 0) y TEMP (div 2, fase 1): alternados como antes */
 bool ADC_Init(uint8_t queue_len);
+/* Agrega una entrada (tag único); solo con el driver detenido */
+bool ADC_ScanAdd(const adc_scan_entry_t *e);
+/* Ticks saltados porque el barrido anterior no había terminado */
+uint32_t ADC_GetOverruns(void);
+/* Barridos abortados tras ADC_STUCK_TICKS overruns seguidos */
+uint32_t ADC_GetAborts(void);
 bool ADC_Start(void);
 void ADC_Stop(void);
 bool ADC_SetPeriodMs(uint32_t new_period_ms);
 bool ADC_Receive(adcConv_str *out, TickType_t ticks_to_wait);
 QueueHandle_t ADC_GetQueueHandle(void);
 
+/* Opciones por tag. Por defecto: 12 bits, sin promedio ni sobremuestreo (0..4095) */
+bool     ADC_SetChannelOptions(uint8_t src, const adc_chan_opts_t *opts);
+uint16_t ADC_GetFullScale(uint8_t src);
+/* Medición en polling de n resultados con las opciones dadas; requiere ADC_Stop() */
+bool     ADC_MeasureNoise(uint8_t src, const adc_chan_opts_t *opts, uint16_t n, adc_noise_t *out);
+
 
 #endif /* ADC_H_ */
 
@@ -41,7 +41,7 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION                    1
-#define configUSE_TICKLESS_IDLE                 0
+#define configUSE_TICKLESS_IDLE                 2 /* vPortSuppressTicksAndSleep en low_power.c */
 #define configCPU_CLOCK_HZ                      (SystemCoreClock)
 #define configTICK_RATE_HZ                      ((TickType_t)200)
 #define configMAX_PRIORITIES                    5
@@ -62,14 +62,18 @@
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
 
 /* Used memory allocation (heap_x.c) */
-#define configFRTOS_MEMORY_SCHEME               4
+/* Sin heap: ningún heap_x.c se compila (excluidos en .cproject). Este valor solo
+   lo lee el depurador (freertos_tasks_c_additions.h, acepta 1..5); heap_1 es lo
+   más cercano a "nada se libera", y la vista de heap queda vacía */
+#define configFRTOS_MEMORY_SCHEME               1
 /* Tasks.c additions (e.g. Thread Aware Debug capability) */
 #define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H 1
 
 /* Memory allocation related definitions. */
-#define configSUPPORT_STATIC_ALLOCATION         0
-#define configSUPPORT_DYNAMIC_ALLOCATION        1
-#define configTOTAL_HEAP_SIZE                   ((size_t)(10 * 1024))
+/* Todo se crea con ...CreateStatic() (ver rtos_static.h); sin heap */
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        0
+#define configTOTAL_HEAP_SIZE                   ((size_t)0)
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
@@ -80,7 +84,7 @@
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+#define configGENERATE_RUN_TIME_STATS           1
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
@@ -109,7 +113,7 @@
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
 #define INCLUDE_xTaskGetIdleTaskHandle          0
 #define INCLUDE_eTaskGetState                   0
 #define INCLUDE_xTimerPendFunctionCall          1
@@ -123,6 +127,15 @@
     /* Clock manager provides in this variable system core clock frequency */
     #include <stdint.h>
     extern uint32_t SystemCoreClock;
+
+    /* Run time stats: reloj = DWT->CYCCNT (ciclos de core) y nivel máximo de
+       colas vía trace hooks; ver rtos_stats.c */
+    extern void STATS_EnableCycleCounter(void);
+    extern void STATS_TraceQueueSend(void *pxQueue);
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() STATS_EnableCycleCounter()
+    #define portGET_RUN_TIME_COUNTER_VALUE()        (*(volatile uint32_t *)0xE0001004UL) /* DWT->CYCCNT */
+    #define traceQUEUE_SEND(pxQueue)                STATS_TraceQueueSend(pxQueue)
+    #define traceQUEUE_SEND_FROM_ISR(pxQueue)       STATS_TraceQueueSend(pxQueue)
 #endif
 
 /* Interrupt nesting behaviour configuration. Cortex-M specific. */
@@ -0,0 +1,82 @@
+/*
+ * adc_sim.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "adc_sim.h"
+
+#define ADC_SIM_FULL_SCALE   4095U
+#define ADC_SIM_TEMP_MIN     0U
+#define ADC_SIM_TEMP_MAX     ADC_SIM_FULL_SCALE
+
+/* Un latido (P, QRS, T) sobre la línea base, en cuentas de 12 bits */
+static const uint16_t s_beat[ADC_SIM_BEAT_SAMPLES] = {
+    2000, 2000, 2150, 2250, 2150, 2000, 1800, 3900,
+     900, 2000, 2000, 2300, 2500, 2300, 2000, 2000
+};
+
+/* ======= Prototipos locales ======= */
+static uint16_t prv_lfsr_step(uint16_t s);
+static uint16_t prv_add_noise(adc_sim_t *sim, uint16_t v);
+
+/* ======= Implementación ======= */
+void ADC_SIM_Init(adc_sim_t *sim, uint16_t seed)
+{
+    sim->lfsr     = (seed != 0U) ? seed : 0xACE1U;
+    sim->beat_idx = 0U;
+    sim->temp     = ADC_SIM_FULL_SCALE / 2U;
+    sim->temp_dir = 1;
+}
+
+uint16_t ADC_SIM_Next(adc_sim_t *sim, uint8_t src)
+{
+    uint16_t v;
+
+    if (src == 0U) /* HEART */
+    {
+        v = s_beat[sim->beat_idx];
+        sim->beat_idx = (uint8_t)((sim->beat_idx + 1U) % ADC_SIM_BEAT_SAMPLES);
+    }
+    else           /* TEMP: rampa triangular entre los extremos */
+    {
+        if (sim->temp_dir > 0)
+        {
+            if (sim->temp >= ADC_SIM_TEMP_MAX - ADC_SIM_TEMP_STEP) { sim->temp_dir = -1; }
+            else                                                   { sim->temp += ADC_SIM_TEMP_STEP; }
+        }
+        else
+        {
+            if (sim->temp <= ADC_SIM_TEMP_MIN + ADC_SIM_TEMP_STEP) { sim->temp_dir = 1; }
+            else                                                   { sim->temp -= ADC_SIM_TEMP_STEP; }
+        }
+        v = sim->temp;
+    }
+
+    return prv_add_noise(sim, v);
+}
+
+/* ======= Estáticos locales ======= */
+/* LFSR de Galois de 16 bits (x^16 + x^14 + x^13 + x^11 + 1), periodo 65535 */
+static uint16_t prv_lfsr_step(uint16_t s)
+{
+    uint16_t lsb = (uint16_t)(s & 1U);
+    s >>= 1;
+    if (lsb != 0U) { s ^= 0xB400U; }
+    return s;
+}
+
+/* Ruido centrado en cero, saturado a 0..4095 */
+static uint16_t prv_add_noise(adc_sim_t *sim, uint16_t v)
+{
+    int32_t n;
+
+    sim->lfsr = prv_lfsr_step(sim->lfsr);
+    n = (int32_t)(sim->lfsr & ADC_SIM_NOISE_MASK) - (int32_t)((ADC_SIM_NOISE_MASK + 1U) / 2U);
+    n += (int32_t)v;
+
+    if (n < 0)                            { n = 0; }
+    if (n > (int32_t)ADC_SIM_FULL_SCALE)  { n = (int32_t)ADC_SIM_FULL_SCALE; }
+    return (uint16_t)n;
+}
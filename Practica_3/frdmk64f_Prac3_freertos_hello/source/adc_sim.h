@@ -0,0 +1,36 @@
+/*
+ * adc_sim.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Fuente de muestras sintéticas para correr el monitor sin sensores:
+ * un latido tipo ECG, una rampa de temperatura que sube y baja (saliendo
+ * del rango normal en los extremos) y ruido de un LFSR. Solo usa
+ * <stdint.h>, igual que monitor_core.
+ */
+
+#ifndef ADC_SIM_H_
+#define ADC_SIM_H_
+
+#include <stdint.h>
+
+/* ======= Configuración ======= */
+#define ADC_SIM_BEAT_SAMPLES     16U    /* muestras por latido */
+#define ADC_SIM_TEMP_STEP        16U    /* cuentas por muestra de la rampa */
+#define ADC_SIM_NOISE_MASK       0x3FU  /* amplitud del ruido: 0..63 cuentas */
+
+typedef struct
+{
+    uint16_t lfsr;       /* estado del generador de ruido (!= 0) */
+    uint8_t  beat_idx;   /* posición dentro del latido */
+    uint16_t temp;       /* valor actual de la rampa */
+    int8_t   temp_dir;   /* +1 subiendo, -1 bajando */
+} adc_sim_t;
+
+/* ======= API ======= */
+void     ADC_SIM_Init(adc_sim_t *sim, uint16_t seed);
+/* Siguiente muestra cruda de 12 bits; src = ADC_SRC_HEART / ADC_SRC_TEMP */
+uint16_t ADC_SIM_Next(adc_sim_t *sim, uint8_t src);
+
+#endif /* ADC_SIM_H_ */
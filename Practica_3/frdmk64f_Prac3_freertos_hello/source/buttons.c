@@ -0,0 +1,279 @@
+/*
+ * buttons.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Las ISR de PORTA/PORTC solo guardan (botón, tick) y limpian la bandera.
+ * El antirrebote y la clasificación corta/larga/doble se hacen en una tarea,
+ * que lee el nivel del pin cuando ya dejó de rebotar.
+ */
+
+#include "buttons.h"
+#include "task.h"
+#include "fsl_common.h"
+#include "fsl_port.h"
+#include "fsl_gpio.h"
+#include "board.h"
+#include "rtos_static.h"
+
+/* Barrera para salir de ISR si el SDK no la define */
+#ifndef SDK_ISR_EXIT_BARRIER
+#define SDK_ISR_EXIT_BARRIER __DSB(); __ISB()
+#endif
+
+/* ======= Tipos internos ======= */
+typedef struct
+{
+    uint8_t    button;
+    TickType_t t;
+} btn_edge_t;
+
+typedef enum
+{
+    ST_IDLE = 0,
+    ST_DOWN,        /* primera presión */
+    ST_LONG_HELD,   /* ya se emitió LONG, esperando a soltar */
+    ST_WAIT_2ND,    /* soltó una presión corta; ¿viene otra? */
+    ST_DOWN_2ND     /* segunda presión */
+} btn_state_t;
+
+typedef struct
+{
+    GPIO_Type *gpio;
+    uint32_t   pin;
+    bool       settling;    /* hay flancos sin resolver */
+    bool       pressed;     /* último nivel estable (activo en bajo) */
+    uint8_t    state;       /* btn_state_t */
+    TickType_t burst_t;     /* primer flanco de la ráfaga = instante real del cambio */
+    TickType_t last_t;      /* último flanco: el pin se lee BTN_DEBOUNCE_MS después */
+    TickType_t mark_t;      /* inicio de la presión o de la ventana de doble */
+} btn_ctx_t;
+
+typedef struct
+{
+    QueueHandle_t hEdges;
+    QueueHandle_t hEvents;
+    btn_ctx_t     b[BTN_COUNT];
+} buttons_ctx_t;
+
+static buttons_ctx_t s_btn;
+
+RTOS_STATIC_QUEUE(btn_edges, BTN_EDGE_QUEUE_LEN, sizeof(btn_edge_t));
+RTOS_STATIC_QUEUE(btn_events, BTN_EVENT_QUEUE_LEN, sizeof(btn_event_t));
+RTOS_STATIC_TASK(btn, BTN_TASK_STACK);
+
+/* ======= Prototipos locales ======= */
+static void prv_task(void *pvParameters);
+static void prv_edge_from_isr(GPIO_Type *gpio, uint32_t pin, uint8_t button);
+static void prv_on_level(btn_ctx_t *b, uint8_t id, bool pressed, TickType_t t);
+static void prv_on_time(btn_ctx_t *b, uint8_t id, TickType_t now);
+static TickType_t prv_next_timeout(TickType_t now);
+static void prv_publish(uint8_t id, uint8_t gesture);
+
+/* ======= Implementación ======= */
+bool BTN_Init(void)
+{
+    s_btn.hEdges  = xQueueCreateStatic(BTN_EDGE_QUEUE_LEN, sizeof(btn_edge_t),
+                                       btn_edges_storage, &btn_edges_qcb);
+    s_btn.hEvents = xQueueCreateStatic(BTN_EVENT_QUEUE_LEN, sizeof(btn_event_t),
+                                       btn_events_storage, &btn_events_qcb);
+    if (s_btn.hEdges == NULL || s_btn.hEvents == NULL)
+    {
+        return false;
+    }
+
+    if (xTaskCreateStatic(prv_task, "Buttons", BTN_TASK_STACK, NULL,
+                          BTN_TASK_PRIORITY, btn_stack, &btn_tcb) == NULL)
+    {
+        return false;
+    }
+    return true;
+}
+
+void BTN_Start(void)
+{
+    uint8_t i;
+
+    s_btn.b[BTN_SW2].gpio = BOARD_SW2_GPIO;
+    s_btn.b[BTN_SW2].pin  = BOARD_SW2_GPIO_PIN;
+    s_btn.b[BTN_SW3].gpio = BOARD_SW3_GPIO;
+    s_btn.b[BTN_SW3].pin  = BOARD_SW3_GPIO_PIN;
+
+    for (i = 0; i < BTN_COUNT; i++)
+    {
+        s_btn.b[i].settling = false;
+        s_btn.b[i].pressed  = (GPIO_PinRead(s_btn.b[i].gpio, s_btn.b[i].pin) == 0U);
+        s_btn.b[i].state    = (uint8_t)ST_IDLE;
+    }
+
+    /* Presionar y soltar generan flanco: se necesitan los dos para medir la duración */
+    PORT_SetPinInterruptConfig(BOARD_SW2_PORT, BOARD_SW2_GPIO_PIN, kPORT_InterruptEitherEdge);
+    PORT_SetPinInterruptConfig(BOARD_SW3_PORT, BOARD_SW3_GPIO_PIN, kPORT_InterruptEitherEdge);
+}
+
+bool BTN_Receive(btn_event_t *out, TickType_t ticks_to_wait)
+{
+    if (!out) return false;
+    return (xQueueReceive(s_btn.hEvents, out, ticks_to_wait) == pdTRUE);
+}
+
+/* ======= IRQ handlers ======= */
+void BOARD_SW2_IRQ_HANDLER(void)
+{
+    prv_edge_from_isr(BOARD_SW2_GPIO, BOARD_SW2_GPIO_PIN, (uint8_t)BTN_SW2);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+void BOARD_SW3_IRQ_HANDLER(void)
+{
+    prv_edge_from_isr(BOARD_SW3_GPIO, BOARD_SW3_GPIO_PIN, (uint8_t)BTN_SW3);
+    SDK_ISR_EXIT_BARRIER;
+}
+
+/* ======= Estáticos locales ======= */
+/* Solo timestamp + bandera: sin leer el pin ni tocar estado de la UI */
+static void prv_edge_from_isr(GPIO_Type *gpio, uint32_t pin, uint8_t button)
+{
+    BaseType_t xHPW = pdFALSE;
+    btn_edge_t e;
+    uint32_t   flags = GPIO_PortGetInterruptFlags(gpio);
+
+    GPIO_PortClearInterruptFlags(gpio, flags);
+    if (((flags & (1UL << pin)) == 0U) || (s_btn.hEdges == NULL))
+    {
+        return;
+    }
+
+    e.button = button;
+    e.t      = xTaskGetTickCountFromISR();
+    /* Si la cola está llena se pierde un rebote, no una presión: la tarea relee el nivel */
+    (void)xQueueSendFromISR(s_btn.hEdges, &e, &xHPW);
+    portYIELD_FROM_ISR(xHPW);
+}
+
+static void prv_task(void *pvParameters)
+{
+    btn_edge_t e;
+    TickType_t now;
+    uint8_t    i;
+    bool       level;
+
+    (void)pvParameters;
+
+    for (;;)
+    {
+        if (xQueueReceive(s_btn.hEdges, &e, prv_next_timeout(xTaskGetTickCount())) == pdTRUE)
+        {
+            btn_ctx_t *b = &s_btn.b[e.button];
+            if (!b->settling)
+            {
+                b->settling = true;
+                b->burst_t  = e.t;
+            }
+            /* Cada rebote reinicia la espera: se lee cuando el pin lleva quieto el tiempo completo */
+            b->last_t = e.t;
+        }
+
+        now = xTaskGetTickCount();
+        for (i = 0; i < BTN_COUNT; i++)
+        {
+            btn_ctx_t *b = &s_btn.b[i];
+
+            if (b->settling && (TickType_t)(now - b->last_t) >= pdMS_TO_TICKS(BTN_DEBOUNCE_MS))
+            {
+                b->settling = false;
+                level = (GPIO_PinRead(b->gpio, b->pin) == 0U);
+                if (level != b->pressed)
+                {
+                    b->pressed = level;
+                    prv_on_level(b, i, level, b->burst_t);
+                }
+            }
+            prv_on_time(b, i, now);
+        }
+    }
+}
+
+/* Cambio de nivel ya sin rebote, fechado con el primer flanco */
+static void prv_on_level(btn_ctx_t *b, uint8_t id, bool pressed, TickType_t t)
+{
+    switch (b->state)
+    {
+        case ST_IDLE:
+            if (pressed) { b->state = ST_DOWN; b->mark_t = t; }
+            break;
+        case ST_DOWN:
+            if (!pressed) { b->state = ST_WAIT_2ND; b->mark_t = t; }
+            break;
+        case ST_LONG_HELD:
+            if (!pressed) { b->state = ST_IDLE; }
+            break;
+        case ST_WAIT_2ND:
+            if (pressed) { b->state = ST_DOWN_2ND; }
+            break;
+        case ST_DOWN_2ND:
+            if (!pressed) { b->state = ST_IDLE; prv_publish(id, (uint8_t)BTN_DOUBLE); }
+            break;
+        default:
+            b->state = ST_IDLE;
+            break;
+    }
+}
+
+/* Plazos: presión larga y cierre de la ventana de doble */
+static void prv_on_time(btn_ctx_t *b, uint8_t id, TickType_t now)
+{
+    if (b->state == ST_DOWN &&
+        (TickType_t)(now - b->mark_t) >= pdMS_TO_TICKS(BTN_LONG_MS))
+    {
+        b->state = ST_LONG_HELD;
+        prv_publish(id, (uint8_t)BTN_LONG);
+    }
+    else if (b->state == ST_WAIT_2ND &&
+             (TickType_t)(now - b->mark_t) >= pdMS_TO_TICKS(BTN_DOUBLE_MS))
+    {
+        b->state = ST_IDLE;
+        prv_publish(id, (uint8_t)BTN_SHORT);
+    }
+}
+
+/* Espera hasta el plazo más cercano; sin plazos pendientes la tarea duerme */
+static TickType_t prv_next_timeout(TickType_t now)
+{
+    TickType_t best = portMAX_DELAY;
+    TickType_t due;
+    uint8_t    i;
+
+    for (i = 0; i < BTN_COUNT; i++)
+    {
+        const btn_ctx_t *b = &s_btn.b[i];
+        TickType_t elapsed;
+
+        if (b->settling)
+        {
+            elapsed = (TickType_t)(now - b->last_t);
+            due = (elapsed < pdMS_TO_TICKS(BTN_DEBOUNCE_MS)) ? (pdMS_TO_TICKS(BTN_DEBOUNCE_MS) - elapsed) : 0U;
+            if (due < best) best = due;
+        }
+        if (b->state == ST_DOWN || b->state == ST_WAIT_2ND)
+        {
+            TickType_t limit = (b->state == ST_DOWN) ? pdMS_TO_TICKS(BTN_LONG_MS)
+                                                     : pdMS_TO_TICKS(BTN_DOUBLE_MS);
+            elapsed = (TickType_t)(now - b->mark_t);
+            due = (elapsed < limit) ? (limit - elapsed) : 0U;
+            if (due < best) best = due;
+        }
+    }
+    return best;
+}
+
+static void prv_publish(uint8_t id, uint8_t gesture)
+{
+    btn_event_t ev;
+
+    ev.button  = id;
+    ev.gesture = gesture;
+    /* La UI va atrasada: se descarta el evento antes que bloquear el antirrebote */
+    (void)xQueueSend(s_btn.hEvents, &ev, 0);
+}
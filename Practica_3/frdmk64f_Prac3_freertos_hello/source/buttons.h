@@ -0,0 +1,57 @@
+/*
+ * buttons.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef BUTTONS_H_
+#define BUTTONS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* FreeRTOS */
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/* ======= Configuración ======= */
+#define BTN_DEBOUNCE_MS         20U    /* el nivel debe quedarse quieto este tiempo */
+#define BTN_LONG_MS             800U   /* presión sostenida -> BTN_LONG */
+#define BTN_DOUBLE_MS           250U   /* ventana para la segunda presión */
+#define BTN_EDGE_QUEUE_LEN      16U    /* flancos crudos ISR -> tarea */
+#define BTN_EVENT_QUEUE_LEN     4U     /* eventos semánticos tarea -> UI */
+#define BTN_TASK_PRIORITY       (configMAX_PRIORITIES - 2)
+#define BTN_TASK_STACK          (configMINIMAL_STACK_SIZE + 60)
+
+/* Botones de la tarjeta */
+typedef enum
+{
+    BTN_SW2 = 0,
+    BTN_SW3,
+    BTN_COUNT
+} btn_id_t;
+
+/* Gestos que se publican */
+typedef enum
+{
+    BTN_SHORT = 0,   /* se emite al cerrar la ventana de doble presión */
+    BTN_LONG,        /* se emite al cumplir BTN_LONG_MS, sin esperar a soltar */
+    BTN_DOUBLE       /* se emite al soltar la segunda presión */
+} btn_gesture_t;
+
+typedef struct
+{
+    uint8_t button;   /* btn_id_t */
+    uint8_t gesture;  /* btn_gesture_t */
+} btn_event_t;
+
+/* ======= API ======= */
+/* Crea las colas y la tarea de clasificación. Sin hardware: llamar antes
+   de GPIO_BOARD_INIT(), que habilita las IRQ de PORTA/PORTC */
+bool BTN_Init(void);
+/* Lee el nivel inicial y pone SW2/SW3 en ambos flancos (pines ya configurados) */
+void BTN_Start(void);
+bool BTN_Receive(btn_event_t *out, TickType_t ticks_to_wait);
+
+#endif /* BUTTONS_H_ */
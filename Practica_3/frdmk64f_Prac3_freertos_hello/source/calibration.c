@@ -0,0 +1,145 @@
+/*
+ * calibration.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include <stddef.h>
+#include "calibration.h"
+
+#define CAL_Q32_ONE     4294967296.0f
+/* Las fórmulas originales truncaban (división entera). En Q32 el error del
+   float de CAL_Init queda muy por debajo de esto; el sesgo solo evita que un
+   resultado exacto (300 en 4095) caiga al entero de abajo */
+#define CAL_Q32_BIAS    ((int64_t)1 << 19)      /* 1/8192 de unidad */
+
+/* ======= Contexto interno ======= */
+/* Tramo precalculado, en cuentas crudas:
+   display = (d_k*raw + d_b) >> 32,  pixel = (p_k*raw + p_b) >> 32 */
+typedef struct
+{
+    uint16_t raw_start;
+    int64_t  d_k, d_b;
+    int64_t  p_k, p_b;
+} cal_seg_t;
+
+typedef struct
+{
+    bool      valid;
+    uint8_t   n_seg;
+    uint8_t   pix_min, pix_max;
+    uint16_t  alarm_low, alarm_high;
+    cal_seg_t seg[CAL_MAX_POINTS - 1U];
+} cal_chan_t;
+
+static cal_chan_t s_cal[CAL_MAX_CHANNELS];
+
+/* ======= Prototipos locales ======= */
+static float   prv_counts_to_raw(const cal_config_t *cfg, float counts);
+static int64_t prv_q32(float v);
+
+/* ======= Implementación ======= */
+bool CAL_Init(uint8_t ch, const cal_config_t *cfg)
+{
+    cal_chan_t *c;
+    cal_point_t line[2];
+    const cal_point_t *pts;
+    uint8_t n, i;
+    float px_per_unit;
+
+    if (ch >= CAL_MAX_CHANNELS || !cfg) return false;
+    if (cfg->gain <= 0.0f || cfg->full_scale == 0U || cfg->pix_span == 0U) return false;
+    if (cfg->unit_max <= cfg->unit_min) return false;
+    if (cfg->pwl_len > CAL_MAX_POINTS) return false;
+
+    c = &s_cal[ch];
+    c->valid = false;
+
+    if (cfg->pwl != NULL && cfg->pwl_len >= 2U)
+    {
+        pts = cfg->pwl;
+        n   = cfg->pwl_len;
+    }
+    else
+    {
+        line[0].counts = 0U;              line[0].value = cfg->unit_min;
+        line[1].counts = cfg->full_scale; line[1].value = cfg->unit_max;
+        pts = line;
+        n   = 2U;
+    }
+
+    px_per_unit = (float)cfg->pix_span / (float)(cfg->unit_max - cfg->unit_min);
+
+    for (i = 0; i + 1U < n; i++)
+    {
+        float x0 = prv_counts_to_raw(cfg, (float)pts[i].counts);
+        float x1 = prv_counts_to_raw(cfg, (float)pts[i + 1U].counts);
+        float k, b;
+
+        if (x1 <= x0) return false;      /* puntos desordenados */
+
+        /* Recta del tramo en cuentas crudas: offset y ganancia quedan dentro */
+        k = ((float)pts[i + 1U].value - (float)pts[i].value) / (x1 - x0);
+        b = (float)pts[i].value - k * x0;
+
+        c->seg[i].raw_start = (x0 <= 0.0f) ? 0U : (x0 >= 65535.0f) ? 0xFFFFU : (uint16_t)x0;
+        c->seg[i].d_k = prv_q32(k);
+        c->seg[i].d_b = prv_q32(b) + CAL_Q32_BIAS;   /* trunca, como las fórmulas originales */
+        c->seg[i].p_k = prv_q32(k * px_per_unit);
+        c->seg[i].p_b = prv_q32((b - (float)cfg->unit_min) * px_per_unit + (float)cfg->pix_base) + CAL_Q32_BIAS;
+    }
+    /* El primer tramo cubre también lo que quede por debajo */
+    c->seg[0].raw_start = 0U;
+
+    c->n_seg      = (uint8_t)(n - 1U);
+    c->pix_min    = cfg->pix_base;
+    c->pix_max    = (uint8_t)(cfg->pix_base + cfg->pix_span - 1U);
+    c->alarm_low  = cfg->alarm_low;
+    c->alarm_high = cfg->alarm_high;
+    c->valid      = true;
+    return true;
+}
+
+bool CAL_Convert(uint8_t ch, uint16_t raw, cal_result_t *out)
+{
+    const cal_chan_t *c;
+    const cal_seg_t  *s;
+    int32_t d, p;
+    uint8_t i;
+
+    if (ch >= CAL_MAX_CHANNELS || !out) return false;
+    c = &s_cal[ch];
+    if (!c->valid) return false;
+
+    /* Tramo: casi siempre hay uno solo */
+    i = 0;
+    while ((uint8_t)(i + 1U) < c->n_seg && raw >= c->seg[i + 1U].raw_start) { i++; }
+    s = &c->seg[i];
+
+    d = (int32_t)((s->d_k * raw + s->d_b) >> 32);
+    p = (int32_t)((s->p_k * raw + s->p_b) >> 32);
+
+    if (d < 0)       d = 0;
+    if (d > 0xFFFF)  d = 0xFFFF;
+    if (p < (int32_t)c->pix_min) p = c->pix_min;
+    if (p > (int32_t)c->pix_max) p = c->pix_max;
+
+    out->display = (uint16_t)d;
+    out->pixel   = (uint8_t)p;
+    out->fault   = (out->display <= c->alarm_low) || (out->display >= c->alarm_high);
+    return true;
+}
+
+/* ======= Estáticos locales ======= */
+/* Inverso de la corrección: counts = gain * (raw - offset) */
+static float prv_counts_to_raw(const cal_config_t *cfg, float counts)
+{
+    return counts / cfg->gain + (float)cfg->offset;
+}
+
+static int64_t prv_q32(float v)
+{
+    v *= CAL_Q32_ONE;
+    return (int64_t)((v >= 0.0f) ? (v + 0.5f) : (v - 0.5f));
+}
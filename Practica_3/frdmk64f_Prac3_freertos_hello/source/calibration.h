@@ -0,0 +1,65 @@
+/*
+ * calibration.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Calibración por canal y conversión ADC -> unidades en punto fijo.
+ * CAL_Init() traduce offset, ganancia y la corrección por tramos a
+ * coeficientes Q32 (con float, una sola vez); CAL_Convert() saca display,
+ * pixel y alarma de la misma muestra con una multiplicación-suma por unidad.
+ * Solo usa <stdint.h>/<stdbool.h>, igual que monitor_core.
+ */
+
+#ifndef CALIBRATION_H_
+#define CALIBRATION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ======= Configuración ======= */
+#define CAL_MAX_CHANNELS        4U     /* indexado por convSource */
+#define CAL_MAX_POINTS          8U     /* puntos de la corrección por tramos */
+
+/* Punto de la corrección: cuentas ya corregidas (offset/ganancia) -> unidades */
+typedef struct
+{
+    uint16_t counts;
+    uint16_t value;
+} cal_point_t;
+
+typedef struct
+{
+    int16_t  offset;        /* cuentas que se restan al crudo */
+    float    gain;          /* corrección de ganancia, 1.0 = ideal */
+    uint16_t full_scale;    /* cuentas a fondo de escala (4095 en 12 bits) */
+
+    /* Unidades de display: recta unit_min..unit_max sobre 0..full_scale,
+       o, si pwl_len >= 2, los tramos de pwl (ordenados por counts) */
+    uint16_t unit_min;
+    uint16_t unit_max;
+    const cal_point_t *pwl;
+    uint8_t  pwl_len;
+
+    /* Fila de pixel: unit_min..unit_max -> pix_base..pix_base+pix_span-1 */
+    uint8_t  pix_base;
+    uint8_t  pix_span;
+
+    /* Falla si display <= alarm_low o display >= alarm_high */
+    uint16_t alarm_low;
+    uint16_t alarm_high;
+} cal_config_t;
+
+typedef struct
+{
+    uint16_t display;       /* unidades de display (centésimas de mV, décimas de °C...) */
+    uint8_t  pixel;
+    bool     fault;
+} cal_result_t;
+
+/* ======= API ======= */
+bool CAL_Init(uint8_t ch, const cal_config_t *cfg);
+/* false si el canal no está calibrado */
+bool CAL_Convert(uint8_t ch, uint16_t raw, cal_result_t *out);
+
+#endif /* CALIBRATION_H_ */
@@ -0,0 +1,46 @@
+/*
+ * console.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "console.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "rtos_static.h"
+
+/* ======= Contexto interno ======= */
+static SemaphoreHandle_t s_hLock;
+static StaticSemaphore_t console_lock_buf RTOS_STATIC;
+
+/* ======= Implementación ======= */
+bool CONSOLE_Init(void)
+{
+    s_hLock = xSemaphoreCreateMutexStatic(&console_lock_buf);
+    return (s_hLock != NULL);
+}
+
+/* Sin mutex todavía (arranque, una sola tarea) se escribe directo */
+void CONSOLE_Lock(void)
+{
+    if (s_hLock != NULL)
+    {
+        (void)xSemaphoreTake(s_hLock, portMAX_DELAY);
+    }
+}
+
+void CONSOLE_Unlock(void)
+{
+    if (s_hLock != NULL)
+    {
+        (void)xSemaphoreGive(s_hLock);
+    }
+}
+
+void CONSOLE_Write(const void *data, size_t len)
+{
+    CONSOLE_Lock();
+    (void)DbgConsole_SendDataReliable((uint8_t *)data, len);
+    CONSOLE_Unlock();
+}
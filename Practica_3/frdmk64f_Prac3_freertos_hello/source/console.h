@@ -0,0 +1,33 @@
+/*
+ * console.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Salida por la UART de debug compartida: texto del eco de muestras, tramas
+ * de rtos_stats y lotes de telemetry. En modo bloqueante el debug console
+ * del SDK no tiene lock, así que dos tareas que escriben a la vez mezclan
+ * sus bytes; todo lo que sale con el scheduler corriendo pasa por aquí.
+ */
+
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Envío crudo del debug console (está en fsl_debug_console.c pero no en su
+   .h); fuera de este módulo usar CONSOLE_Write */
+int DbgConsole_SendDataReliable(uint8_t *ch, size_t size);
+
+/* ======= API ======= */
+/* Crea el mutex; después de BOARD_InitDebugConsole y antes de las tareas */
+bool CONSOLE_Init(void);
+/* Escribe los bytes tal cual, sin que otra escritura se meta en medio */
+void CONSOLE_Write(const void *data, size_t len);
+/* Para un PRINTF desde una tarea: CONSOLE_Lock(); PRINTF(...); CONSOLE_Unlock(); */
+void CONSOLE_Lock(void);
+void CONSOLE_Unlock(void);
+
+#endif /* CONSOLE_H_ */
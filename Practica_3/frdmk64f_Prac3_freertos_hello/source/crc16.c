@@ -0,0 +1,26 @@
+/*
+ * crc16.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "crc16.h"
+
+/* Versión por nibble: tabla de 16 entradas (32 bytes de flash) en vez de 512 */
+static const uint16_t s_crc_nibble[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *data, uint32_t len)
+{
+    while (len--)
+    {
+        uint8_t b = *data++;
+        crc = (uint16_t)((crc << 4) ^ s_crc_nibble[(uint8_t)((crc >> 12) ^ (b >> 4))]);
+        crc = (uint16_t)((crc << 4) ^ s_crc_nibble[(uint8_t)((crc >> 12) ^ (b & 0x0Fu))]);
+    }
+    return crc;
+}
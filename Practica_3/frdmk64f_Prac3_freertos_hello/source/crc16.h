@@ -0,0 +1,25 @@
+/*
+ * crc16.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef CRC16_H_
+#define CRC16_H_
+
+#include <stdint.h>
+
+/* CRC-16/CCITT-FALSE: poly 0x1021, init 0xFFFF, sin reflexión */
+#define CRC16_INIT    0xFFFFu
+
+/* Acumula 'len' bytes sobre un CRC previo (permite cálculo incremental) */
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *data, uint32_t len);
+
+/* CRC completo de un bloque */
+static inline uint16_t CRC16_Compute(const uint8_t *data, uint32_t len)
+{
+    return CRC16_Update(CRC16_INIT, data, len);
+}
+
+#endif /* CRC16_H_ */
@@ -0,0 +1,98 @@
+/*
+ * display_pacer.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Envía el framebuffer solo cuando hay un frame nuevo, desde una tarea de
+ * baja prioridad: la transferencia SPI de 504 bytes ya no corre en el
+ * daemon de timers, así que los timers del ADC y de alarmas no la esperan.
+ * Como solo se envía con datos nuevos, el FPS real sigue al ritmo de datos;
+ * el periodo mínimo lo ajusta la aplicación según la pantalla.
+ */
+
+#include "display_pacer.h"
+#include "task.h"
+#include "LCD_nokia.h"
+#include "rtos_static.h"
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    TaskHandle_t       hTask;
+    volatile TickType_t min_period;
+    uint32_t           flushes;
+    uint32_t           coalesced;
+} disp_ctx_t;
+
+static disp_ctx_t s_disp;
+
+RTOS_STATIC_TASK(disp, DISP_TASK_STACK);
+
+/* ======= Prototipos locales ======= */
+static void prv_task(void *pvParameters);
+
+/* ======= Implementación ======= */
+bool DISP_Init(void)
+{
+    s_disp.min_period = pdMS_TO_TICKS(DISP_DEFAULT_PERIOD_MS);
+    s_disp.flushes    = 0U;
+    s_disp.coalesced  = 0U;
+
+    s_disp.hTask = xTaskCreateStatic(prv_task, "DispFlush", DISP_TASK_STACK, NULL,
+                                     DISP_TASK_PRIORITY, disp_stack, &disp_tcb);
+    return (s_disp.hTask != NULL);
+}
+
+void DISP_FrameReady(void)
+{
+    if (s_disp.hTask != NULL)
+    {
+        (void)xTaskNotifyGive(s_disp.hTask);
+    }
+}
+
+void DISP_SetMinPeriodMs(uint32_t period_ms)
+{
+    s_disp.min_period = pdMS_TO_TICKS(period_ms);
+}
+
+uint32_t DISP_GetFlushCount(void)
+{
+    return s_disp.flushes;
+}
+
+uint32_t DISP_GetCoalescedCount(void)
+{
+    return s_disp.coalesced;
+}
+
+/* ======= Estáticos locales ======= */
+static void prv_task(void *pvParameters)
+{
+    TickType_t last = 0U;
+    TickType_t elapsed;
+    uint32_t   frames;
+
+    (void)pvParameters;
+
+    for (;;)
+    {
+        /* Sin frames nuevos la tarea no corre (y el MCU puede dormir) */
+        frames  = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        elapsed = xTaskGetTickCount() - last;
+        if (elapsed < s_disp.min_period)
+        {
+            vTaskDelay(s_disp.min_period - elapsed);
+        }
+        /* Lo que llegó durante la espera ya está en el framebuffer */
+        frames += ulTaskNotifyTake(pdTRUE, 0);
+
+        LCD_nokia_sent_FrameBuffer();
+        last = xTaskGetTickCount();
+
+        s_disp.flushes++;
+        s_disp.coalesced += frames - 1U;
+    }
+}
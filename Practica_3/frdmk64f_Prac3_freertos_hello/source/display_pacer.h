@@ -0,0 +1,34 @@
+/*
+ * display_pacer.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef DISPLAY_PACER_H_
+#define DISPLAY_PACER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* FreeRTOS */
+#include "FreeRTOS.h"
+
+/* ======= Configuración ======= */
+#define DISP_TASK_PRIORITY      (tskIDLE_PRIORITY + 1)
+#define DISP_TASK_STACK         (configMINIMAL_STACK_SIZE + 60)
+#define DISP_DEFAULT_PERIOD_MS  33U    /* tope de ~30 FPS */
+
+/* ======= API ======= */
+/* Crea la tarea que manda el framebuffer al LCD */
+bool DISP_Init(void);
+/* El renderer terminó un frame: se envía en cuanto lo permita el tope de
+   FPS; varios frames listos dentro del mismo periodo salen en un solo envío */
+void DISP_FrameReady(void);
+/* Separación mínima entre envíos (tope de FPS) */
+void DISP_SetMinPeriodMs(uint32_t period_ms);
+/* Envíos hechos y frames que se fusionaron con otro */
+uint32_t DISP_GetFlushCount(void);
+uint32_t DISP_GetCoalescedCount(void);
+
+#endif /* DISPLAY_PACER_H_ */
@@ -0,0 +1,303 @@
+/*
+ * flash_log.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Log circular en P-Flash. Cada sector inicia con un encabezado (magic + número
+ * de secuencia) y después se llena con registros de 16 bytes en orden. Al
+ * llenarse se borra el sector más viejo y pasa a ser el activo, así que el
+ * desgaste queda repartido por igual entre todos los sectores de la región.
+ */
+
+#include <string.h>
+
+#include "flash_log.h"
+#include "crc16.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "fsl_flash.h"
+
+/* ======= Formato en flash ======= */
+#define FLOG_MAGIC          0x474F4C46U   /* "FLOG" */
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t seq;       /* crece con cada rotación; el mayor es el activo */
+    uint32_t seq_inv;   /* ~seq: descarta encabezados a medio programar */
+    uint32_t reserved;
+} flog_hdr_t;
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    flash_config_t      flash;
+    ftfx_cache_config_t cache;
+    bool                mounted;
+    uint8_t             active;        /* sector donde se escribe */
+    uint32_t            active_seq;
+    uint16_t            next_slot;     /* 1..FLOG_SLOTS_PER_SECTOR (lleno) */
+    uint8_t             batch_count;
+    flog_record_t       batch[FLOG_BATCH_RECORDS];
+} flog_ctx_t;
+
+static flog_ctx_t s_flog;
+
+/* ======= Prototipos locales ======= */
+static inline uint32_t prv_sector_addr(uint8_t sector);
+static inline const flog_hdr_t *prv_hdr(uint8_t sector);
+static bool prv_hdr_valid(const flog_hdr_t *hdr);
+static bool prv_slot_erased(uint8_t sector, uint16_t slot);
+static uint16_t prv_find_free_slot(uint8_t sector);
+static uint16_t prv_record_crc(const flog_record_t *rec);
+static bool prv_program(uint32_t addr, const void *src, uint32_t len);
+static bool prv_start_sector(uint8_t sector, uint32_t seq);
+
+/* ======= Implementación ======= */
+bool FLOG_Init(void)
+{
+    uint8_t  s;
+    bool     found = false;
+
+    memset(&s_flog, 0, sizeof(s_flog));
+
+    if (FLASH_Init(&s_flog.flash) != kStatus_FTFx_Success)
+    {
+        return false;
+    }
+    if (FTFx_CACHE_Init(&s_flog.cache) != kStatus_FTFx_Success)
+    {
+        return false;
+    }
+
+    /* Solo se leen los encabezados: N lecturas, sin recorrer registros */
+    for (s = 0; s < FLOG_SECTOR_COUNT; s++)
+    {
+        const flog_hdr_t *hdr = prv_hdr(s);
+        if (prv_hdr_valid(hdr) && (!found || hdr->seq > s_flog.active_seq))
+        {
+            found             = true;
+            s_flog.active     = s;
+            s_flog.active_seq = hdr->seq;
+        }
+    }
+
+    if (!found)
+    {
+        /* Región virgen o corrupta: arranca en el sector 0 */
+        if (!prv_start_sector(0, 1U))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        s_flog.next_slot = prv_find_free_slot(s_flog.active);
+    }
+
+    s_flog.mounted = true;
+    return true;
+}
+
+bool FLOG_Append(uint8_t type, const void *payload, uint8_t len)
+{
+    flog_record_t rec;
+    bool          ok = false;
+
+    if (!s_flog.mounted || type == (uint8_t)FLOG_TYPE_ERASED) return false;
+    if (len > FLOG_PAYLOAD_SIZE) len = FLOG_PAYLOAD_SIZE;
+
+    memset(&rec, 0, sizeof(rec));
+    rec.type      = type;
+    rec.len       = len;
+    rec.timestamp = (uint32_t)xTaskGetTickCount();
+    if (payload && len) memcpy(rec.payload, payload, len);
+    rec.crc       = prv_record_crc(&rec);
+
+    taskENTER_CRITICAL();
+    if (s_flog.batch_count < FLOG_BATCH_RECORDS)
+    {
+        s_flog.batch[s_flog.batch_count++] = rec;
+        ok = true;
+    }
+    taskEXIT_CRITICAL();
+
+    return ok;
+}
+
+bool FLOG_Flush(void)
+{
+    flog_record_t local[FLOG_BATCH_RECORDS];
+    uint32_t      n, i = 0;
+
+    if (!s_flog.mounted) return false;
+
+    /* Toma el lote completo; los append concurrentes llenan uno nuevo */
+    taskENTER_CRITICAL();
+    n = s_flog.batch_count;
+    memcpy(local, s_flog.batch, n * sizeof(flog_record_t));
+    s_flog.batch_count = 0;
+    taskEXIT_CRITICAL();
+
+    while (i < n)
+    {
+        uint32_t chunk;
+
+        if (s_flog.next_slot >= FLOG_SLOTS_PER_SECTOR)
+        {
+            /* Sector lleno: el siguiente en el anillo es el más viejo */
+            uint8_t next = (uint8_t)((s_flog.active + 1U) % FLOG_SECTOR_COUNT);
+            if (!prv_start_sector(next, s_flog.active_seq + 1U))
+            {
+                return false;
+            }
+        }
+
+        chunk = FLOG_SLOTS_PER_SECTOR - s_flog.next_slot;
+        if (chunk > (n - i)) chunk = n - i;
+
+        /* Un solo comando de programación por tramo contiguo */
+        if (!prv_program(prv_sector_addr(s_flog.active) + (uint32_t)s_flog.next_slot * FLOG_RECORD_SIZE,
+                         &local[i], chunk * FLOG_RECORD_SIZE))
+        {
+            /* Se avanza igual: un slot a medio programar ya no está borrado */
+            s_flog.next_slot = prv_find_free_slot(s_flog.active);
+            return false;
+        }
+        s_flog.next_slot = (uint16_t)(s_flog.next_slot + chunk);
+        i += chunk;
+    }
+    return true;
+}
+
+uint32_t FLOG_Pending(void)
+{
+    return s_flog.batch_count;
+}
+
+uint32_t FLOG_Iterate(flog_visit_cb_t cb, void *ctx)
+{
+    uint8_t  order[FLOG_SECTOR_COUNT];
+    uint8_t  count = 0;
+    uint8_t  s, k;
+    uint16_t slot;
+    uint32_t visited = 0;
+
+    if (!s_flog.mounted || !cb) return 0;
+
+    /* Ordena los sectores válidos por secuencia (inserción; N es pequeño) */
+    for (s = 0; s < FLOG_SECTOR_COUNT; s++)
+    {
+        if (!prv_hdr_valid(prv_hdr(s))) continue;
+        k = count++;
+        while (k > 0 && prv_hdr(order[k - 1U])->seq > prv_hdr(s)->seq)
+        {
+            order[k] = order[k - 1U];
+            k--;
+        }
+        order[k] = s;
+    }
+
+    for (k = 0; k < count; k++)
+    {
+        const flog_record_t *recs = (const flog_record_t *)prv_sector_addr(order[k]);
+
+        for (slot = 1; slot < FLOG_SLOTS_PER_SECTOR; slot++)
+        {
+            if (prv_slot_erased(order[k], slot)) break;
+            /* Registros cortados por un reset quedan con CRC inválido: se saltan */
+            if (recs[slot].crc != prv_record_crc(&recs[slot])) continue;
+
+            visited++;
+            if (!cb(&recs[slot], ctx)) return visited;
+        }
+    }
+    return visited;
+}
+
+/* ======= Estáticos locales ======= */
+static inline uint32_t prv_sector_addr(uint8_t sector)
+{
+    return FLOG_BASE_ADDR + ((uint32_t)sector * FLOG_SECTOR_SIZE);
+}
+
+static inline const flog_hdr_t *prv_hdr(uint8_t sector)
+{
+    return (const flog_hdr_t *)prv_sector_addr(sector);
+}
+
+static bool prv_hdr_valid(const flog_hdr_t *hdr)
+{
+    return (hdr->magic == FLOG_MAGIC) && (hdr->seq == ~hdr->seq_inv);
+}
+
+static bool prv_slot_erased(uint8_t sector, uint16_t slot)
+{
+    const uint32_t *w = (const uint32_t *)(prv_sector_addr(sector) + (uint32_t)slot * FLOG_RECORD_SIZE);
+    return (w[0] & w[1] & w[2] & w[3]) == 0xFFFFFFFFU;
+}
+
+/* Los slots se escriben en orden, así que [1..k) ocupados y [k..fin) borrados:
+   búsqueda binaria en vez de recorrer el sector completo */
+static uint16_t prv_find_free_slot(uint8_t sector)
+{
+    uint16_t lo = 1, hi = FLOG_SLOTS_PER_SECTOR;
+
+    while (lo < hi)
+    {
+        uint16_t mid = (uint16_t)((lo + hi) / 2U);
+        if (prv_slot_erased(sector, mid)) hi = mid;
+        else                              lo = (uint16_t)(mid + 1U);
+    }
+    return lo;
+}
+
+static uint16_t prv_record_crc(const flog_record_t *rec)
+{
+    const uint8_t *p = (const uint8_t *)rec;
+    uint16_t crc = CRC16_Update(CRC16_INIT, p, 2U);                 /* type, len */
+    return CRC16_Update(crc, p + 4U, FLOG_RECORD_SIZE - 4U);        /* timestamp, payload */
+}
+
+static bool prv_program(uint32_t addr, const void *src, uint32_t len)
+{
+    status_t st;
+
+    FTFx_CACHE_ClearCachePrefetchSpeculation(&s_flog.cache, true);
+    st = FLASH_Program(&s_flog.flash, addr, (uint8_t *)src, len);
+    FTFx_CACHE_ClearCachePrefetchSpeculation(&s_flog.cache, false);
+
+    return (st == kStatus_FTFx_Success);
+}
+
+/* Borra el sector y escribe su encabezado; pasa a ser el activo */
+static bool prv_start_sector(uint8_t sector, uint32_t seq)
+{
+    flog_hdr_t hdr;
+    status_t   st;
+
+    FTFx_CACHE_ClearCachePrefetchSpeculation(&s_flog.cache, true);
+    st = FLASH_Erase(&s_flog.flash, prv_sector_addr(sector), FLOG_SECTOR_SIZE, kFTFx_ApiEraseKey);
+    FTFx_CACHE_ClearCachePrefetchSpeculation(&s_flog.cache, false);
+    if (st != kStatus_FTFx_Success)
+    {
+        return false;
+    }
+
+    hdr.magic    = FLOG_MAGIC;
+    hdr.seq      = seq;
+    hdr.seq_inv  = ~seq;
+    hdr.reserved = 0xFFFFFFFFU;
+    if (!prv_program(prv_sector_addr(sector), &hdr, sizeof(hdr)))
+    {
+        return false;
+    }
+
+    s_flog.active     = sector;
+    s_flog.active_seq = seq;
+    s_flog.next_slot  = 1;
+    return true;
+}
@@ -0,0 +1,67 @@
+/*
+ * flash_log.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef FLASH_LOG_H_
+#define FLASH_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ======= Geometría de la región de log ======= */
+/* Últimos sectores del bloque 1 de P-Flash: el código corre desde el bloque 0,
+   así que se puede programar aquí sin detener la ejecución (read-while-write).
+   PROGRAM_FLASH en la configuración de memoria del proyecto (.cproject) termina
+   en FLOG_BASE_ADDR: si la imagen no cabe, falla el link en vez de que
+   FLOG_Init la borre. Cambiar los dos juntos. */
+#define FLOG_SECTOR_SIZE        4096U
+#define FLOG_SECTOR_COUNT       8U
+#define FLOG_BASE_ADDR          (0x00100000U - (FLOG_SECTOR_COUNT * FLOG_SECTOR_SIZE))
+
+/* Registros de 16 bytes = 2 frases de programación (8 bytes c/u) */
+#define FLOG_RECORD_SIZE        16U
+#define FLOG_PAYLOAD_SIZE       8U
+#define FLOG_SLOTS_PER_SECTOR   (FLOG_SECTOR_SIZE / FLOG_RECORD_SIZE) /* slot 0 = encabezado */
+
+/* Registros acumulados en RAM antes de programar un lote */
+#define FLOG_BATCH_RECORDS      8U
+
+/* Tipos de registro */
+typedef enum
+{
+    FLOG_TYPE_BOOT    = 0x01,
+    FLOG_TYPE_ALARM   = 0x02,   /* entra en falla (LED rojo) */
+    FLOG_TYPE_CLEAR   = 0x03,   /* sale de falla */
+    FLOG_TYPE_SUMMARY = 0x10,   /* resumen periódico de lecturas */
+    FLOG_TYPE_ERASED  = 0xFF    /* slot vacío, no usar */
+} flog_type_t;
+
+typedef struct
+{
+    uint8_t  type;                       /* flog_type_t */
+    uint8_t  len;                        /* bytes válidos de payload */
+    uint16_t crc;                        /* CRC16 de todo el registro salvo este campo */
+    uint32_t timestamp;                  /* ticks de FreeRTOS al hacer append */
+    uint8_t  payload[FLOG_PAYLOAD_SIZE];
+} flog_record_t;
+
+/* Callback de recorrido: regresar false detiene la iteración */
+typedef bool (*flog_visit_cb_t)(const flog_record_t *rec, void *ctx);
+
+/* ======= API ======= */
+/* Monta la región: lee encabezados de sector, elige el activo y ubica
+   el siguiente slot libre. Si no hay log válido, formatea. */
+bool FLOG_Init(void);
+/* Copia el registro al lote en RAM (no toca la flash). false si el lote está lleno. */
+bool FLOG_Append(uint8_t type, const void *payload, uint8_t len);
+/* Programa el lote pendiente; rota/borra sector cuando se llena. Solo desde una tarea. */
+bool FLOG_Flush(void);
+/* Registros pendientes en RAM */
+uint32_t FLOG_Pending(void);
+/* Recorre los registros válidos del más viejo al más nuevo */
+uint32_t FLOG_Iterate(flog_visit_cb_t cb, void *ctx);
+
+#endif /* FLASH_LOG_H_ */
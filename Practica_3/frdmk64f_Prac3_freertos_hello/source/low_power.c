@@ -0,0 +1,228 @@
+/*
+ * low_power.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Tickless idle propio (configUSE_TICKLESS_IDLE = 2). Cuando el kernel no
+ * espera trabajo en varios ticks, se detiene SysTick, se programa el LPTMR
+ * (cristal de 32 kHz, sigue contando en STOP/VLPS) para despertar justo en el
+ * siguiente evento y se duerme. Al despertar se lee cuánto se durmió y se
+ * adelanta el tick con vTaskStepTick(); lo que sobra de un tick se arrastra
+ * al siguiente sueño para no acumular deriva.
+ */
+
+#include "low_power.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "fsl_device_registers.h"
+#include "fsl_common.h"
+#include "fsl_clock.h"
+#include "fsl_smc.h"
+#include "board.h"
+
+/* Barrera para salir de ISR si el SDK no la define */
+#ifndef SDK_ISR_EXIT_BARRIER
+#define SDK_ISR_EXIT_BARRIER __DSB(); __ISB()
+#endif
+
+#define LP_TICK_US          (1000UL * portTICK_PERIOD_MS)
+/* Cuentas de LPTMR a us: 1e6 / 1024 = 15625 / 16 exacto */
+#define LP_COUNTS_TO_US(c)  (((uint32_t)(c) * 15625UL) / 16UL)
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    uint32_t   carry_us;    /* tiempo real aún no acreditado al tick (< 1 tick) */
+    uint32_t   asleep_us;   /* fracción de ms dormida aún no sumada a asleep_ms */
+    bool       clk_ok;      /* ERCLK32K ya cuenta: se puede dormir */
+    lp_stats_t stats;
+} lp_ctx_t;
+
+static lp_ctx_t s_lp;
+
+/* ======= Prototipos locales ======= */
+static uint32_t prv_lptmr_stop(uint32_t programmed);
+static bool prv_clock_running(void);
+static void prv_wait_uart_idle(void);
+
+/* ======= Implementación ======= */
+void LP_Init(void)
+{
+    SMC_SetPowerModeProtection(SMC, kSMC_AllowPowerModeAll);
+
+    /* ERCLK32K = RTC32KCLK (OSC32KSEL en clock_config.c), pero BOARD_BootClockRUN
+       no enciende el oscilador del RTC. Carga de 10 pF como en la configuración */
+    CLOCK_EnableClock(kCLOCK_Rtc0);
+    if ((RTC->CR & RTC_CR_OSCE_MASK) == 0U)
+    {
+        RTC->CR |= RTC_CR_SC8P_MASK | RTC_CR_SC2P_MASK | RTC_CR_OSCE_MASK;
+    }
+
+    CLOCK_EnableClock(kCLOCK_Lptmr0);
+    LPTMR0->CSR = 0;                                         /* apagado, contador en 0 */
+    LPTMR0->PSR = LPTMR_PSR_PCS(2) | LPTMR_PSR_PRESCALE(LP_LPTMR_PRESCALE);   /* ERCLK32K / 32 */
+    /* Libre (sin IRQ) hasta ver que el cristal ya arrancó, ver prv_clock_running() */
+    LPTMR0->CMR = 0xFFFFU;
+    LPTMR0->CSR = LPTMR_CSR_TFC_MASK | LPTMR_CSR_TEN_MASK;
+
+    /* Solo despierta al core; el ISR no llama API de FreeRTOS */
+    NVIC_SetPriority(LPTMR0_IRQn, LP_LPTMR_IRQ_PRIO);
+    EnableIRQ(LPTMR0_IRQn);
+}
+
+void LP_GetStats(lp_stats_t *out)
+{
+    if (!out) return;
+    taskENTER_CRITICAL();
+    *out = s_lp.stats;
+    taskEXIT_CRITICAL();
+}
+
+/* Llamado por el kernel desde la tarea Idle con el scheduler suspendido */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+    uint32_t sleep_ms, counts, slept, slept_us, total_us, ticks, partial_us;
+    bool     vlps;
+
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    /* Pudo llegar una IRQ que hizo lista a una tarea, o el cristal aún no
+       arranca (el LPTMR no despertaría): no dormir */
+    if ((eTaskConfirmSleepModeStatus() == eAbortSleep) || !prv_clock_running())
+    {
+        __enable_irq();
+        return;
+    }
+
+    /* Congela SysTick; lo transcurrido del tick actual cuenta como arrastre */
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    partial_us = (SysTick->LOAD - SysTick->VAL) / (SystemCoreClock / 1000000U);
+
+    sleep_ms = (uint32_t)xExpectedIdleTime * portTICK_PERIOD_MS;
+    if (sleep_ms > LP_LPTMR_MAX_MS) sleep_ms = LP_LPTMR_MAX_MS;
+    /* Tick pendiente (SysTick llegó a 0 justo antes) o no alcanza ni para un ms
+       de LPTMR: SysTick sigue desde donde iba */
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) ||
+        (sleep_ms <= ((s_lp.carry_us + partial_us) / 1000U) + 1U))
+    {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        __enable_irq();
+        return;
+    }
+    s_lp.carry_us += partial_us;
+    sleep_ms -= s_lp.carry_us / 1000U;
+
+    /* Redondeo hacia abajo: nunca despertar después del evento */
+    counts = (sleep_ms * LP_LPTMR_HZ) / 1000U;
+    LPTMR0->CMR = counts - 1U;
+    LPTMR0->CSR = LPTMR_CSR_TIE_MASK;
+    LPTMR0->CSR |= LPTMR_CSR_TEN_MASK;
+
+    /* En STOP se apaga el reloj de la UART: deja salir el último byte */
+    prv_wait_uart_idle();
+
+    vlps = (sleep_ms >= LP_VLPS_MIN_MS);
+    SMC_PreEnterStopModes();
+    if (vlps)
+    {
+        (void)SMC_SetPowerModeVlps(SMC);
+    }
+    else
+    {
+        (void)SMC_SetPowerModeStop(SMC, kSMC_PartialStop);
+    }
+    SMC_PostExitStopModes();
+
+    /* Al salir de VLPS (o de STOP con PLLSTEN = 0) el MCG queda en PBE: CLKS
+       sigue en 10 y el core corre con el cristal de 50 MHz. Esperar a que el
+       PLL enganche y regresar a PEE, como el demo power_mode_switch del SDK;
+       si no, SysTick, la UART y el DWT quedan a otra frecuencia */
+    while ((MCG->S & MCG_S_LOCK0_MASK) == 0U) {}
+    if (CLOCK_GetMode() == kMCG_ModePBE)
+    {
+        (void)CLOCK_SetPeeMode();
+    }
+    while ((MCG->S & MCG_S_CLKST_MASK) != MCG_S_CLKST(3U)) {}   /* 3 = salida del PLL */
+
+    slept    = prv_lptmr_stop(counts);
+    slept_us = LP_COUNTS_TO_US(slept);
+
+    /* Acredita ticks completos; el resto queda para la próxima vez */
+    total_us = slept_us + s_lp.carry_us;
+    ticks    = total_us / LP_TICK_US;
+    if (ticks > (uint32_t)xExpectedIdleTime) ticks = (uint32_t)xExpectedIdleTime;
+    s_lp.carry_us = total_us - (ticks * LP_TICK_US);
+    vTaskStepTick((TickType_t)ticks);
+
+    SysTick->VAL  = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    s_lp.asleep_us       += slept_us;
+    s_lp.stats.asleep_ms += s_lp.asleep_us / 1000U;
+    s_lp.asleep_us       %= 1000U;
+    s_lp.stats.wakeups++;
+    if (vlps) s_lp.stats.vlps_entries++;
+
+    /* Aquí corre el ISR que despertó al core (LPTMR, botón, ...) */
+    __enable_irq();
+}
+
+/* ======= IRQ handler ======= */
+void LPTMR0_IRQHandler(void)
+{
+    /* El trabajo se hace en vPortSuppressTicksAndSleep; solo limpiar bandera */
+    LPTMR0->CSR = 0;
+    SDK_ISR_EXIT_BARRIER;
+}
+
+/* ======= Estáticos locales ======= */
+/* Detiene el LPTMR y regresa las cuentas realmente dormidas */
+static uint32_t prv_lptmr_stop(uint32_t programmed)
+{
+    uint32_t elapsed;
+
+    if (LPTMR0->CSR & LPTMR_CSR_TCF_MASK)
+    {
+        elapsed = programmed;           /* despertó por comparación */
+    }
+    else
+    {
+        LPTMR0->CNR = 0;                /* escribir captura el contador en CNR */
+        elapsed = LPTMR0->CNR & LPTMR_CNR_COUNTER_MASK;
+    }
+
+    LPTMR0->CSR = 0;                    /* TEN = 0 reinicia contador y TCF */
+    NVIC_ClearPendingIRQ(LPTMR0_IRQn);
+    return elapsed;
+}
+
+/* El cristal de 32 kHz tarda ~1 s en arrancar. Mientras, el LPTMR quedó
+   libre desde LP_Init(): en cuanto cuenta algo, se detiene y ya se puede dormir */
+static bool prv_clock_running(void)
+{
+    if (!s_lp.clk_ok)
+    {
+        LPTMR0->CNR = 0;                /* escribir captura el contador en CNR */
+        if ((LPTMR0->CNR & LPTMR_CNR_COUNTER_MASK) != 0U)
+        {
+            LPTMR0->CSR = 0;
+            s_lp.clk_ok = true;
+        }
+    }
+    return s_lp.clk_ok;
+}
+
+static void prv_wait_uart_idle(void)
+{
+    UART_Type *uart = (UART_Type *)BOARD_DEBUG_UART_BASEADDR;
+
+    if (uart->C2 & UART_C2_TE_MASK)
+    {
+        while ((uart->S1 & UART_S1_TC_MASK) == 0U) {}
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * low_power.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef LOW_POWER_H_
+#define LOW_POWER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ======= Configuración ======= */
+/* LPTMR corre con ERCLK32K (cristal de 32.768 kHz del RTC) / 32 = 1024 Hz:
+   el LPO de 1 kHz no está recortado (±20 %) y el tick se desviaba lo mismo.
+   Máximo 65535 cuentas ≈ 64 s */
+#define LP_LPTMR_HZ             1024U
+#define LP_LPTMR_PRESCALE       4U          /* divide entre 2^(4+1) = 32 */
+#define LP_LPTMR_MAX_MS         ((0xFFFFUL * 1000UL) / LP_LPTMR_HZ)
+/* Desde este tiempo esperado de reposo se usa VLPS (menor consumo, regulador
+   en bajo consumo); por debajo, STOP normal (salida más rápida) */
+#define LP_VLPS_MIN_MS          20U
+/* Prioridad de la IRQ del LPTMR (debe ser >= configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY) */
+#define LP_LPTMR_IRQ_PRIO       5U
+
+/* Acumulados desde el arranque */
+typedef struct
+{
+    uint32_t asleep_ms;     /* tiempo total dormido (STOP + VLPS) */
+    uint32_t wakeups;       /* veces que se entró a bajo consumo */
+    uint32_t vlps_entries;  /* de esas, cuántas fueron VLPS */
+} lp_stats_t;
+
+/* ======= API ======= */
+/* Habilita LPTMR, el oscilador de 32 kHz del RTC y modos de bajo consumo.
+   No espera al cristal (arranca en ~1 s): hasta verlo contar no se duerme.
+   Llamar antes de vTaskStartScheduler() */
+void LP_Init(void);
+/* Copia de las estadísticas de sueño */
+void LP_GetStats(lp_stats_t *out);
+
+#endif /* LOW_POWER_H_ */
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <string.h>
+
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
@@ -32,11 +34,70 @@
 #include "GPIO_D.h"
 #include "event_groups.h"
 
+/* === Log persistente en flash === */
+#include "flash_log.h"
+
+/* === Estadísticas de ejecución === */
+#include "rtos_stats.h"
+
+/* === Tickless idle con LPTMR === */
+#include "low_power.h"
+
+/* === Objetos de FreeRTOS en memoria estática === */
+#include "rtos_static.h"
+
+/* === Lógica del monitor (independiente del HW) === */
+#include "monitor_core.h"
+
+/* === Botones con antirrebote y gestos === */
+#include "buttons.h"
+
+/* === Calibración y conversión en punto fijo === */
+#include "calibration.h"
+#include "monitor_cal.h"
+
+/* === Envío del framebuffer por frame terminado === */
+#include "display_pacer.h"
+
+/* === Formato numérico de ancho fijo === */
+#include "numfmt.h"
+
+/* === UART de debug compartida entre tareas === */
+#include "console.h"
+#include "telemetry.h"
+
 
 /* =================== Definiciones =================== */
 #define hello_task_PRIORITY    (configMAX_PRIORITIES - 1)
 #define ADC_PRIORITY      (configMAX_PRIORITIES - 2)
 #define GrapNumb_PRIORITY      (configMAX_PRIORITIES - 3)
+#define FlashLog_PRIORITY      (tskIDLE_PRIORITY + 1)
+#define FLOG_SUMMARY_PERIOD_S  60U   /* resumen min/max cada minuto */
+#define STATS_PERIOD_MS        1000U
+#define LCDprint_STACK         (configMINIMAL_STACK_SIZE + 120)
+#define AdcForwarder_STACK     (configMINIMAL_STACK_SIZE + 100)
+#define GraphProcess_STACK     (configMINIMAL_STACK_SIZE + 120)
+#define NumberProcess_STACK    (configMINIMAL_STACK_SIZE + 120)
+#define FlashLog_STACK         (configMINIMAL_STACK_SIZE + 100)
+#define Input_STACK            (configMINIMAL_STACK_SIZE + 60)
+#define ADC_CONV_QUEUE_LEN     5U
+/* Tope de FPS por pantalla: con una sola gráfica llega la mitad de datos */
+#define DISP_PERIOD_BOTH_MS    33U
+#define DISP_PERIOD_SINGLE_MS  66U
+#ifndef MONITOR_SAMPLE_ECHO
+#define MONITOR_SAMPLE_ECHO    1     /* 0 = sin eco por UART de cada lectura */
+#endif
+#ifndef MONITOR_TELEMETRY
+#define MONITOR_TELEMETRY      0     /* 1 = muestras crudas y lecturas en tramas binarias (reemplaza el eco de texto) */
+#endif
+/* Canales de telemetría: ADC crudo (uno por tag) y lecturas convertidas */
+#define TELEM_CH_ADC_RAW       0U    /* + convSource */
+#define TELEM_CH_HR_CENTIMV    8U
+#define TELEM_CH_TEMP_DECIC    9U
+#ifndef ADC_NOISE_REPORT
+#define ADC_NOISE_REPORT       0     /* 1 = tabla de ruido/throughput por UART al arrancar */
+#endif
+#define ADC_NOISE_SAMPLES      256U
 #define X_INCREMENT_DEFAULT    1
 #define INIT_DISPLAY both
 #define EV_FAULT_PRESENT      (1U<<0)  // 1 = fuera de rango actual
@@ -44,19 +105,20 @@
 #define EV_CLEAR2S_EXPIRED    (1U<<2)  // disparo de T_clear_2s
 
 
-/* ----- Tipos propios (como en tu P3.txt) ----- */
+/* ----- Tipos propios (point_str y modos en monitor_core.h) ----- */
+/* Resumen periódico para el log en flash (cabe justo en un payload de 8 bytes) */
+typedef struct{
+    uint16_t hr_min;
+    uint16_t hr_max;
+    uint16_t t_min;
+    uint16_t t_max;
+} vitals_summary_t;
+/* Muestra ya calibrada: AdcForwarder_task convierte una vez y la reparte */
 typedef struct{
-    uint8_t x;
-    uint8_t y;
-} point_str;
-
-enum {
-    heart = 0,
-    temp,
-    both
-};
+    uint8_t      convSource;
+    cal_result_t r;
+} calSample_str;
 /* =================== Recursos FreeRTOS =================== */
-static TimerHandle_t SendFBTimer;
 TimerHandle_t T_fault_5s;   // 1-shot
 TimerHandle_t T_clear_2s;   // 1-shot
 EventGroupHandle_t evg;
@@ -71,28 +133,57 @@ static QueueHandle_t PointQueueTEMP;
 static QueueHandle_t NumberQueueHR;     /* HR en centésimas de mV (0..300) */
 static QueueHandle_t NumberQueueTEMP;   /* TEMP en décimas de °C (340..400) */
 
+/* Últimas lecturas y resumen en curso (escribe NumberProcess_thread) */
+static volatile uint16_t last_hr_centimV;
+static volatile uint16_t last_t_deciC;
+static vitals_summary_t  summary = {0xFFFF, 0, 0xFFFF, 0};
+
+/* Memoria de los objetos anteriores, reservada en compilación */
+RTOS_STATIC_QUEUE(AdcConversionQueue, ADC_CONV_QUEUE_LEN, sizeof(calSample_str));
+RTOS_STATIC_QUEUE(PointQueueHR, 1, sizeof(uint16_t));
+RTOS_STATIC_QUEUE(PointQueueTEMP, 1, sizeof(uint16_t));
+RTOS_STATIC_QUEUE(TimeScaleMailbox, 1, sizeof(uint8_t));
+RTOS_STATIC_QUEUE(CurrentIDmailbox, 1, sizeof(uint8_t));
+RTOS_STATIC_QUEUE(NumberQueueHR, 1, sizeof(uint16_t));
+RTOS_STATIC_QUEUE(NumberQueueTEMP, 1, sizeof(uint16_t));
+RTOS_STATIC_TIMER(T_fault_5s);
+RTOS_STATIC_TIMER(T_clear_2s);
+static StaticEventGroup_t evg_buf RTOS_STATIC;
+RTOS_STATIC_TASK(LCDprint, LCDprint_STACK);
+RTOS_STATIC_TASK(AdcForwarder, AdcForwarder_STACK);
+RTOS_STATIC_TASK(GraphProcess, GraphProcess_STACK);
+RTOS_STATIC_TASK(NumberProcess, NumberProcess_STACK);
+RTOS_STATIC_TASK(FlashLog, FlashLog_STACK);
+RTOS_STATIC_TASK(Input, Input_STACK);
+
 /* =================== Prototipos =================== */
 static void LCDprint_thread(void *pvParameters);
 static void GraphProcess_thread(void *pvParameters);
 static void NumberProcess_thread(void *pvParameters);
 
-/* Nueva: reenvía del driver ADC -> AdcConversionQueue (dos veces) */
+/* Nueva: calibra cada muestra del driver y la reenvía a AdcConversionQueue (dos veces) */
 static void AdcForwarder_task(void *pvParameters);
 
+/* Vacía el log a flash y guarda resúmenes periódicos */
+static void FlashLog_thread(void *pvParameters);
+static void LogEvent(uint8_t type);
+
 /* Helpers de impresión formateada */
+static void SampleEcho(uint8_t channel, uint16_t value, const char *txt, uint8_t len);
 static void LCD_PrintCentimV(uint8_t x, uint8_t y, uint16_t centimV);
 static void LCD_PrintDeciC(uint8_t x, uint8_t y, uint16_t deciC);
 
+#if ADC_NOISE_REPORT
+static void AdcNoiseReport(void);
+#endif
+
 /* Init de subsistemas */
 static void ScreenInit(void);
 static void SWInit(void);
 
-/* Callbacks de timers */
-static void SendFBCallback(TimerHandle_t ARHandle);
 
-///* ISR botón */
-//void BOARD_SW3_IRQ_HANDLER(void);
-//void BOARD_SW2_IRQ_HANDLER(void);
+/* Gestos de botones -> buzones (las ISR viven en buttons.c) */
+static void Input_thread(void *pvParameters);
 
 /* =================== Código =================== */
 
@@ -106,77 +197,50 @@ static void ScreenInit(void)
 
 
 
-void BOARD_SW3_IRQ_HANDLER(void) {
-    /* Clear the interrupt flag for PTA4 using SDK function */
+/* Traduce gestos de SW2/SW3 a los buzones de la UI.
+   SW3 corto: siguiente escala de tiempo; SW3 largo: escala por defecto.
+   SW2 corto: siguiente pantalla;        SW2 largo: pantalla inicial. */
+static void Input_thread(void *pvParameters)
+{
+    btn_event_t ev;
+    uint8_t x_increment = X_INCREMENT_DEFAULT;
+    uint8_t id = INIT_DISPLAY;
 
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        static uint8_t x_increment = 1;
-#if (defined(FSL_FEATURE_PORT_HAS_NO_INTERRUPT) && FSL_FEATURE_PORT_HAS_NO_INTERRUPT)
-    GPIO_GpioClearInterruptFlags(BOARD_SW3_GPIO, 1U << BOARD_SW3_GPIO_PIN);
-#else
+    (void)pvParameters;
 
-        /* Mejor sería:
-           static uint8_t steps[] = {1,5,10};
-           static uint8_t idx = 0;
-           x_increment = steps[idx];
-           idx = (idx + 1) % 3;
-        */
-        if (x_increment < 10) {
-            x_increment += 5;
-        } else {
-            x_increment = 1;
+    for (;;)
+    {
+        if (!BTN_Receive(&ev, portMAX_DELAY))
+        {
+            continue;
         }
 
-        xQueueOverwriteFromISR(TimeScaleMailbox, &x_increment, &xHigherPriorityTaskWoken);
-        portYIELD_FROM_ISR(xHigherPriorityTaskWoken)
-        GPIO_PortClearInterruptFlags(GPIOA, (1U << 4));
-#endif
-
-
-
-    /* Change state of button */
-    SDK_ISR_EXIT_BARRIER;
-}
-
-
-
-void BOARD_SW2_IRQ_HANDLER(void) {
-	   BaseType_t xHPW = pdFALSE;
-	static uint8_t id = INIT_DISPLAY;  // 0
-#if (defined(FSL_FEATURE_PORT_HAS_NO_INTERRUPT) && FSL_FEATURE_PORT_HAS_NO_INTERRUPT)
-    GPIO_GpioClearInterruptFlags(BOARD_SW2_GPIO, 1U << BOARD_SW2_GPIO_PIN);
-#else
-
-	if (GPIO_PinRead(GPIOC, 6) == 0) { //STOP
-
-
-
-	    id = (uint8_t)((id + 1) % 3);  // heart->temp->both->heart...
-	    xQueueOverwriteFromISR(CurrentIDmailbox, &id, &xHPW);
-	    portYIELD_FROM_ISR(xHPW)
-
-
-	}
-	GPIO_PortClearInterruptFlags(GPIOC, (1U << 6));
-#endif
-
-    SDK_ISR_EXIT_BARRIER;
+        if (ev.button == BTN_SW3)
+        {
+            if (ev.gesture == BTN_SHORT)     { x_increment = MON_NextTimeScale(x_increment); }
+            else if (ev.gesture == BTN_LONG) { x_increment = X_INCREMENT_DEFAULT; }
+            else                             { continue; }
+            (void)xQueueOverwrite(TimeScaleMailbox, &x_increment);
+        }
+        else if (ev.button == BTN_SW2)
+        {
+            if (ev.gesture == BTN_SHORT)     { id = MON_NextMode(id); }  // heart->temp->both->heart...
+            else if (ev.gesture == BTN_LONG) { id = INIT_DISPLAY; }
+            else                             { continue; }
+            (void)xQueueOverwrite(CurrentIDmailbox, &id);
+        }
+    }
 }
 
 
-static void SendFBCallback(TimerHandle_t ARHandle)
-{
-    (void)ARHandle;
-    LCD_nokia_sent_FrameBuffer();
-}
-
 static void fault5s_cb(TimerHandle_t x) {
     // ALARMA
 	EventBits_t st = xEventGroupGetBits(evg);
 
 	uint8_t fault = ( (st & EV_FAULT_PRESENT) ? 1U : 0U );
 	if(fault){
-	redSet();}
+	redSet();
+	LogEvent(FLOG_TYPE_ALARM);}
     xEventGroupSetBits(evg, EV_FAULT5S_EXPIRED);
 }
 static void clear2s_cb(TimerHandle_t x) {
@@ -185,50 +249,90 @@ static void clear2s_cb(TimerHandle_t x) {
 
 	uint8_t fault = ( (st & EV_FAULT_PRESENT) ? 1U : 0U );
 	if(!fault){
-		allOFF();}
+		allOFF();
+		LogEvent(FLOG_TYPE_CLEAR);}
 
     xEventGroupSetBits(evg, EV_CLEAR2S_EXPIRED);
 }
 
 /* =================== Helpers de impresión =================== */
-/* HR: centésimas de mV -> "A.BC mv" (ej.: 152 => "1.52 mv") */
+/* Plantillas de ancho fijo: cada lectura reescribe exactamente la misma zona,
+   así que no hace falta limpiarla antes (7 y 8 caracteres = 35 y 40 columnas) */
+#define FMT_CENTIMV     "##.# mv"
+#define FMT_DECIC       "##.# C  "   /* sin '°' en la fuente */
+
+/* Eco por UART de la lectura: en telemetría el valor en una trama, si no
+   el texto ya formateado (sin pasar por PRINTF) */
+static void SampleEcho(uint8_t channel, uint16_t value, const char *txt, uint8_t len)
+{
+#if MONITOR_TELEMETRY
+    (void)TELEM_Send(channel, TELEM_T_U16, &value, sizeof(value));
+    (void)txt;
+    (void)len;
+#elif MONITOR_SAMPLE_ECHO
+    char line[sizeof(FMT_DECIC) + 2U];     /* la plantilla más larga + "\n\r" */
+
+    (void)channel;
+    (void)value;
+    memcpy(line, txt, len);
+    line[len]      = '\n';
+    line[len + 1U] = '\r';
+    CONSOLE_Write(line, (size_t)len + 2U);
+#else
+    (void)channel;
+    (void)value;
+    (void)txt;
+    (void)len;
+#endif
+}
+
+/* HR: centésimas de mV -> "AB.C mv" (ej.: 152 => "15.2 mv") */
 static void LCD_PrintCentimV(uint8_t x, uint8_t y, uint16_t centimV)
 {
-    uint8_t A = (uint8_t)((centimV / 100U) % 10U);
-    uint8_t B = (uint8_t)((centimV / 10U)  % 10U);
-    uint8_t C = (uint8_t)( centimV         % 10U);
-    PRINTF("%d%d.%d\n\r",A,B,C);
-    /* Limpia zona (ancho aprox ~30 cols) */
-    LCD_nokia_clear_range_FrameBuffer(x, y, 35);
-
-    LCD_nokia_write_char_xy_FB(x +  0, y, (uint8_t)('0' + A));
-    LCD_nokia_write_char_xy_FB(x +  5, y, (uint8_t)('0' + B));
-    LCD_nokia_write_char_xy_FB(x + 10, y, '.');
-    LCD_nokia_write_char_xy_FB(x + 15, y, (uint8_t)('0' + C));
-    LCD_nokia_write_char_xy_FB(x + 20, y, ' ');
-    LCD_nokia_write_string_xy_FB(x + 25, y, (uint8_t*)"mv", 2);
+    char txt[sizeof(FMT_CENTIMV)];
+    uint8_t len = NFMT_Template(txt, FMT_CENTIMV, centimV);
+
+    SampleEcho(TELEM_CH_HR_CENTIMV, centimV, txt, 4);   /* solo el número, como antes */
+    LCD_nokia_write_string_xy_FB(x, y, (uint8_t *)txt, len);
 }
 
-/* TEMP: décimas de °C -> "AA.B °C" (ej.: 365 => "36.5 °C") */
+/* TEMP: décimas de °C -> "AA.B C" (ej.: 365 => "36.5 C") */
 static void LCD_PrintDeciC(uint8_t x, uint8_t y, uint16_t deciC)
 {
-    uint16_t entero  = deciC / 10U;   /* 34..40 */
-    uint8_t  decimal = deciC % 10U;   /* 0..9   */
-
-    uint8_t tens = (uint8_t)((entero / 10U) % 10U);
-    uint8_t ones = (uint8_t)( entero        % 10U);
-    PRINTF("%d%d.%d\n\r",tens,ones,decimal);
-    LCD_nokia_clear_range_FrameBuffer(x, y, 40);
-
-    LCD_nokia_write_char_xy_FB(x +  0, y, (uint8_t)('0' + tens));
-    LCD_nokia_write_char_xy_FB(x +  5, y, (uint8_t)('0' + ones));
-    LCD_nokia_write_char_xy_FB(x + 10, y, '.');
-    LCD_nokia_write_char_xy_FB(x + 15, y, (uint8_t)('0' + decimal));
-    LCD_nokia_write_char_xy_FB(x + 20, y, ' ');
-    /* Si tu font no tiene '°', puedes usar 'o' o espacio */
-    // LCD_nokia_write_char_xy_FB(x + 25, y, 0xDF); /* A veces 0xDF se usa como '°' en fuentes personalizadas */
-    LCD_nokia_write_char_xy_FB(x + 25, y, 'C');    /* “ C” es suficiente */
+    char txt[sizeof(FMT_DECIC)];
+    uint8_t len = NFMT_Template(txt, FMT_DECIC, deciC);
+
+    SampleEcho(TELEM_CH_TEMP_DECIC, deciC, txt, 4);
+    LCD_nokia_write_string_xy_FB(x, y, (uint8_t *)txt, len);
+}
+
+#if ADC_NOISE_REPORT
+/* Ruido (LSB RMS) y resultados/s de cada modo, en ambos canales. Con la
+   entrada fija (o a tierra) el RMS es el piso de ruido del modo. */
+static void AdcNoiseReport(void)
+{
+    static const adc_chan_opts_t modes[] = {
+        { ADC_AVG_OFF, false, 0U }, { ADC_AVG_4,  false, 0U },
+        { ADC_AVG_8,   false, 0U }, { ADC_AVG_16, false, 0U },
+        { ADC_AVG_32,  false, 0U }, { ADC_AVG_OFF, true,  0U },
+        { ADC_AVG_32,  true,  0U }, { ADC_AVG_OFF, false, 2U },
+        { ADC_AVG_OFF, false, 4U }, { ADC_AVG_4,   false, 2U },
+    };
+    adc_noise_t r;
+    uint8_t src, i;
+
+    PRINTF("src avg 16b os bits mean rms_mLSB samples/s\r\n");
+    for (src = 0; src <= (uint8_t)ADC_SRC_TEMP; src++)
+    {
+        for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+        {
+            if (!ADC_MeasureNoise(src, &modes[i], ADC_NOISE_SAMPLES, &r)) continue;
+            PRINTF("%d %d %d %d %d %d %d %d\r\n", src, modes[i].hw_avg, modes[i].res16,
+                   modes[i].os_bits, r.bits, r.mean, r.rms_milli_lsb, r.samples_per_s);
+        }
+    }
 }
+#endif
 
 /* =================== main() =================== */
 int main(void)
@@ -247,45 +351,96 @@ int main(void)
     BOARD_InitBootPins();
     BOARD_InitBootClocks();
     BOARD_InitDebugConsole();
+    if (!CONSOLE_Init())
+    {
+        PRINTF("CONSOLE_Init failed!\r\n");
+        while (1) {}
+    }
 
     ScreenInit();
+    /* Antes de GPIO_BOARD_INIT(): sus IRQ de SW2/SW3 mandan a la cola de flancos */
+    if (!BTN_Init())
+    {
+        PRINTF("BTN_Init failed!\r\n");
+    }
     GPIO_BOARD_INIT();
+    BTN_Start();
+    LP_Init();
+
+    /* Monta el log; si falla la app sigue, solo sin persistencia */
+    if (FLOG_Init())
+    {
+        (void)FLOG_Append(FLOG_TYPE_BOOT, NULL, 0);
+    }
+    else
+    {
+        PRINTF("FLOG_Init failed!\r\n");
+    }
 
 
 
     /* ========= COLAS ========= */
-    AdcConversionQueue = xQueueCreate(5, sizeof(adcConv_str));
-    PointQueueHR      = xQueueCreate(1, sizeof(uint16_t));
-    PointQueueTEMP    = xQueueCreate(1, sizeof(uint16_t));
-    TimeScaleMailbox   = xQueueCreate(1, sizeof(uint8_t));
-    CurrentIDmailbox = xQueueCreate(1, sizeof(uint8_t));
+    /* Con memoria estática la creación no puede fallar (solo con buffers NULL) */
+    AdcConversionQueue = xQueueCreateStatic(ADC_CONV_QUEUE_LEN, sizeof(calSample_str),
+                                            AdcConversionQueue_storage, &AdcConversionQueue_qcb);
+    PointQueueHR      = xQueueCreateStatic(1, sizeof(uint16_t), PointQueueHR_storage, &PointQueueHR_qcb);
+    PointQueueTEMP    = xQueueCreateStatic(1, sizeof(uint16_t), PointQueueTEMP_storage, &PointQueueTEMP_qcb);
+    TimeScaleMailbox   = xQueueCreateStatic(1, sizeof(uint8_t), TimeScaleMailbox_storage, &TimeScaleMailbox_qcb);
+    CurrentIDmailbox = xQueueCreateStatic(1, sizeof(uint8_t), CurrentIDmailbox_storage, &CurrentIDmailbox_qcb);
     /* NUEVAS colas de números formateables */
-    NumberQueueHR      = xQueueCreate(1, sizeof(uint16_t));  /* centésimas de mV */
-    NumberQueueTEMP    = xQueueCreate(1, sizeof(uint16_t));  /* décimas de °C   */
-
-    /* ========= Timer de pantalla ========= */
-    SendFBTimer = xTimerCreate(
-        "WriteFB",
-        pdMS_TO_TICKS(33),   /* 33 ms ~ 30 FPS */
-        pdTRUE,
-        0,
-        SendFBCallback);
-    evg = xEventGroupCreate();
-
-    T_fault_5s = xTimerCreate("fault5s",
-                              pdMS_TO_TICKS(5000),
-                              pdFALSE, 0, fault5s_cb);
-
-    T_clear_2s = xTimerCreate("clear2s",
-                              pdMS_TO_TICKS(2000),
-                              pdFALSE, 0, clear2s_cb);
+    NumberQueueHR      = xQueueCreateStatic(1, sizeof(uint16_t), NumberQueueHR_storage, &NumberQueueHR_qcb);  /* centésimas de mV */
+    NumberQueueTEMP    = xQueueCreateStatic(1, sizeof(uint16_t), NumberQueueTEMP_storage, &NumberQueueTEMP_qcb);  /* décimas de °C   */
+
+    /* ========= Envío de pantalla (tarea propia, no timer) ========= */
+    if (!DISP_Init())
+    {
+        PRINTF("DISP_Init failed!\r\n");
+        while (1) {}
+    }
+#if MONITOR_TELEMETRY
+    if (!TELEM_Init())
+    {
+        PRINTF("Telemetry task creation failed!\r\n");
+        while (1) {}
+    }
+#endif
+    evg = xEventGroupCreateStatic(&evg_buf);
+
+    T_fault_5s = xTimerCreateStatic("fault5s",
+                                    pdMS_TO_TICKS(5000),
+                                    pdFALSE, 0, fault5s_cb, &T_fault_5s_tcb);
+
+    T_clear_2s = xTimerCreateStatic("clear2s",
+                                    pdMS_TO_TICKS(2000),
+                                    pdFALSE, 0, clear2s_cb, &T_clear_2s_tcb);
+
+    /* ======= Calibración: antes de que lleguen muestras ======= */
+    (void)CAL_Init(ADC_SRC_HEART, &mon_cal_heart);
+    (void)CAL_Init(ADC_SRC_TEMP, &mon_cal_temp);
 
     /* ======= Driver ADC: su cola interna + timer 100ms ======= */
     ADC_Init(10);
+    /* HR es la señal ruidosa: promedio HW de 16, sigue en 12 bits (mon_cal_heart no cambia) */
+    (void)ADC_SetChannelOptions(ADC_SRC_HEART, &(adc_chan_opts_t){ ADC_AVG_16, false, 0U });
+#if ADC_NOISE_REPORT
+    AdcNoiseReport();
+#endif
     ADC_Start();
 
-    /* ======= Arranque de timers ======= */
-    xTimerStart(SendFBTimer, 0);
+    /* ======= Estadísticas: colas a vigilar + tarea de reporte ======= */
+    STATS_RegisterQueue(AdcConversionQueue);
+    STATS_RegisterQueue(PointQueueHR);
+    STATS_RegisterQueue(PointQueueTEMP);
+    STATS_RegisterQueue(TimeScaleMailbox);
+    STATS_RegisterQueue(CurrentIDmailbox);
+    STATS_RegisterQueue(NumberQueueHR);
+    STATS_RegisterQueue(NumberQueueTEMP);
+    STATS_RegisterQueue(ADC_GetQueueHandle());
+    if (!STATS_Init(STATS_PERIOD_MS))
+    {
+        PRINTF("Stats task creation failed!\r\n");
+        while (1) {}
+    }
 
     /* Publica time-scale inicial */
     xQueueOverwrite(TimeScaleMailbox, &init_time_scale);
@@ -293,35 +448,48 @@ int main(void)
 
     /* ========= Tareas ========= */
 
-    if (xTaskCreate(LCDprint_thread, "LCDprint_thread",
-                    configMINIMAL_STACK_SIZE + 120, NULL, hello_task_PRIORITY, NULL) != pdPASS)
+    if (xTaskCreateStatic(LCDprint_thread, "LCDprint_thread", LCDprint_STACK, NULL,
+                          hello_task_PRIORITY, LCDprint_stack, &LCDprint_tcb) == NULL)
     {
         PRINTF("LCDprint_thread creation failed!\r\n");
         while (1) {}
     }
+
     /* Forwarder del driver hacia tu cola original (dos envíos) */
-     if (xTaskCreate(AdcForwarder_task, "AdcForwarder_task",
-                     configMINIMAL_STACK_SIZE + 100, NULL, ADC_PRIORITY, NULL) != pdPASS)
-     {
-         PRINTF("AdcForwarder_task creation failed!\r\n");
-         while (1) {}
-     }
-
-    if (xTaskCreate(GraphProcess_thread, "GraphProcess_thread",
-                    configMINIMAL_STACK_SIZE + 120, NULL, GrapNumb_PRIORITY, NULL) != pdPASS)
+    if (xTaskCreateStatic(AdcForwarder_task, "AdcForwarder_task", AdcForwarder_STACK, NULL,
+                          ADC_PRIORITY, AdcForwarder_stack, &AdcForwarder_tcb) == NULL)
+    {
+        PRINTF("AdcForwarder_task creation failed!\r\n");
+        while (1) {}
+    }
+
+    if (xTaskCreateStatic(GraphProcess_thread, "GraphProcess_thread", GraphProcess_STACK, NULL,
+                          GrapNumb_PRIORITY, GraphProcess_stack, &GraphProcess_tcb) == NULL)
     {
         PRINTF("GraphProcess_thread creation failed!\r\n");
         while (1) {}
     }
 
-    if (xTaskCreate(NumberProcess_thread, "NumberProcess_thread",
-                    configMINIMAL_STACK_SIZE + 120, NULL, GrapNumb_PRIORITY, NULL) != pdPASS)
+    if (xTaskCreateStatic(NumberProcess_thread, "NumberProcess_thread", NumberProcess_STACK, NULL,
+                          GrapNumb_PRIORITY, NumberProcess_stack, &NumberProcess_tcb) == NULL)
     {
         PRINTF("NumberProcess_thread creation failed!\r\n");
         while (1) {}
     }
 
+    if (xTaskCreateStatic(FlashLog_thread, "FlashLog_thread", FlashLog_STACK, NULL,
+                          FlashLog_PRIORITY, FlashLog_stack, &FlashLog_tcb) == NULL)
+    {
+        PRINTF("FlashLog_thread creation failed!\r\n");
+        while (1) {}
+    }
 
+    if (xTaskCreateStatic(Input_thread, "Input_thread", Input_STACK, NULL,
+                          GrapNumb_PRIORITY, Input_stack, &Input_tcb) == NULL)
+    {
+        PRINTF("Input_thread creation failed!\r\n");
+        while (1) {}
+    }
 
     vTaskStartScheduler();
 
@@ -335,8 +503,7 @@ static void LCDprint_thread(void *pvParameters)
 {
     (void)pvParameters;
 
-    point_str a_hr = {0,0}, b_hr = {0,0};
-    point_str a_tp = {0,0}, b_tp = {0,0};
+    mon_trace_t tr_hr, tr_tp;
 
     uint16_t y_hr, y_tp;
     uint16_t hr_centimV, t_deciC;
@@ -346,6 +513,7 @@ static void LCDprint_thread(void *pvParameters)
 
     uint8_t mode = INIT_DISPLAY;
     uint8_t last_mode = 0xFF; /* fuerza refresh inicial */
+    bool drawn;
 
     for (;;)
     {
@@ -355,14 +523,16 @@ static void LCDprint_thread(void *pvParameters)
         /* 2) Observa el modo (sin consumir) y detecta cambio */
         (void)xQueuePeek(CurrentIDmailbox, &mode, pdMS_TO_TICKS(15));
 
+        drawn = false;
         if (mode != last_mode)
         {
-            LCD_nokia_clear();
+            /* Solo framebuffer: el SPI lo usa únicamente la tarea de envío */
             LCD_nokia_clear_range_FrameBuffer(0, 0, 252);
             LCD_nokia_clear_range_FrameBuffer(0,3,252);
-            a_hr = (point_str){0,0}; b_hr = (point_str){0,0};
-            a_tp = (point_str){0,0}; b_tp = (point_str){0,0};
-
+            MON_TraceReset(&tr_hr);
+            MON_TraceReset(&tr_tp);
+            DISP_SetMinPeriodMs((mode == both) ? DISP_PERIOD_BOTH_MS : DISP_PERIOD_SINGLE_MS);
+            drawn = true;
         }
 
         /* 3) Impresión de números */
@@ -373,19 +543,15 @@ static void LCDprint_thread(void *pvParameters)
         {
             if (xQueueReceive(PointQueueHR, &y_hr, pdMS_TO_TICKS(15)) == pdTRUE)
             {
-                a_hr = b_hr;
-                if (mode != both) {
-                	y_hr = y_hr - 24U;
-				}
-                b_hr.y = y_hr;
-                if ((uint8_t)(b_hr.x + x_increment) < 84) { b_hr.x += x_increment; }
-                else { b_hr.x  = 0;
-                if(mode !=both){
-                	 LCD_nokia_clear_range_FrameBuffer(0,3,252);
-                }else{
-                	LCD_nokia_clear_range_FrameBuffer(0, 0, 252);}
+                if (MON_TraceAdvance(&tr_hr, MON_HeartRowForMode(y_hr, mode), x_increment))
+                {
+                    if(mode !=both){
+                    	 LCD_nokia_clear_range_FrameBuffer(0,3,252);
+                    }else{
+                    	LCD_nokia_clear_range_FrameBuffer(0, 0, 252);}
                 }
-                drawline(a_hr.x, a_hr.y, b_hr.x, b_hr.y, 50);
+                drawline(tr_hr.a.x, tr_hr.a.y, tr_hr.b.x, tr_hr.b.y, 50);
+                drawn = true;
             }
         }
 
@@ -393,13 +559,12 @@ static void LCDprint_thread(void *pvParameters)
         {
             if (xQueueReceive(PointQueueTEMP, &y_tp, pdMS_TO_TICKS(15)) == pdTRUE)
             {
-                a_tp = b_tp;
-
-                b_tp.y = y_tp;
-
-                if ((uint8_t)(b_tp.x + x_increment) < 84) { b_tp.x += x_increment; }
-                else                                      { b_tp.x  = 0; LCD_nokia_clear_range_FrameBuffer(0,3,252);}
-                drawline(a_tp.x, a_tp.y, b_tp.x, b_tp.y, 50);
+                if (MON_TraceAdvance(&tr_tp, (uint8_t)y_tp, x_increment))
+                {
+                    LCD_nokia_clear_range_FrameBuffer(0,3,252);
+                }
+                drawline(tr_tp.a.x, tr_tp.a.y, tr_tp.b.x, tr_tp.b.y, 50);
+                drawn = true;
             }
         }
 
@@ -409,6 +574,7 @@ static void LCDprint_thread(void *pvParameters)
                if (xQueueReceive(NumberQueueHR, &hr_centimV, pdMS_TO_TICKS(15)) == pdTRUE)
                {
                    LCD_PrintCentimV(0, 0, hr_centimV);
+                   drawn = true;
                }
            }
 
@@ -417,11 +583,18 @@ static void LCDprint_thread(void *pvParameters)
                if (xQueueReceive(NumberQueueTEMP, &t_deciC, pdMS_TO_TICKS(15)) == pdTRUE)
                {
                    LCD_PrintDeciC(0, (mode == both) ? 3 : 0, t_deciC);
+                   drawn = true;
                }
            }
            last_mode = mode;
 
-        /* Cede CPU; el frame se envía por el timer a ~30 FPS */
+        /* Frame terminado: lo envía la tarea de pantalla, con tope de FPS */
+        if (drawn)
+        {
+            DISP_FrameReady();
+        }
+
+        /* Cede CPU */
         taskYIELD();
     }
 }
@@ -429,19 +602,20 @@ static void LCDprint_thread(void *pvParameters)
 static void GraphProcess_thread(void *pvParameters)
 {
     (void)pvParameters;
-    adcConv_str m;
+    calSample_str m;
     uint16_t y;
 
     for (;;)
     {
         if (xQueueReceive(AdcConversionQueue, &m, portMAX_DELAY) == pdTRUE)
         {
+        	y = m.r.pixel;
         	if (m.convSource == heart) {
-        		y = (uint16_t)((m.data * 24U) / 4096U) + 24U; //de 24 a 27
+        		//de 24 a 47
 
         	    xQueueOverwrite(PointQueueHR, &y);
         	} else {
-        		 y = (uint16_t)((m.data * 24U) / 4096U); // de 0 a 24
+        		 // de 0 a 23
 
         	    xQueueOverwrite(PointQueueTEMP, &y);
         	}
@@ -453,7 +627,7 @@ static void NumberProcess_thread(void *pvParameters)
 {
     (void)pvParameters;
 
-    adcConv_str adcConvVal;
+    calSample_str adcConvVal;
     uint16_t outValue;
     uint8_t fault_now;
 
@@ -461,21 +635,23 @@ static void NumberProcess_thread(void *pvParameters)
     {
         if (xQueueReceive(AdcConversionQueue, &adcConvVal, portMAX_DELAY) == pdTRUE)
         {
-        	fault_now = 0;
+        	outValue  = adcConvVal.r.display;
+        	fault_now = adcConvVal.r.fault ? 1U : 0U;
         	if (adcConvVal.convSource == 0) {
-        	    outValue = (uint16_t)((adcConvVal.data * 300U) / 4095U);
         	    xQueueOverwrite(NumberQueueHR, &outValue);
-        	    if(outValue >= 285 || outValue <= 15){
-        	    	fault_now = 1;
-				}
+        	    last_hr_centimV = outValue;
+        	    taskENTER_CRITICAL();
+        	    if (outValue < summary.hr_min) summary.hr_min = outValue;
+        	    if (outValue > summary.hr_max) summary.hr_max = outValue;
+        	    taskEXIT_CRITICAL();
 
         	} else {
-        	    outValue = (uint16_t)(340U + ((adcConvVal.data * 60U) / 4095U));
-
         	    xQueueOverwrite(NumberQueueTEMP, &outValue);
-        	    if(outValue >= 370 || outValue <= 340){
-        	    	fault_now = 1;
-        	            	    }
+        	    last_t_deciC = outValue;
+        	    taskENTER_CRITICAL();
+        	    if (outValue < summary.t_min) summary.t_min = outValue;
+        	    if (outValue > summary.t_max) summary.t_max = outValue;
+        	    taskEXIT_CRITICAL();
 
         	}
 
@@ -518,15 +694,69 @@ static void AdcForwarder_task(void *pvParameters)
     (void)pvParameters;
 
     adcConv_str m;
+    calSample_str s;
     for (;;)
     {
         /* Leer del driver (ISR->cola interna del driver) */
         if (ADC_Receive(&m, portMAX_DELAY))
         {
+#if MONITOR_TELEMETRY
+            /* Cada muestra cruda, a la tasa del ADC */
+            (void)TELEM_Send((uint8_t)(TELEM_CH_ADC_RAW + m.convSource), TELEM_T_U16, &m.data, sizeof(m.data));
+#endif
+            /* Una sola pasada por muestra: display, pixel y alarma para las
+               dos tareas que la consumen */
+            if (!CAL_Convert(m.convSource, m.data, &s.r))
+            {
+                continue;
+            }
+            s.convSource = m.convSource;
             /* Reenviar a tu cola original, dos veces, como hacía tu ISR previa */
-            xQueueSend(AdcConversionQueue, &m, portMAX_DELAY);
+            xQueueSend(AdcConversionQueue, &s, portMAX_DELAY);
             taskYIELD();
-            xQueueSend(AdcConversionQueue, &m, portMAX_DELAY);
+            xQueueSend(AdcConversionQueue, &s, portMAX_DELAY);
+        }
+    }
+}
+
+/* =================== Log persistente =================== */
+/* Evento de alarma: guarda las últimas lecturas (HR, TEMP) */
+static void LogEvent(uint8_t type)
+{
+    uint16_t vals[2];
+
+    vals[0] = last_hr_centimV;
+    vals[1] = last_t_deciC;
+    (void)FLOG_Append(type, vals, sizeof(vals));
+}
+
+static void FlashLog_thread(void *pvParameters)
+{
+    (void)pvParameters;
+
+    TickType_t last_wake = xTaskGetTickCount();
+    uint32_t seconds = 0;
+    vitals_summary_t snap;
+
+    for (;;)
+    {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(1000));
+
+        if (++seconds >= FLOG_SUMMARY_PERIOD_S)
+        {
+            seconds = 0;
+            taskENTER_CRITICAL();
+            snap = summary;
+            summary = (vitals_summary_t){0xFFFF, 0, 0xFFFF, 0};
+            taskEXIT_CRITICAL();
+            (void)FLOG_Append(FLOG_TYPE_SUMMARY, &snap, sizeof(snap));
+        }
+
+        /* Programa en lote lo acumulado en el último segundo (prioridad baja:
+           el borrado de sector no retrasa a las tareas de muestreo) */
+        if (FLOG_Pending() != 0U)
+        {
+            (void)FLOG_Flush();
         }
     }
 }
@@ -0,0 +1,35 @@
+/*
+ * monitor_cal.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Calibración de los dos canales del monitor (índice = convSource). La usan
+ * main.c y las pruebas en la PC (host/), así que hay una sola copia.
+ * Con offset 0 y ganancia 1 reproduce las fórmulas originales: 0..300
+ * centésimas de mV y 340..400 décimas de °C; las alarmas son los rangos
+ * normales de cada señal.
+ */
+
+#ifndef MONITOR_CAL_H_
+#define MONITOR_CAL_H_
+
+#include <stddef.h>
+
+#include "calibration.h"
+#include "monitor_core.h"
+
+static const cal_config_t mon_cal_heart = {
+    .offset = 0, .gain = 1.0f, .full_scale = 4095U,
+    .unit_min = 0U, .unit_max = 300U, .pwl = NULL, .pwl_len = 0U,
+    .pix_base = MON_HALF_H, .pix_span = MON_HALF_H,
+    .alarm_low = 15U, .alarm_high = 285U,
+};
+static const cal_config_t mon_cal_temp = {
+    .offset = 0, .gain = 1.0f, .full_scale = 4095U,
+    .unit_min = 340U, .unit_max = 400U, .pwl = NULL, .pwl_len = 0U,
+    .pix_base = 0U, .pix_span = MON_HALF_H,
+    .alarm_low = 340U, .alarm_high = 370U,
+};
+
+#endif /* MONITOR_CAL_H_ */
@@ -0,0 +1,43 @@
+/*
+ * monitor_core.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "monitor_core.h"
+
+uint8_t MON_HeartRowForMode(uint16_t pixel, uint8_t mode)
+{
+    return (uint8_t)((mode != both) ? (pixel - MON_HALF_H) : pixel);
+}
+
+void MON_TraceReset(mon_trace_t *t)
+{
+    t->a = (point_str){0, 0};
+    t->b = (point_str){0, 0};
+}
+
+bool MON_TraceAdvance(mon_trace_t *t, uint8_t y, uint8_t x_increment)
+{
+    t->a   = t->b;
+    t->b.y = y;
+    if ((uint8_t)(t->b.x + x_increment) < MON_SCREEN_W)
+    {
+        t->b.x = (uint8_t)(t->b.x + x_increment);
+        return false;
+    }
+    t->b.x = 0;
+    return true;
+}
+
+uint8_t MON_NextMode(uint8_t mode)
+{
+    return (uint8_t)((mode + 1U) % MON_MODE_COUNT);
+}
+
+uint8_t MON_NextTimeScale(uint8_t x_increment)
+{
+    return (x_increment < MON_TIMESCALE_MAX) ? (uint8_t)(x_increment + MON_TIMESCALE_STEP)
+                                             : (uint8_t)MON_TIMESCALE_MIN;
+}
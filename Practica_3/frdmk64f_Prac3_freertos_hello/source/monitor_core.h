@@ -0,0 +1,61 @@
+/*
+ * monitor_core.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Lógica del monitor sin dependencias de FreeRTOS ni del SDK: geometría
+ * de las gráficas, avance del cursor y ciclos de los botones (la conversión
+ * ADC -> unidades/pixel/falla está en calibration). Solo usa <stdint.h>/<stdbool.h>, así que compila
+ * igual para la K64F que para una PC.
+ */
+
+#ifndef MONITOR_CORE_H_
+#define MONITOR_CORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ======= Constantes ======= */
+#define MON_SCREEN_W           84U
+#define MON_HALF_H             24U     /* cada gráfica ocupa media pantalla */
+
+/* Escalas de tiempo que recorre SW3 */
+#define MON_TIMESCALE_MIN      1U
+#define MON_TIMESCALE_STEP     5U
+#define MON_TIMESCALE_MAX      10U
+
+/* ======= Tipos ======= */
+typedef struct{
+    uint8_t x;
+    uint8_t y;
+} point_str;
+
+/* Pantalla actual (SW2) */
+enum {
+    heart = 0,
+    temp,
+    both,
+    MON_MODE_COUNT
+};
+
+/* Último segmento trazado de una gráfica */
+typedef struct{
+    point_str a;
+    point_str b;
+} mon_trace_t;
+
+/* ======= API ======= */
+/* HR se grafica en la mitad de abajo (24..47), TEMP arriba (0..23).
+   Si solo se muestra HR, su gráfica baja a la mitad superior */
+uint8_t MON_HeartRowForMode(uint16_t pixel, uint8_t mode);
+
+/* Cursor: mueve b -> a y avanza x; regresa true si dio la vuelta a la pantalla */
+void MON_TraceReset(mon_trace_t *t);
+bool MON_TraceAdvance(mon_trace_t *t, uint8_t y, uint8_t x_increment);
+
+/* Ciclos de los botones */
+uint8_t MON_NextMode(uint8_t mode);            /* heart -> temp -> both -> heart */
+uint8_t MON_NextTimeScale(uint8_t x_increment); /* 1 -> 6 -> 11 -> 1 */
+
+#endif /* MONITOR_CORE_H_ */
@@ -0,0 +1,52 @@
+/*
+ * numfmt.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "numfmt.h"
+
+/* v / 10 exacto para todo uint16_t: 0xCCCD / 2^19 ~= 1/10 (sin UDIV) */
+#define NFMT_DIV10(v)   ((uint16_t)(((uint32_t)(v) * 0xCCCDU) >> 19))
+
+uint8_t NFMT_ToBCD(uint16_t v, uint8_t bcd[NFMT_MAX_DIGITS])
+{
+    uint8_t  i, n = 1U;
+    uint16_t q;
+
+    for (i = 0; i < NFMT_MAX_DIGITS; i++)
+    {
+        q      = NFMT_DIV10(v);
+        bcd[i] = (uint8_t)(v - (uint16_t)(q * 10U));
+        v      = q;
+        if (bcd[i] != 0U) n = (uint8_t)(i + 1U);
+    }
+    return n;
+}
+
+uint8_t NFMT_Template(char *out, const char *tmpl, uint16_t v)
+{
+    uint8_t bcd[NFMT_MAX_DIGITS];
+    uint8_t len = 0U, d = 0U;
+    int16_t i;
+
+    (void)NFMT_ToBCD(v, bcd);
+
+    while (tmpl[len] != '\0') { len++; }
+    out[len] = '\0';
+
+    for (i = (int16_t)len - 1; i >= 0; i--)
+    {
+        if (tmpl[i] == NFMT_DIGIT)
+        {
+            out[i] = (char)('0' + ((d < NFMT_MAX_DIGITS) ? bcd[d] : 0U));
+            d++;
+        }
+        else
+        {
+            out[i] = tmpl[i];
+        }
+    }
+    return len;
+}
@@ -0,0 +1,31 @@
+/*
+ * numfmt.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Formato numérico de ancho fijo para las lecturas del LCD, sin divisiones
+ * ni el formateador de fsl_str. Solo usa <stdint.h>.
+ */
+
+#ifndef NUMFMT_H_
+#define NUMFMT_H_
+
+#include <stdint.h>
+
+/* ======= Configuración ======= */
+#define NFMT_MAX_DIGITS     5U      /* uint16_t: 0..65535 */
+#define NFMT_DIGIT          '#'     /* marcador de dígito en las plantillas */
+
+/* ======= API ======= */
+/* Dígitos decimales de v, del menos al más significativo (BCD sin dividir);
+   regresa cuántos son significativos (al menos 1) */
+uint8_t NFMT_ToBCD(uint16_t v, uint8_t bcd[NFMT_MAX_DIGITS]);
+
+/* Copia la plantilla a out cambiando cada '#' por un dígito de v, de derecha
+   a izquierda (ceros a la izquierda; los dígitos que no caben se pierden,
+   como con % 10^n). Ej.: ("##.# C", 365) -> "36.5 C". Regresa la longitud,
+   sin el '\0' que también escribe. */
+uint8_t NFMT_Template(char *out, const char *tmpl, uint16_t v);
+
+#endif /* NUMFMT_H_ */
@@ -0,0 +1,32 @@
+/*
+ * rtos_static.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "rtos_static.h"
+#include "task.h"
+
+/* Pilas de las tareas del kernel (Idle y Tmr Svc) */
+RTOS_STATIC_TASK(idle, configMINIMAL_STACK_SIZE);
+RTOS_STATIC_TASK(timer_svc, configTIMER_TASK_STACK_DEPTH);
+
+/* Requeridas por el kernel con configSUPPORT_STATIC_ALLOCATION = 1 */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    *ppxIdleTaskTCBBuffer   = &idle_tcb;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *pulIdleTaskStackSize   = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+                                    StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    *ppxTimerTaskTCBBuffer   = &timer_svc_tcb;
+    *ppxTimerTaskStackBuffer = timer_svc_stack;
+    *pulTimerTaskStackSize   = configTIMER_TASK_STACK_DEPTH;
+}
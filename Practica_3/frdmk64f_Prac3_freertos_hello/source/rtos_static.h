@@ -0,0 +1,39 @@
+/*
+ * rtos_static.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef RTOS_STATIC_H_
+#define RTOS_STATIC_H_
+
+#include "FreeRTOS.h"
+
+/* Todo objeto de FreeRTOS se crea con ...CreateStatic() sobre memoria
+   reservada en compilación (configSUPPORT_DYNAMIC_ALLOCATION = 0, sin heap).
+   Las reservas van a la sección .bss.rtos_static: en el .map aparecen juntas,
+   con el tamaño de cada una, y -print-memory-usage ya las incluye en RAM. */
+#define RTOS_STATIC             __attribute__((section(".bss.rtos_static"), aligned(8)))
+
+/* Tareas del sistema: idle + timers (rtos_static.c), Stats, Buttons,
+   DispFlush, TelemFlush (con MONITOR_TELEMETRY) y las 6 de main.c.
+   Actualizar al agregar un RTOS_STATIC_TASK: rtos_stats.h dimensiona su
+   tabla con este número */
+#define RTOS_TASK_COUNT         12U
+
+/* Pila + TCB de una tarea: name_stack[], name_tcb */
+#define RTOS_STATIC_TASK(name, depth)                              \
+    static StackType_t  name##_stack[(depth)] RTOS_STATIC;         \
+    static StaticTask_t name##_tcb RTOS_STATIC
+
+/* Almacenamiento + estructura de una cola: name_storage[], name_qcb */
+#define RTOS_STATIC_QUEUE(name, length, item_size)                          \
+    static uint8_t       name##_storage[(length) * (item_size)] RTOS_STATIC; \
+    static StaticQueue_t name##_qcb RTOS_STATIC
+
+/* Estructura de un timer: name_tcb */
+#define RTOS_STATIC_TIMER(name)                                    \
+    static StaticTimer_t name##_tcb RTOS_STATIC
+
+#endif /* RTOS_STATIC_H_ */
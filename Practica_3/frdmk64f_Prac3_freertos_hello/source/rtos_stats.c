@@ -0,0 +1,278 @@
+/*
+ * rtos_stats.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Estadísticas de ejecución: % de CPU por tarea (reloj = DWT->CYCCNT, un ciclo
+ * de core por cuenta), stack mínimo libre y nivel máximo de las colas
+ * registradas. Se envían como trama binaria compacta por la UART de debug.
+ */
+
+#include "rtos_stats.h"
+#include "crc16.h"
+
+#include "task.h"
+#include "fsl_device_registers.h"
+
+#include "low_power.h"
+#include "rtos_static.h"
+#include "console.h"
+
+/* La trama de nombres es la más grande: n x (número + nombre + '\0') */
+_Static_assert((STATS_MAX_TASKS * (1U + STATS_NAME_MAX)) <= 255U,
+               "STATS_FRAME_NAMES no cabe en una trama con STATS_MAX_TASKS tareas");
+_Static_assert((2U + (STATS_MAX_TASKS * 5U) + (STATS_MAX_QUEUES * 3U)) <= 255U,
+               "STATS_FRAME_TASKS no cabe en una trama");
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    QueueHandle_t    q;
+    uint8_t          length;
+    volatile uint8_t hwm;
+} stats_queue_t;
+
+typedef struct
+{
+    UBaseType_t task_num;
+    uint32_t    runtime;       /* ulRunTimeCounter del periodo anterior */
+} stats_prev_t;
+
+typedef struct
+{
+    uint32_t      period_ms;
+    uint8_t       n_queues;
+    stats_queue_t queues[STATS_MAX_QUEUES];
+    UBaseType_t   n_prev;
+    stats_prev_t  prev[STATS_MAX_TASKS];
+    uint32_t      prev_total;
+    TickType_t    prev_tick;
+    uint32_t      prev_asleep_ms;
+    TaskStatus_t  status[STATS_MAX_TASKS];
+    uint8_t       frame[4 + 255 + 2];
+} stats_ctx_t;
+
+static stats_ctx_t s_stats;
+RTOS_STATIC_TASK(stats, STATS_TASK_STACK);
+
+/* ======= Prototipos locales ======= */
+static void prv_stats_task(void *pvParameters);
+static uint32_t prv_prev_runtime(UBaseType_t task_num);
+static uint8_t *prv_put_queues(uint8_t *p);
+static void prv_send_frame(uint8_t type, uint8_t len);
+static void prv_send_names(UBaseType_t n);
+static void prv_send_power(void);
+
+/* ======= Implementación ======= */
+bool STATS_Init(uint32_t period_ms)
+{
+    if (period_ms == 0u) return false;
+    s_stats.period_ms = period_ms;
+
+    return (xTaskCreateStatic(prv_stats_task, "Stats", STATS_TASK_STACK, NULL,
+                              STATS_TASK_PRIORITY, stats_stack, &stats_tcb) != NULL);
+}
+
+bool STATS_RegisterQueue(QueueHandle_t q)
+{
+    stats_queue_t *e;
+
+    if (!q || s_stats.n_queues >= STATS_MAX_QUEUES) return false;
+
+    e = &s_stats.queues[s_stats.n_queues];
+    e->q      = q;
+    e->length = (uint8_t)(uxQueueMessagesWaiting(q) + uxQueueSpacesAvailable(q));
+    e->hwm    = (uint8_t)uxQueueMessagesWaiting(q);
+
+    /* El número de cola (1..N) es el índice que usa el hook del kernel */
+    s_stats.n_queues++;
+    vQueueSetQueueNumber(q, s_stats.n_queues);
+    return true;
+}
+
+void STATS_EnableCycleCounter(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/* Llamado por el kernel desde traceQUEUE_SEND(_FROM_ISR), dentro de su sección
+   crítica y antes de copiar el elemento: el nivel nuevo es waiting + 1 */
+void STATS_TraceQueueSend(void *pxQueue)
+{
+    UBaseType_t    num = uxQueueGetQueueNumber((QueueHandle_t)pxQueue);
+    stats_queue_t *e;
+    UBaseType_t    level;
+
+    if (num == 0u || num > s_stats.n_queues) return;
+
+    e = &s_stats.queues[num - 1u];
+    level = uxQueueMessagesWaitingFromISR((QueueHandle_t)pxQueue) + 1u;
+    if (level > e->length) level = e->length;   /* xQueueOverwrite en buzón lleno */
+    if (level > e->hwm)    e->hwm = (uint8_t)level;
+}
+
+/* ======= Estáticos locales ======= */
+static void prv_stats_task(void *pvParameters)
+{
+    (void)pvParameters;
+
+    TickType_t  last_wake = xTaskGetTickCount();
+    UBaseType_t last_n = 0;
+
+    for (;;)
+    {
+        uint32_t    total, d_total;
+        UBaseType_t n, i;
+        uint8_t    *p;
+
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(s_stats.period_ms));
+
+        n = uxTaskGetSystemState(s_stats.status, STATS_MAX_TASKS, &total);
+        p = &s_stats.frame[4];
+        if (n == 0u)
+        {
+            /* Más tareas que STATS_MAX_TASKS: se avisa en la trama y las
+               colas se reportan igual */
+            *p++ = STATS_TASKS_OVERFLOW;
+            *p++ = (uint8_t)uxTaskGetNumberOfTasks();
+            p = prv_put_queues(p);
+            prv_send_frame(STATS_FRAME_TASKS, (uint8_t)(p - &s_stats.frame[4]));
+            prv_send_power();
+            continue;
+        }
+
+        if (n != last_n)
+        {
+            prv_send_names(n);
+            last_n = n;
+        }
+
+        /* Resta sin signo: correcta aunque CYCCNT haya dado la vuelta */
+        d_total = total - s_stats.prev_total;
+        s_stats.prev_total = total;
+        if (d_total == 0u) d_total = 1u;
+
+        p = &s_stats.frame[4];     /* prv_send_names() usó el mismo buffer */
+        *p++ = (uint8_t)n;
+        for (i = 0; i < n; i++)
+        {
+            const TaskStatus_t *ts = &s_stats.status[i];
+            uint32_t d    = ts->ulRunTimeCounter - prv_prev_runtime(ts->xTaskNumber);
+            uint16_t cpu  = (uint16_t)(((uint64_t)d * 10000u) / d_total);
+            uint16_t hwm  = (uint16_t)ts->usStackHighWaterMark;
+
+            *p++ = (uint8_t)ts->xTaskNumber;
+            *p++ = (uint8_t)(cpu & 0xFFu);
+            *p++ = (uint8_t)(cpu >> 8);
+            *p++ = (uint8_t)(hwm & 0xFFu);
+            *p++ = (uint8_t)(hwm >> 8);
+        }
+
+        /* Guarda los contadores para el siguiente periodo */
+        for (i = 0; i < n; i++)
+        {
+            s_stats.prev[i].task_num = s_stats.status[i].xTaskNumber;
+            s_stats.prev[i].runtime  = s_stats.status[i].ulRunTimeCounter;
+        }
+        s_stats.n_prev = n;
+
+        p = prv_put_queues(p);
+
+        prv_send_frame(STATS_FRAME_TASKS, (uint8_t)(p - &s_stats.frame[4]));
+        prv_send_power();
+    }
+}
+
+static uint8_t *prv_put_queues(uint8_t *p)
+{
+    uint8_t i;
+
+    *p++ = s_stats.n_queues;
+    for (i = 0; i < s_stats.n_queues; i++)
+    {
+        *p++ = (uint8_t)(i + 1u);
+        *p++ = s_stats.queues[i].hwm;
+        *p++ = s_stats.queues[i].length;
+    }
+    return p;
+}
+
+static uint32_t prv_prev_runtime(UBaseType_t task_num)
+{
+    UBaseType_t i;
+    for (i = 0; i < s_stats.n_prev; i++)
+    {
+        if (s_stats.prev[i].task_num == task_num) return s_stats.prev[i].runtime;
+    }
+    return 0;   /* tarea nueva: todo su tiempo cae en este periodo */
+}
+
+static void prv_send_names(UBaseType_t n)
+{
+    UBaseType_t i;
+    uint8_t    *p = &s_stats.frame[4];
+
+    for (i = 0; i < n; i++)
+    {
+        const char *name = s_stats.status[i].pcTaskName;
+        uint8_t     k;
+
+        *p++ = (uint8_t)s_stats.status[i].xTaskNumber;
+        for (k = 0; k < (STATS_NAME_MAX - 1U) && (k < (configMAX_TASK_NAME_LEN - 1)) && name[k] != '\0'; k++)
+        {
+            *p++ = (uint8_t)name[k];
+        }
+        *p++ = '\0';
+    }
+    prv_send_frame(STATS_FRAME_NAMES, (uint8_t)(p - &s_stats.frame[4]));
+}
+
+/* % del periodo dormido, medido contra el tick (que sí avanza al dormir) */
+static void prv_send_power(void)
+{
+    lp_stats_t lp;
+    TickType_t now = xTaskGetTickCount();
+    uint32_t   d_ms, d_sleep;
+    uint16_t   pct;
+    uint8_t   *p = &s_stats.frame[4];
+
+    LP_GetStats(&lp);
+    d_ms    = (uint32_t)(now - s_stats.prev_tick) * portTICK_PERIOD_MS;
+    d_sleep = lp.asleep_ms - s_stats.prev_asleep_ms;
+    s_stats.prev_tick      = now;
+    s_stats.prev_asleep_ms = lp.asleep_ms;
+
+    pct = (d_ms != 0u) ? (uint16_t)(((uint64_t)d_sleep * 10000u) / d_ms) : 0u;
+    if (pct > 10000u) pct = 10000u;
+
+    *p++ = (uint8_t)(pct & 0xFFu);
+    *p++ = (uint8_t)(pct >> 8);
+    *p++ = (uint8_t)(lp.wakeups);
+    *p++ = (uint8_t)(lp.wakeups >> 8);
+    *p++ = (uint8_t)(lp.wakeups >> 16);
+    *p++ = (uint8_t)(lp.wakeups >> 24);
+    *p++ = (uint8_t)(lp.vlps_entries);
+    *p++ = (uint8_t)(lp.vlps_entries >> 8);
+    *p++ = (uint8_t)(lp.vlps_entries >> 16);
+    *p++ = (uint8_t)(lp.vlps_entries >> 24);
+    prv_send_frame(STATS_FRAME_POWER, (uint8_t)(p - &s_stats.frame[4]));
+}
+
+/* frame[4..4+len) ya tiene el payload; completa encabezado y CRC y envía */
+static void prv_send_frame(uint8_t type, uint8_t len)
+{
+    uint16_t crc;
+
+    s_stats.frame[0] = STATS_SYNC0;
+    s_stats.frame[1] = STATS_SYNC1;
+    s_stats.frame[2] = type;
+    s_stats.frame[3] = len;
+    crc = CRC16_Compute(&s_stats.frame[2], (uint32_t)len + 2u);
+    s_stats.frame[4 + len] = (uint8_t)(crc & 0xFFu);
+    s_stats.frame[5 + len] = (uint8_t)(crc >> 8);
+
+    CONSOLE_Write(s_stats.frame, (size_t)len + 6u);
+}
@@ -0,0 +1,61 @@
+/*
+ * rtos_stats.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef RTOS_STATS_H_
+#define RTOS_STATS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* FreeRTOS */
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "rtos_static.h"
+
+/* ======= Configuración ======= */
+#define STATS_MAX_TASKS         (RTOS_TASK_COUNT + 1U)   /* una de holgura */
+#define STATS_MAX_QUEUES        10U
+#define STATS_NAME_MAX          16U     /* bytes por nombre en STATS_FRAME_NAMES, con el '\0' */
+#define STATS_TASK_PRIORITY     (tskIDLE_PRIORITY + 1)
+#define STATS_TASK_STACK        (configMINIMAL_STACK_SIZE + 100)
+
+/* ======= Trama binaria por la UART de debug =======
+ *  [0xA5][0x5A][tipo][len][payload: len bytes][crc16 lo][crc16 hi]
+ *  El CRC16 (CCITT) cubre tipo, len y payload.
+ *
+ *  STATS_FRAME_TASKS  payload:
+ *      u8 n_tasks, n x { u8 task_num, u16 cpu_centipct, u16 stack_hwm_words }
+ *      u8 n_queues, n x { u8 queue_num, u8 hwm, u8 length }
+ *    Si hay más tareas que STATS_MAX_TASKS, n_tasks = STATS_TASKS_OVERFLOW
+ *    seguido de u8 tareas existentes, y sin tareas (las colas sí van).
+ *  STATS_FRAME_NAMES  payload (al inicio y cuando cambia el número de tareas):
+ *      n x { u8 task_num, nombre de hasta STATS_NAME_MAX - 1 chars terminado en '\0' }
+ *  STATS_FRAME_POWER  payload:
+ *      u16 asleep_centipct (del periodo), u32 wakeups, u32 vlps_entries (acumulados)
+ *
+ *  Nota: DWT->CYCCNT se detiene en STOP/VLPS, así que el % de CPU es relativo
+ *  al tiempo despierto; el tiempo dormido lo reporta STATS_FRAME_POWER.
+ */
+#define STATS_SYNC0             0xA5U
+#define STATS_SYNC1             0x5AU
+#define STATS_FRAME_TASKS       0x01U
+#define STATS_FRAME_NAMES       0x02U
+#define STATS_FRAME_POWER       0x03U
+#define STATS_TASKS_OVERFLOW    0xFFU
+
+/* ======= API ======= */
+/* Crea la tarea de estadísticas con el periodo dado (< 35 s: CYCCNT de 32 bits) */
+bool STATS_Init(uint32_t period_ms);
+/* Agrega la cola al seguimiento de nivel máximo; usar antes de arrancar el scheduler */
+bool STATS_RegisterQueue(QueueHandle_t q);
+
+/* Hooks de FreeRTOSConfig.h (no llamar directamente) */
+void STATS_EnableCycleCounter(void);
+void STATS_TraceQueueSend(void *pxQueue);
+
+#endif /* RTOS_STATS_H_ */
@@ -0,0 +1,217 @@
+/*
+ * telemetry.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include <stddef.h>
+
+#include "telemetry.h"
+#include "crc16.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rtos_static.h"
+#include "console.h"
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    SemaphoreHandle_t hLock;
+    TaskHandle_t      hTask;
+    uint8_t           buf[TELEM_TX_BUFFER];
+    uint16_t          len;
+    uint8_t           seq[TELEM_CHANNELS_MAX];
+    uint32_t          sent;
+    uint32_t          dropped;
+} telem_ctx_t;
+
+static telem_ctx_t s_tel;
+
+static StaticSemaphore_t tel_lock_buf RTOS_STATIC;
+RTOS_STATIC_TASK(tel, TELEM_TASK_STACK);
+
+/* ======= Prototipos locales ======= */
+static void prv_Emit(telem_enc_t *e, uint8_t b);
+static void prv_Flush(void);
+static void prv_task(void *pvParameters);
+
+/* ======= Codificador ======= */
+/* Un byte ya con COBS: los ceros cierran el bloque en curso, igual que un
+   bloque que llega a 254 bytes */
+static void prv_Emit(telem_enc_t *e, uint8_t b)
+{
+    if (e->pos >= e->cap)
+    {
+        e->overflow = true;
+        return;
+    }
+    if (b != 0U)
+    {
+        e->out[e->pos++] = b;
+        e->code++;
+    }
+    if ((b == 0U) || (e->code == 0xFFU))
+    {
+        e->out[e->code_pos] = e->code;
+        e->code_pos = e->pos;
+        e->code     = 1U;
+        if (e->pos < e->cap)
+        {
+            e->pos++;            /* lugar del siguiente código */
+        }
+        else
+        {
+            e->overflow = true;
+        }
+    }
+}
+
+void TELEM_EncBegin(telem_enc_t *e, uint8_t *out, uint16_t cap)
+{
+    e->out      = out;
+    e->cap      = cap;
+    e->pos      = 1U;
+    e->code_pos = 0U;
+    e->code     = 1U;
+    e->crc      = CRC16_INIT;
+    e->overflow = (cap < 2U);
+}
+
+void TELEM_EncPut(telem_enc_t *e, const void *data, uint16_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    e->crc = CRC16_Update(e->crc, p, len);
+    while (len--)
+    {
+        prv_Emit(e, *p++);
+    }
+}
+
+uint16_t TELEM_EncEnd(telem_enc_t *e)
+{
+    uint16_t crc = e->crc;
+
+    prv_Emit(e, (uint8_t)(crc & 0xFFU));
+    prv_Emit(e, (uint8_t)(crc >> 8));
+    if (e->overflow || (e->pos >= e->cap))
+    {
+        return 0U;
+    }
+    e->out[e->code_pos] = e->code;
+    e->out[e->pos++]    = 0x00U;       /* delimitador */
+    return e->pos;
+}
+
+/* ======= Envío por lotes ======= */
+bool TELEM_Init(void)
+{
+    s_tel.len     = 0U;
+    s_tel.sent    = 0U;
+    s_tel.dropped = 0U;
+    s_tel.hLock   = xSemaphoreCreateMutexStatic(&tel_lock_buf);
+    if (s_tel.hLock == NULL)
+    {
+        return false;
+    }
+    s_tel.hTask = xTaskCreateStatic(prv_task, "TelemFlush", TELEM_TASK_STACK, NULL,
+                                    TELEM_TASK_PRIORITY, tel_stack, &tel_tcb);
+    return (s_tel.hTask != NULL);
+}
+
+/* Lote incompleto: sale TELEM_FLUSH_MS después de su primera trama, sin
+   depender del ritmo de quien envía ni bloquear a nadie en la UART */
+static void prv_task(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        vTaskDelay(pdMS_TO_TICKS(TELEM_FLUSH_MS));
+        TELEM_Flush();
+    }
+}
+
+/* Con el mutex tomado */
+static void prv_Flush(void)
+{
+    if (s_tel.len != 0U)
+    {
+        CONSOLE_Write(s_tel.buf, s_tel.len);
+        s_tel.len = 0U;
+    }
+}
+
+bool TELEM_Send(uint8_t channel, telem_type_t type, const void *payload, uint8_t len)
+{
+    telem_enc_t e;
+    uint8_t hdr[3];
+    uint16_t n;
+
+    if ((channel >= TELEM_CHANNELS_MAX) || (len > TELEM_PAYLOAD_MAX) || (s_tel.hLock == NULL))
+    {
+        s_tel.dropped++;
+        return false;
+    }
+
+    (void)xSemaphoreTake(s_tel.hLock, portMAX_DELAY);
+    if ((TELEM_TX_BUFFER - s_tel.len) < TELEM_FRAME_MAX(len))
+    {
+        prv_Flush();
+    }
+
+    /* Directo al buffer de TX, detrás de las tramas ya codificadas */
+    hdr[0] = channel;
+    hdr[1] = (uint8_t)type;
+    hdr[2] = s_tel.seq[channel];
+    TELEM_EncBegin(&e, &s_tel.buf[s_tel.len], (uint16_t)(TELEM_TX_BUFFER - s_tel.len));
+    TELEM_EncPut(&e, hdr, sizeof(hdr));
+    TELEM_EncPut(&e, payload, len);
+    n = TELEM_EncEnd(&e);
+    if (n == 0U)
+    {
+        /* No cupo: el buffer queda como estaba y seq no avanza (lo que
+           quedó escrito detrás de len se sobrescribe con la siguiente) */
+        s_tel.dropped++;
+        xSemaphoreGive(s_tel.hLock);
+        return false;
+    }
+
+    if ((s_tel.len == 0U) && (s_tel.hTask != NULL))
+    {
+        (void)xTaskNotifyGive(s_tel.hTask);     /* primera trama del lote */
+    }
+    s_tel.len += n;
+    s_tel.seq[channel]++;
+    s_tel.sent++;
+    if (s_tel.len >= TELEM_FLUSH_BYTES)
+    {
+        prv_Flush();
+    }
+    xSemaphoreGive(s_tel.hLock);
+    return true;
+}
+
+void TELEM_Flush(void)
+{
+    if (s_tel.hLock == NULL)
+    {
+        return;
+    }
+    (void)xSemaphoreTake(s_tel.hLock, portMAX_DELAY);
+    prv_Flush();
+    xSemaphoreGive(s_tel.hLock);
+}
+
+uint32_t TELEM_GetSentCount(void)
+{
+    return s_tel.sent;
+}
+
+uint32_t TELEM_GetDroppedCount(void)
+{
+    return s_tel.dropped;
+}
@@ -0,0 +1,83 @@
+/*
+ * telemetry.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Telemetría binaria por la UART de debug. Cada trama es
+ *
+ *     COBS( canal | tipo | seq | payload... | crc16 LE ) 0x00
+ *
+ * con el CRC-16/CCITT-FALSE de crc16.h sobre canal..payload y seq por canal
+ * (un salto en seq = tramas perdidas). 0x00 solo aparece como delimitador,
+ * así que el receptor se resincroniza en la siguiente trama aunque se pierdan
+ * bytes o se cuele texto de PRINTF (esa trama simplemente falla el CRC).
+ *
+ * Las tramas se codifican directo en el buffer de TX, byte por byte, sin
+ * copia intermedia, y se envían por lotes.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* FreeRTOS */
+#include "FreeRTOS.h"
+
+/* ======= Configuración ======= */
+#define TELEM_CHANNELS_MAX     16U
+#define TELEM_PAYLOAD_MAX      32U
+#define TELEM_TX_BUFFER        256U
+#define TELEM_FLUSH_BYTES      128U     /* el lote sale al llegar aquí (o con TELEM_Flush) */
+#define TELEM_FLUSH_MS         20U      /* ...o a más tardar este tiempo después de su primera trama */
+#define TELEM_TASK_PRIORITY    (tskIDLE_PRIORITY + 1)
+#define TELEM_TASK_STACK       (configMINIMAL_STACK_SIZE + 60)
+
+/* Peor caso de una trama: cabecera 3 + CRC 2, un byte de código COBS por
+   cada 254 y el delimitador */
+#define TELEM_FRAME_MAX(n)     ((n) + 5U + (((n) + 5U) / 254U) + 2U)
+
+/* ======= Tipos ======= */
+/* Tipo de cada elemento del payload (little endian), para el decodificador */
+typedef enum
+{
+    TELEM_T_U8 = 0,
+    TELEM_T_U16,
+    TELEM_T_I16,
+    TELEM_T_U32,
+    TELEM_T_I32,
+    TELEM_T_F32,
+    TELEM_T_TEXT
+} telem_type_t;
+
+/* Codificador COBS incremental sobre un buffer del llamador */
+typedef struct
+{
+    uint8_t  *out;
+    uint16_t cap;
+    uint16_t pos;        /* siguiente byte a escribir */
+    uint16_t code_pos;   /* dónde va el código del bloque en curso */
+    uint8_t  code;       /* 1 + bytes no cero del bloque en curso */
+    uint16_t crc;
+    bool     overflow;
+} telem_enc_t;
+
+/* ======= API ======= */
+/* Codificador (sin FreeRTOS): Begin, Put las veces que haga falta, End.
+   End agrega CRC y delimitador y regresa el largo de la trama (0 si no cupo) */
+void     TELEM_EncBegin(telem_enc_t *e, uint8_t *out, uint16_t cap);
+void     TELEM_EncPut(telem_enc_t *e, const void *data, uint16_t len);
+uint16_t TELEM_EncEnd(telem_enc_t *e);
+
+/* Envío por lotes, seguro entre tareas. Init crea la tarea que saca el
+   lote incompleto TELEM_FLUSH_MS después de su primera trama */
+bool     TELEM_Init(void);
+bool     TELEM_Send(uint8_t channel, telem_type_t type, const void *payload, uint8_t len);
+void     TELEM_Flush(void);
+/* Tramas enviadas y rechazadas (canal o payload fuera de rango, o no cupo) */
+uint32_t TELEM_GetSentCount(void);
+uint32_t TELEM_GetDroppedCount(void);
+
+#endif /* TELEMETRY_H_ */
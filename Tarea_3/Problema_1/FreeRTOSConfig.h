@@ -79,7 +79,7 @@
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+#define configGENERATE_RUN_TIME_STATS           1
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
@@ -109,7 +109,7 @@
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
 #define INCLUDE_uxTaskGetStackHighWaterMark     0
-#define INCLUDE_xTaskGetIdleTaskHandle          0
+#define INCLUDE_xTaskGetIdleTaskHandle          1
 #define INCLUDE_eTaskGetState                   0
 #define INCLUDE_xTimerPendFunctionCall          1
 #define INCLUDE_xTaskAbortDelay                 0
@@ -122,6 +122,16 @@
     /* Clock manager provides in this variable system core clock frequency */
     #include <stdint.h>
     extern uint32_t SystemCoreClock;
+
+    /* Run time stats: reloj = DWT->CYCCNT (ciclos de core); la prueba de la
+       UART saca el % de CPU con ulTaskGetIdleRunTimeCounter() */
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()                                          \
+        do                                                                                    \
+        {                                                                                     \
+            (*(volatile uint32_t *)0xE000EDFCUL) |= (1UL << 24); /* DEMCR.TRCENA */          \
+            (*(volatile uint32_t *)0xE0001000UL) |= 1UL;         /* DWT->CTRL.CYCCNTENA */   \
+        } while (0)
+    #define portGET_RUN_TIME_COUNTER_VALUE()        (*(volatile uint32_t *)0xE0001004UL) /* DWT->CYCCNT */
 #endif
 
 /* Interrupt nesting behaviour configuration. Cortex-M specific. */
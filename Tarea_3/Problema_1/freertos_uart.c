@@ -20,22 +20,43 @@
 #include "clock_config.h"
 #include "board.h"
 
-#include "fsl_uart.h"
+#include <stdlib.h>
+#include <string.h>
 
-#define DEMO_UART UART0
-#define DEMO_UART_CLKSRC UART0_CLK_SRC
-#define DEMO_UART_CLK_FREQ CLOCK_GetFreq(UART0_CLK_SRC)
-#define DEMO_UART_RX_TX_IRQn UART0_RX_TX_IRQn
-#define DEMO_UART_IRQHandler UART0_RX_TX_IRQHandler
+#include "uart_stream.h"
+#include "shell.h"
 
 #define uart_task_PRIORITY (configMAX_PRIORITIES - 1)
 
-SemaphoreHandle_t uartSemaphore;
-volatile uint8_t receivedChar;
+#define UART_BAUDRATE 115200U
+#define UART_RX_TRIGGER 32U                  /* el idle despierta antes en ráfagas cortas */
+
+/* 1: en lugar del shell, prueba de pérdida/throughput en loopback interno a 115200, 921600 y 1000000 */
+#ifndef UART_RX_SELFTEST
+#define UART_RX_SELFTEST 0
+#endif
+#define SELFTEST_BYTES 8192U
 
 /* Prototipos */
+#if !UART_RX_SELFTEST
+static int cmd_stats(int argc, char *argv[]);
+static int cmd_baud(int argc, char *argv[]);
+static int cmd_uptime(int argc, char *argv[]);
+static int cmd_heap(int argc, char *argv[]);
+#else
 static void uart_echo_task(void *pvParameters);
-void UART_InitCustom(void);
+static void uart_selftest_task(void *pvParameters);
+#endif
+
+#if !UART_RX_SELFTEST
+/* Comandos del shell, en flash */
+static const shell_cmd_t shell_cmds[] = {
+    {"stats",  "contadores de la UART ('stats reset' los limpia)", cmd_stats},
+    {"baud",   "baud <bps>: cambia el baud rate",                  cmd_baud},
+    {"uptime", "tiempo desde el arranque",                         cmd_uptime},
+    {"heap",   "heap libre de FreeRTOS",                           cmd_heap},
+};
+#endif
 
 /* MAIN */
 int main(void)
@@ -44,15 +65,19 @@ int main(void)
     BOARD_InitBootClocks();
     BOARD_InitDebugConsole();
 
-    uartSemaphore = xSemaphoreCreateBinary();
-    if (uartSemaphore == NULL)
+    if (!USTREAM_Init(&(ustream_config_t){.baudrate = UART_BAUDRATE, .rx_trigger = UART_RX_TRIGGER}))
     {
-        PRINTF("Error al crear semáforo!\r\n");
+        PRINTF("Error al iniciar UART!\r\n");
         while (1);
     }
 
-    UART_InitCustom();
-
+#if !UART_RX_SELFTEST
+    if (!SHELL_Init(shell_cmds, sizeof(shell_cmds) / sizeof(shell_cmds[0]), uart_task_PRIORITY))
+    {
+        PRINTF("Error al crear tarea!\r\n");
+        while (1);
+    }
+#else
     if (xTaskCreate(uart_echo_task, "UART_ECHO", configMINIMAL_STACK_SIZE + 100, NULL,
                     uart_task_PRIORITY, NULL) != pdPASS)
     {
@@ -60,47 +85,146 @@ int main(void)
         while (1);
     }
 
+    /* DWT->CYCCNT lo enciende el kernel (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS) */
+    if (xTaskCreate(uart_selftest_task, "UART_TEST", configMINIMAL_STACK_SIZE + 100, NULL,
+                    uart_task_PRIORITY - 1, NULL) != pdPASS)
+    {
+        PRINTF("Error al crear tarea!\r\n");
+        while (1);
+    }
+#endif
+
     vTaskStartScheduler();
     while (1);
 }
 
-/* Inicialización UART sin RTOS wrapper */
-void UART_InitCustom(void)
+#if !UART_RX_SELFTEST
+static int cmd_stats(int argc, char *argv[])
 {
-    uart_config_t config;
-    UART_GetDefaultConfig(&config);
-    config.baudRate_Bps = 115200;
-    config.enableTx = true;
-    config.enableRx = true;
-
-    UART_Init(DEMO_UART, &config, DEMO_UART_CLK_FREQ);
-    UART_EnableInterrupts(DEMO_UART, kUART_RxDataRegFullInterruptEnable);
-    EnableIRQ(DEMO_UART_RX_TX_IRQn);
+    ustream_stats_t st;
+
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0))
+    {
+        USTREAM_ResetStats();
+        return 0;
+    }
+    USTREAM_GetStats(&st);
+    SHELL_Printf("rx %u (perdidos %u, overrun %u), tx %u en %u bloques DMA\r\n", st.rx_bytes, st.rx_dropped,
+                 st.rx_overruns, st.tx_bytes, st.tx_dma_blocks);
+    return 0;
 }
 
-/* ISR de UART */
-void DEMO_UART_IRQHandler(void)
+static int cmd_baud(int argc, char *argv[])
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t baud;
 
-    if (UART_GetStatusFlags(DEMO_UART) & kUART_RxDataRegFullFlag)
+    if (argc != 2)
     {
-        receivedChar = UART_ReadByte(DEMO_UART);
-        xSemaphoreGiveFromISR(uartSemaphore, &xHigherPriorityTaskWoken);
-        UART_ClearStatusFlags(DEMO_UART, kUART_RxDataRegFullFlag);
+        SHELL_Printf("uso: baud <bps>\r\n");
+        return 1;
     }
+    baud = (uint32_t)strtoul(argv[1], NULL, 10);
+    SHELL_Printf("cambiando a %u\r\n", baud);
+    (void)USTREAM_Flush(portMAX_DELAY);
+    return USTREAM_SetBaudRate(baud) ? 0 : 2;
+}
+
+static int cmd_uptime(int argc, char *argv[])
+{
+    uint32_t ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
 
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    SHELL_Printf("%u.%03u s\r\n", ms / 1000U, ms % 1000U);
+    return 0;
 }
 
-/* Tarea que espera semáforo y hace echo */
+static int cmd_heap(int argc, char *argv[])
+{
+    SHELL_Printf("libre %u, minimo %u bytes\r\n", (uint32_t)xPortGetFreeHeapSize(),
+                 (uint32_t)xPortGetMinimumEverFreeHeapSize());
+    return 0;
+}
+#else
+/* Estado de la prueba: lo actualiza uart_echo_task al consumir */
+static uint32_t test_received;
+static uint32_t test_errors;            /* bytes fuera de secuencia */
+static uint8_t  test_expected;
+static uint32_t test_last_cycles;
+
+/* En modo prueba la tarea solo verifica la secuencia 0,1,2,... */
 static void uart_echo_task(void *pvParameters)
 {
+    uint8_t buf[64];
+    size_t n;
+
     for (;;)
     {
-        if (xSemaphoreTake(uartSemaphore, portMAX_DELAY) == pdTRUE)
+        n = USTREAM_Read(buf, sizeof(buf), portMAX_DELAY);
+        for (size_t i = 0; i < n; i++)
+        {
+            if (buf[i] != test_expected)
+            {
+                test_errors++;
+            }
+            test_expected = (uint8_t)(buf[i] + 1U);
+        }
+        test_received += n;
+        test_last_cycles = DWT->CYCCNT;
+    }
+}
+
+/* Envía SELFTEST_BYTES en loopback interno (C1[LOOPS]) a cada baud rate y
+ * reporta pérdidas, throughput y % de CPU. El pin TX también saca el patrón.
+ * CPU = 1 - tiempo de la tarea idle / tiempo total, de t0 al fin del envío;
+ * las ISR que interrumpen a idle cuentan como idle, así que es la carga de
+ * las tareas (eco + esta) más las ISR que caen sobre ellas. */
+static void uart_selftest_task(void *pvParameters)
+{
+    static const uint32_t bauds[] = {115200U, 921600U, 1000000U};
+    uint8_t chunk[64];
+
+    for (uint32_t b = 0; b < sizeof(bauds) / sizeof(bauds[0]); b++)
+    {
+        ustream_stats_t st;
+        uint32_t t0, cycles, idle0, idle, wall, cpu_x10;
+
+        /* Termina lo pendiente de PRINTF antes de cambiar el baud rate */
+        (void)USTREAM_Flush(portMAX_DELAY);
+        (void)USTREAM_SetBaudRate(bauds[b]);
+        USTREAM_SetLoopback(true);
+
+        test_received = 0;
+        test_errors = 0;
+        test_expected = 0;
+        USTREAM_ResetStats();
+
+        idle0 = ulTaskGetIdleRunTimeCounter();
+        t0 = DWT->CYCCNT;
+        test_last_cycles = t0;
+        for (uint32_t sent = 0; sent < SELFTEST_BYTES; sent += sizeof(chunk))
         {
-            PRINTF("Carácter recibido: %c\r\n", receivedChar);
+            for (uint32_t i = 0; i < sizeof(chunk); i++)
+            {
+                chunk[i] = (uint8_t)(sent + i);
+            }
+            (void)USTREAM_Write(chunk, sizeof(chunk), portMAX_DELAY);
         }
+        (void)USTREAM_Flush(portMAX_DELAY);
+        wall = DWT->CYCCNT - t0;
+        idle = ulTaskGetIdleRunTimeCounter() - idle0;
+        vTaskDelay(pdMS_TO_TICKS(20));          /* deja llegar el idle del último byte */
+
+        USTREAM_SetLoopback(false);
+        (void)USTREAM_SetBaudRate(UART_BAUDRATE);
+        USTREAM_GetStats(&st);
+
+        cycles = test_last_cycles - t0;
+        cpu_x10 = ((wall != 0U) && (idle <= wall)) ? (uint32_t)(((uint64_t)(wall - idle) * 1000U) / wall) : 0U;
+        PRINTF("\r\n%u baud: enviados %u, recibidos %u, perdidos %u (buffer %u, overrun %u), fuera de secuencia %u, %u bytes/s, CPU %u.%u%%\r\n",
+               bauds[b], SELFTEST_BYTES, test_received, SELFTEST_BYTES - test_received, st.rx_dropped, st.rx_overruns,
+               test_errors,
+               (cycles != 0U) ? (uint32_t)(((uint64_t)test_received * SystemCoreClock) / cycles) : 0U,
+               cpu_x10 / 10U, cpu_x10 % 10U);
     }
+    vTaskSuspend(NULL);
 }
+#endif
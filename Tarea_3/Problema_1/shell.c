@@ -0,0 +1,224 @@
+/*
+ * shell.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "shell.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "task.h"
+
+#include "uart_stream.h"
+
+#define SHELL_ECHO_MAX   64U
+#define SHELL_OUT_MAX    128U
+
+/* ======= Contexto ======= */
+static struct{
+    const shell_cmd_t *cmds;
+    size_t             count;
+    char               line[SHELL_LINE_MAX + 1U];   /* + '\0' */
+    size_t             len;                         /* caracteres ya editados */
+    bool               last_cr;                     /* para tomar "\r\n" como un solo fin */
+    uint8_t            echo[SHELL_ECHO_MAX];
+    size_t             echo_len;
+    char               out[SHELL_OUT_MAX];
+} s_sh;
+
+/* ======= Helpers ======= */
+static void prv_Write(const char *s, size_t len)
+{
+    (void)USTREAM_Write((const uint8_t *)s, len, portMAX_DELAY);
+}
+
+static void prv_EchoFlush(void)
+{
+    if (s_sh.echo_len > 0U)
+    {
+        prv_Write((const char *)s_sh.echo, s_sh.echo_len);
+        s_sh.echo_len = 0;
+    }
+}
+
+static void prv_Echo(const char *s, size_t len)
+{
+    if ((s_sh.echo_len + len) > sizeof(s_sh.echo))
+    {
+        prv_EchoFlush();
+    }
+    memcpy(&s_sh.echo[s_sh.echo_len], s, len);
+    s_sh.echo_len += len;
+}
+
+/* Parte la línea en su lugar: los espacios se vuelven '\0' */
+static int prv_Tokenize(char *line, char *argv[])
+{
+    int argc = 0;
+
+    while (*line != '\0')
+    {
+        while (*line == ' ')
+        {
+            *line++ = '\0';
+        }
+        if (*line == '\0')
+        {
+            break;
+        }
+        if (argc == (int)SHELL_ARGS_MAX)
+        {
+            return -1;
+        }
+        argv[argc++] = line;
+        while ((*line != ' ') && (*line != '\0'))
+        {
+            line++;
+        }
+    }
+    return argc;
+}
+
+static int prv_Help(void)
+{
+    SHELL_Printf("  %-10s %s\r\n", "help", "esta lista");
+    for (size_t i = 0; i < s_sh.count; i++)
+    {
+        SHELL_Printf("  %-10s %s\r\n", s_sh.cmds[i].name, s_sh.cmds[i].help);
+    }
+    return 0;
+}
+
+static void prv_Execute(char *line)
+{
+    char *argv[SHELL_ARGS_MAX];
+    int argc = prv_Tokenize(line, argv);
+    int ret = -1;
+    bool found = false;
+
+    if (argc == 0)
+    {
+        return;
+    }
+    if (argc < 0)
+    {
+        SHELL_Printf("demasiados argumentos (max %u)\r\n", SHELL_ARGS_MAX);
+        return;
+    }
+
+    if (strcmp(argv[0], "help") == 0)
+    {
+        ret = prv_Help();
+        found = true;
+    }
+    for (size_t i = 0; !found && (i < s_sh.count); i++)
+    {
+        if (strcmp(argv[0], s_sh.cmds[i].name) == 0)
+        {
+            ret = s_sh.cmds[i].fn(argc, argv);
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        SHELL_Printf("comando desconocido: %s\r\n", argv[0]);
+    }
+    else if (ret != 0)
+    {
+        SHELL_Printf("error %d\r\n", ret);
+    }
+}
+
+/* Edita en su lugar los n bytes recién leídos en line[len..]. Como el destino
+ * nunca rebasa al origen, backspace y líneas múltiples se compactan sin copiar
+ * a otro buffer */
+static void prv_Process(size_t n)
+{
+    size_t src = s_sh.len;
+    size_t end = s_sh.len + n;
+    size_t dst = s_sh.len;
+
+    for (; src < end; src++)
+    {
+        char c = s_sh.line[src];
+        bool lf_after_cr = (c == '\n') && s_sh.last_cr;
+
+        s_sh.last_cr = (c == '\r');
+        if (lf_after_cr)
+        {
+            continue;
+        }
+        if ((c == '\r') || (c == '\n'))
+        {
+            s_sh.line[dst] = '\0';
+            prv_Echo("\r\n", 2);
+            prv_EchoFlush();
+            prv_Execute(s_sh.line);
+            prv_Write(SHELL_PROMPT, sizeof(SHELL_PROMPT) - 1U);
+            dst = 0;
+        }
+        else if ((c == '\b') || (c == 0x7F))
+        {
+            if (dst > 0U)
+            {
+                dst--;
+                prv_Echo("\b \b", 3);
+            }
+        }
+        else if ((c >= ' ') && (c <= '~'))
+        {
+            s_sh.line[dst++] = c;
+            prv_Echo(&c, 1);
+        }
+    }
+    prv_EchoFlush();
+
+    s_sh.len = dst;
+    if (s_sh.len == SHELL_LINE_MAX)
+    {
+        SHELL_Printf("\r\nlinea muy larga (max %u)\r\n" SHELL_PROMPT, SHELL_LINE_MAX);
+        s_sh.len = 0;
+    }
+}
+
+static void prv_ShellTask(void *pvParameters)
+{
+    prv_Write("\r\n" SHELL_PROMPT, sizeof("\r\n" SHELL_PROMPT) - 1U);
+    for (;;)
+    {
+        /* Directo al buffer de línea, detrás de lo ya editado */
+        size_t n = USTREAM_Read((uint8_t *)&s_sh.line[s_sh.len], SHELL_LINE_MAX - s_sh.len, portMAX_DELAY);
+
+        prv_Process(n);
+    }
+}
+
+/* ======= API ======= */
+bool SHELL_Init(const shell_cmd_t *cmds, size_t count, UBaseType_t priority)
+{
+    s_sh.cmds  = cmds;
+    s_sh.count = count;
+    s_sh.len   = 0;
+
+    return xTaskCreate(prv_ShellTask, "SHELL", configMINIMAL_STACK_SIZE + 256, NULL, priority, NULL) == pdPASS;
+}
+
+void SHELL_Printf(const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = vsnprintf(s_sh.out, sizeof(s_sh.out), fmt, ap);
+    va_end(ap);
+
+    if (n > 0)
+    {
+        prv_Write(s_sh.out, ((size_t)n < sizeof(s_sh.out)) ? (size_t)n : (sizeof(s_sh.out) - 1U));
+    }
+}
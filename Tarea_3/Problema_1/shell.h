@@ -0,0 +1,44 @@
+/*
+ * shell.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Shell de línea sobre uart_stream. Los bytes se leen directo al buffer de
+ * línea y ahí mismo se edita (backspace) y se separa en argumentos: argv
+ * apunta dentro del buffer, no hay copias. Los comandos vienen de una tabla
+ * const (en flash) que da la aplicación; "help" está incluido.
+ */
+
+#ifndef SHELL_H_
+#define SHELL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+
+/* ======= Configuración ======= */
+#define SHELL_LINE_MAX     80U
+#define SHELL_ARGS_MAX     8U
+#define SHELL_PROMPT       "> "
+
+/* ======= Tipos ======= */
+/* Regresa 0 si todo bien; otro valor se reporta como error */
+typedef int (*shell_fn_t)(int argc, char *argv[]);
+
+typedef struct{
+    const char *name;
+    const char *help;
+    shell_fn_t  fn;
+} shell_cmd_t;
+
+/* ======= API ======= */
+/* Crea la tarea del shell; la tabla debe vivir todo el programa */
+bool SHELL_Init(const shell_cmd_t *cmds, size_t count, UBaseType_t priority);
+
+/* Salida para los comandos (solo desde la tarea del shell) */
+void SHELL_Printf(const char *fmt, ...);
+
+#endif /* SHELL_H_ */
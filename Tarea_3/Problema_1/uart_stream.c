@@ -0,0 +1,265 @@
+/*
+ * uart_stream.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "uart_stream.h"
+
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+#include "fsl_device_registers.h"
+#include "fsl_clock.h"
+#include "fsl_uart.h"
+
+#if USTREAM_TX_DMA_CHUNK > USTREAM_TX_BUFFER_SIZE
+#error "USTREAM_TX_DMA_CHUNK debe caber en el buffer de TX"
+#endif
+
+/* ======= Contexto ======= */
+static struct{
+    StreamBufferHandle_t rx;
+    StreamBufferHandle_t tx;
+    SemaphoreHandle_t    tx_lock;
+    volatile bool        tx_busy;       /* hay un bloque en el eDMA */
+    uint8_t              tx_chunk[USTREAM_TX_DMA_CHUNK];
+    uint32_t             tx_len;        /* bytes del bloque en curso */
+    ustream_stats_t      stats;
+} s_us;
+
+/* ======= Helpers ======= */
+/* Carga el siguiente bloque del stream buffer de TX al eDMA. Se llama desde
+ * la ISR del DMA o desde una tarea en sección crítica con tx_busy == false */
+static void prv_TxStart(BaseType_t *woken)
+{
+    size_t n = xStreamBufferReceiveFromISR(s_us.tx, s_us.tx_chunk, sizeof(s_us.tx_chunk), woken);
+
+    if (n == 0U)
+    {
+        s_us.tx_busy = false;
+        return;
+    }
+    s_us.tx_len  = n;
+    s_us.tx_busy = true;
+    DMA0->TCD[USTREAM_DMA_CHANNEL].SADDR         = (uint32_t)s_us.tx_chunk;
+    DMA0->TCD[USTREAM_DMA_CHANNEL].CITER_ELINKNO = (uint16_t)n;
+    DMA0->TCD[USTREAM_DMA_CHANNEL].BITER_ELINKNO = (uint16_t)n;
+    DMA0->SERQ = DMA_SERQ_SERQ(USTREAM_DMA_CHANNEL);
+}
+
+static void prv_TxKick(void)
+{
+    BaseType_t woken = pdFALSE;     /* el único que puede despertar es el escritor actual */
+
+    taskENTER_CRITICAL();
+    if (!s_us.tx_busy)
+    {
+        prv_TxStart(&woken);
+    }
+    taskEXIT_CRITICAL();
+}
+
+/* TCD fijo: 1 byte por petición de la UART, fuente incrementa, destino UARTx->D.
+ * Al terminar el major loop se apaga la petición (DREQ) y entra la ISR */
+static void prv_DmaInit(void)
+{
+    CLOCK_EnableClock(kCLOCK_Dmamux0);
+    CLOCK_EnableClock(kCLOCK_Dma0);
+
+    DMAMUX->CHCFG[USTREAM_DMA_CHANNEL] = 0;
+    DMA0->TCD[USTREAM_DMA_CHANNEL].SOFF        = 1;
+    DMA0->TCD[USTREAM_DMA_CHANNEL].ATTR        = DMA_ATTR_SSIZE(0) | DMA_ATTR_DSIZE(0);
+    DMA0->TCD[USTREAM_DMA_CHANNEL].NBYTES_MLNO = 1;
+    DMA0->TCD[USTREAM_DMA_CHANNEL].SLAST       = 0;
+    DMA0->TCD[USTREAM_DMA_CHANNEL].DADDR       = UART_GetDataRegisterAddress(USTREAM_UART);
+    DMA0->TCD[USTREAM_DMA_CHANNEL].DOFF        = 0;
+    DMA0->TCD[USTREAM_DMA_CHANNEL].DLAST_SGA   = 0;
+    DMA0->TCD[USTREAM_DMA_CHANNEL].CSR         = DMA_CSR_INTMAJOR_MASK | DMA_CSR_DREQ_MASK;
+    DMAMUX->CHCFG[USTREAM_DMA_CHANNEL] =
+        DMAMUX_CHCFG_ENBL_MASK | DMAMUX_CHCFG_SOURCE((uint32_t)USTREAM_UART_DMA_SOURCE & 0xFFU);
+
+    NVIC_SetPriority(USTREAM_DMA_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1U);
+    EnableIRQ(USTREAM_DMA_IRQn);
+}
+
+/* ======= API ======= */
+bool USTREAM_Init(const ustream_config_t *config)
+{
+    uart_config_t uc;
+
+    s_us.rx      = xStreamBufferCreate(USTREAM_RX_BUFFER_SIZE, config->rx_trigger);
+    s_us.tx      = xStreamBufferCreate(USTREAM_TX_BUFFER_SIZE, 1);
+    s_us.tx_lock = xSemaphoreCreateMutex();
+    if ((s_us.rx == NULL) || (s_us.tx == NULL) || (s_us.tx_lock == NULL))
+    {
+        return false;
+    }
+
+    UART_GetDefaultConfig(&uc);
+    uc.baudRate_Bps    = config->baudrate;
+    uc.rxFifoWatermark = USTREAM_RX_FIFO_WATERMARK;
+    uc.idleType        = kUART_IdleTypeStopBit;
+    uc.enableTx        = true;
+    uc.enableRx        = true;
+    if (UART_Init(USTREAM_UART, &uc, USTREAM_UART_CLK_FREQ) != kStatus_Success)
+    {
+        return false;
+    }
+
+    prv_DmaInit();
+    UART_EnableTxDMA(USTREAM_UART, true);       /* TDRE pide DMA en lugar de interrupción */
+    UART_EnableInterrupts(USTREAM_UART, kUART_RxDataRegFullInterruptEnable | kUART_IdleLineInterruptEnable |
+                                            kUART_RxOverrunInterruptEnable);
+    NVIC_SetPriority(USTREAM_UART_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    EnableIRQ(USTREAM_UART_IRQn);
+    return true;
+}
+
+size_t USTREAM_Read(uint8_t *buf, size_t len, TickType_t timeout)
+{
+    return xStreamBufferReceive(s_us.rx, buf, len, timeout);
+}
+
+size_t USTREAM_Write(const uint8_t *buf, size_t len, TickType_t timeout)
+{
+    TimeOut_t t;
+    size_t sent = 0;
+
+    vTaskSetTimeOutState(&t);
+    if (xSemaphoreTake(s_us.tx_lock, timeout) != pdTRUE)
+    {
+        return 0;
+    }
+    (void)xTaskCheckForTimeOut(&t, &timeout);
+
+    /* En piezas de dos bloques DMA para arrancar el eDMA sin esperar a llenar el buffer */
+    while (sent < len)
+    {
+        size_t piece = len - sent;
+
+        if (piece > 2U * USTREAM_TX_DMA_CHUNK)
+        {
+            piece = 2U * USTREAM_TX_DMA_CHUNK;
+        }
+        sent += xStreamBufferSend(s_us.tx, &buf[sent], piece, timeout);
+        prv_TxKick();
+        if ((sent < len) && (xTaskCheckForTimeOut(&t, &timeout) != pdFALSE))
+        {
+            break;
+        }
+    }
+
+    xSemaphoreGive(s_us.tx_lock);
+    return sent;
+}
+
+bool USTREAM_Flush(TickType_t timeout)
+{
+    TimeOut_t t;
+
+    vTaskSetTimeOutState(&t);
+    while (s_us.tx_busy || !xStreamBufferIsEmpty(s_us.tx) ||
+           !(UART_GetStatusFlags(USTREAM_UART) & kUART_TransmissionCompleteFlag))
+    {
+        if (xTaskCheckForTimeOut(&t, &timeout) != pdFALSE)
+        {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+    return true;
+}
+
+bool USTREAM_SetBaudRate(uint32_t baudrate)
+{
+    return UART_SetBaudRate(USTREAM_UART, baudrate, USTREAM_UART_CLK_FREQ) == kStatus_Success;
+}
+
+void USTREAM_SetLoopback(bool enable)
+{
+    if (enable)
+    {
+        USTREAM_UART->C1 |= UART_C1_LOOPS_MASK;
+    }
+    else
+    {
+        USTREAM_UART->C1 &= (uint8_t)~UART_C1_LOOPS_MASK;
+    }
+}
+
+void USTREAM_GetStats(ustream_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = s_us.stats;
+    taskEXIT_CRITICAL();
+}
+
+void USTREAM_ResetStats(void)
+{
+    taskENTER_CRITICAL();
+    s_us.stats = (ustream_stats_t){0};
+    taskEXIT_CRITICAL();
+}
+
+/* ======= ISRs ======= */
+/* RX: vacía la FIFO al stream buffer. El lector despierta al llegar al nivel
+ * de disparo o, al terminar la ráfaga (idle), con lo que haya */
+void USTREAM_UART_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+    uint8_t s1 = USTREAM_UART->S1;              /* leer S1 y luego D limpia RDRF/IDLE/OR */
+    uint8_t count = USTREAM_UART->RCFIFO;
+    uint8_t data[8];
+
+    if (s1 & UART_S1_OR_MASK)
+    {
+        s_us.stats.rx_overruns++;
+    }
+
+    if (count > 0U)
+    {
+        size_t sent;
+
+        if (count > sizeof(data))
+        {
+            count = sizeof(data);
+        }
+        for (uint8_t i = 0; i < count; i++)
+        {
+            data[i] = USTREAM_UART->D;
+        }
+        sent = xStreamBufferSendFromISR(s_us.rx, data, count, &woken);
+        s_us.stats.rx_bytes   += sent;
+        s_us.stats.rx_dropped += count - sent;
+    }
+    else if (USTREAM_UART->S1 & (UART_S1_IDLE_MASK | UART_S1_OR_MASK))
+    {
+        /* FIFO vacía: la lectura de D para limpiar la bandera deja un underflow */
+        (void)USTREAM_UART->D;
+        USTREAM_UART->SFIFO = UART_SFIFO_RXUF_MASK;
+        USTREAM_UART->CFIFO |= UART_CFIFO_RXFLUSH_MASK;
+    }
+
+    if ((s1 & UART_S1_IDLE_MASK) && !xStreamBufferIsEmpty(s_us.rx))
+    {
+        (void)xStreamBufferSendCompletedFromISR(s_us.rx, &woken);
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/* TX: terminó un bloque, carga el siguiente */
+void USTREAM_DMA_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    DMA0->CINT = DMA_CINT_CINT(USTREAM_DMA_CHANNEL);
+    s_us.stats.tx_bytes += s_us.tx_len;
+    s_us.stats.tx_dma_blocks++;
+    prv_TxStart(&woken);
+
+    portYIELD_FROM_ISR(woken);
+}
@@ -0,0 +1,77 @@
+/*
+ * uart_stream.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Driver full-duplex de UART sobre stream buffers de FreeRTOS. La ISR de RX
+ * vacía la FIFO de hardware (watermark + idle line) a un stream buffer con
+ * nivel de disparo; TX sale de un segundo stream buffer por eDMA, un bloque
+ * a la vez, sin interrupción por byte.
+ *
+ * Un solo lector y cualquier número de escritores (USTREAM_Write está
+ * protegido con un mutex). PRINTF usa la misma UART0: no mezclarlo con
+ * USTREAM_Write mientras haya datos saliendo.
+ */
+
+#ifndef UART_STREAM_H_
+#define UART_STREAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+
+/* ======= Configuración ======= */
+#define USTREAM_UART               UART0
+#define USTREAM_UART_CLK_FREQ      CLOCK_GetFreq(UART0_CLK_SRC)
+#define USTREAM_UART_IRQn          UART0_RX_TX_IRQn
+#define USTREAM_UART_IRQHandler    UART0_RX_TX_IRQHandler
+#define USTREAM_UART_DMA_SOURCE    kDmaRequestMux0UART0Tx
+
+#define USTREAM_DMA_CHANNEL        0U
+#define USTREAM_DMA_IRQn           DMA0_IRQn
+#define USTREAM_DMA_IRQHandler     DMA0_IRQHandler
+
+#define USTREAM_RX_BUFFER_SIZE     512U
+#define USTREAM_TX_BUFFER_SIZE     512U
+#define USTREAM_TX_DMA_CHUNK       64U      /* bytes por transferencia eDMA */
+#define USTREAM_RX_FIFO_WATERMARK  6U       /* de 8 en la FIFO de UART0 */
+
+/* ======= Tipos ======= */
+typedef struct{
+    uint32_t baudrate;
+    size_t   rx_trigger;        /* bytes para despertar al lector; el idle lo despierta antes */
+} ustream_config_t;
+
+typedef struct{
+    uint32_t rx_bytes;
+    uint32_t rx_dropped;        /* stream buffer de RX lleno */
+    uint32_t rx_overruns;       /* FIFO de hardware desbordada */
+    uint32_t tx_bytes;
+    uint32_t tx_dma_blocks;
+} ustream_stats_t;
+
+/* ======= API ======= */
+bool   USTREAM_Init(const ustream_config_t *config);
+
+/* Regresa los bytes leídos (0 si venció timeout) */
+size_t USTREAM_Read(uint8_t *buf, size_t len, TickType_t timeout);
+
+/* Regresa los bytes aceptados; menos que len solo si venció timeout */
+size_t USTREAM_Write(const uint8_t *buf, size_t len, TickType_t timeout);
+
+/* Espera a que TX termine de salir por el pin */
+bool   USTREAM_Flush(TickType_t timeout);
+
+/* Cambia el baud rate; hacer USTREAM_Flush antes */
+bool   USTREAM_SetBaudRate(uint32_t baudrate);
+
+/* Loopback interno TX -> RX (C1[LOOPS]) para pruebas; el pin TX sigue activo */
+void   USTREAM_SetLoopback(bool enable);
+
+void   USTREAM_GetStats(ustream_stats_t *stats);
+void   USTREAM_ResetStats(void);
+
+#endif /* UART_STREAM_H_ */
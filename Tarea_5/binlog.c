@@ -0,0 +1,29 @@
+/*
+ * binlog.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "binlog.h"
+
+uint8_t BINLOG_Encode(uint8_t *out, uint8_t fmt_id, uint16_t ts, uint16_t a0, uint16_t a1)
+{
+    uint8_t i, x = 0U;
+
+    out[0] = BINLOG_SYNC;
+    out[1] = fmt_id;
+    out[2] = (uint8_t)(ts & 0xFFU);
+    out[3] = (uint8_t)(ts >> 8);
+    out[4] = (uint8_t)(a0 & 0xFFU);
+    out[5] = (uint8_t)(a0 >> 8);
+    out[6] = (uint8_t)(a1 & 0xFFU);
+    out[7] = (uint8_t)(a1 >> 8);
+    for (i = 1U; i < BINLOG_RECORD_SIZE - 1U; i++)
+    {
+        x ^= out[i];
+    }
+    out[8] = x;
+
+    return BINLOG_RECORD_SIZE;
+}
@@ -0,0 +1,36 @@
+/*
+ * binlog.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Log binario: en vez de formatear texto en la tarjeta, cada mensaje sale
+ * como un registro fijo con el ID de su formato, un timestamp y dos
+ * argumentos crudos. El texto lo arma la PC con la tabla de formatos.
+ *
+ * Registro (BINLOG_RECORD_SIZE bytes, little endian):
+ *   [0xA5][fmt_id][ts lo][ts hi][a0 lo][a0 hi][a1 lo][a1 hi][xor]
+ *   ts  = DWT->CYCCNT >> 16 al encolar el mensaje (unidades de 65536 ciclos,
+ *         ~0.55 ms a 120 MHz); 16 bits que dan la vuelta junto con CYCCNT,
+ *         el decodificador desenrolla el wrap
+ *   xor = XOR de los bytes 1..7; si no cuadra, el decodificador busca el
+ *         siguiente 0xA5
+ */
+
+#ifndef BINLOG_H_
+#define BINLOG_H_
+
+#include <stdint.h>
+
+#define BINLOG_SYNC             0xA5U
+#define BINLOG_RECORD_SIZE      9U
+#define BINLOG_TS_SHIFT         16U     /* ts = ciclos >> BINLOG_TS_SHIFT */
+
+/* ======= Tabla de formatos (la misma va en el decodificador) ======= */
+#define BINLOG_FMT_RX           0x01U   /* "Datos recibidos del Th%d = %u\r\n", a0, a1 */
+
+/* ======= API ======= */
+/* Arma un registro en out (BINLOG_RECORD_SIZE bytes); regresa el tamaño */
+uint8_t BINLOG_Encode(uint8_t *out, uint8_t fmt_id, uint16_t ts, uint16_t a0, uint16_t a1);
+
+#endif /* BINLOG_H_ */
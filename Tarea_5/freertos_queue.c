@@ -9,6 +9,8 @@
 /*System includes.*/
 /* System includes */
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
 
 /* Kernel includes */
 #include "FreeRTOS.h"
@@ -23,29 +25,141 @@
 #include "clock_config.h"
 #include "board.h"
 
+/* Binary log */
+#include "binlog.h"
+
+/* Lock-free log ring */
+#include "mpsc_ring.h"
+
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 #define MAX_LOG_LENGTH 20
 
+/* 1: log_task sends 9-byte binary records (see binlog.h) instead of text */
+#ifndef LOG_BINARY
+#define LOG_BINARY 1
+#endif
+
+/* 1: producers write into a lock-free MPSC ring (see mpsc_ring.h);
+ * 0: per-message xQueueSend, kept for comparison */
+#ifndef LOG_USE_RING
+#define LOG_USE_RING 1
+#endif
+
+/* Logger queue/ring depth (benchmark with 10, 64 and 256; the ring needs a
+ * power of two, so 16 stands in for 10 there) */
+#ifndef LOG_QUEUE_DEPTH
+#define LOG_QUEUE_DEPTH 16
+#endif
+#if LOG_USE_RING && ((LOG_QUEUE_DEPTH & (LOG_QUEUE_DEPTH - 1)) != 0)
+#error "LOG_QUEUE_DEPTH must be a power of two with LOG_USE_RING"
+#endif
+
+/* Logger wakeup policy: it runs when LOG_WAKE_COUNT messages are pending
+ * (the producer that crosses that level notifies it, so with the ring the
+ * kernel is only entered on that transition; 1 = on leaving empty) or
+ * LOG_WAKE_DEADLINE_MS after the previous drain, whichever comes first. */
+#ifndef LOG_WAKE_COUNT
+#define LOG_WAKE_COUNT 8
+#endif
+#ifndef LOG_WAKE_DEADLINE_MS
+#define LOG_WAKE_DEADLINE_MS 20
+#endif
+
+/* Messages drained and written per UART call */
+#define LOG_BATCH_MAX 32
+#if LOG_BINARY
+#define LOG_TX_BYTES_PER_MSG BINLOG_RECORD_SIZE
+#else
+/* Widest line: thread_id is a uint8_t */
+#define LOG_TX_BYTES_PER_MSG (sizeof("Datos recibidos del Th255 = 65535\r\n") - 1U)
+#endif
+
+/* Benchmark parameters */
+#ifndef BENCH_PRODUCERS
+#define BENCH_PRODUCERS 3           /* producer tasks (data pattern: id % 3) */
+#endif
+#if BENCH_PRODUCERS > 256
+#error "BENCH_PRODUCERS must fit the uint8_t thread_id in Message_t"
+#endif
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS 65536U     /* messages per producer (half for the even-step ones) */
+#endif
+#ifndef BENCH_PERIOD_MS
+#define BENCH_PERIOD_MS 1           /* between messages; below one tick it only yields */
+#endif
+#ifndef BENCH_DROP_WHEN_FULL
+#define BENCH_DROP_WHEN_FULL 0      /* 1: drop instead of waiting for room */
+#endif
+#ifndef BENCH_EXIT_WHEN_DONE
+#define BENCH_EXIT_WHEN_DONE 0      /* 1: end the process after the report (host/ POSIX build) */
+#endif
+
+/* Enqueue-to-print latency histogram: bucket 0 < 64 us, then doubling,
+ * the last one is open-ended (>= 64 us << (LAT_BUCKETS - 2)) */
+#define LAT_BUCKETS 12
+#define LAT_BUCKET0_US 64U
+
 typedef struct {
     uint8_t thread_id;
     uint16_t data;
+    uint32_t t_post;                /* DWT->CYCCNT at enqueue */
 } Message_t;
 
 /*******************************************************************************
  * Globals
  ******************************************************************************/
-/* Logger queue handle */
+/* Logger queue / ring */
+#if LOG_USE_RING
+static mpsc_ring_t log_ring;
+static Message_t log_ring_storage[LOG_QUEUE_DEPTH];
+static volatile uint32_t log_ring_seq[LOG_QUEUE_DEPTH];
+#else
 static QueueHandle_t log_queue = NULL;
+#endif
+static TaskHandle_t log_task_handle = NULL;
+
+/* Benchmark counters (DWT cycles) */
+typedef struct {
+    uint32_t sent;
+    uint32_t blocked;            /* posts that found the queue full and waited */
+    uint32_t dropped;            /* posts discarded (BENCH_DROP_WHEN_FULL) */
+    uint64_t blocked_cycles;     /* total time spent posting (waiting for room included) */
+    uint32_t max_blocked_cycles;
+    volatile bool done;
+} TxStats_t;
+
+/* Written only by log_task */
+typedef struct {
+    uint32_t received;
+    uint64_t lat_sum_cycles;
+    uint32_t lat_min_cycles;
+    uint32_t lat_max_cycles;
+    uint32_t lat_hist[LAT_BUCKETS];
+} RxStats_t;
+
+static TxStats_t tx_stats[BENCH_PRODUCERS];
+static RxStats_t rx_stats[BENCH_PRODUCERS];
+static uint32_t  log_received;
+static uint32_t  log_wakeups;
+static uint32_t  max_occupancy;
+static TickType_t bench_start_ticks;     /* runs take minutes: CYCCNT would wrap */
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
-static void tx_0_task(void *pvParameters);
-static void tx_1_task(void *pvParameters);
-static void tx_2_task(void *pvParameters);
+static void tx_task(void *pvParameters);
 static void log_task(void *pvParameters);
+static void log_post(Message_t *msg);
+static void log_latency(const Message_t *msg, uint32_t t_print);
+static bool bench_done(void);
+static bool log_pop(Message_t *msg);
+static uint32_t log_pending(void);
+static void log_report(TickType_t elapsed_ticks);
+
+/* Raw debug console write (not declared in fsl_debug_console.h) */
+extern int DbgConsole_SendDataReliable(uint8_t *ch, size_t size);
 
 /*******************************************************************************
  * Code
@@ -57,37 +171,40 @@ int main(void)
     BOARD_InitBootClocks();
     BOARD_InitDebugConsole();
 
+    /* DWT cycle counter for the benchmark */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if LOG_USE_RING
+    (void)MPSC_Init(&log_ring, log_ring_storage, log_ring_seq, LOG_QUEUE_DEPTH, sizeof(Message_t));
+#else
     /* Create queue for Message_t items */
-    log_queue = xQueueCreate(10, sizeof(Message_t));
+    log_queue = xQueueCreate(LOG_QUEUE_DEPTH, sizeof(Message_t));
     if (log_queue != NULL)
     {
         vQueueAddToRegistry(log_queue, "LogQ");
     }
+#endif
 
     /* Create receiver task */
-    if (xTaskCreate(log_task, "log_task", configMINIMAL_STACK_SIZE + 166, NULL, tskIDLE_PRIORITY + 3, NULL) != pdPASS)
+    if (xTaskCreate(log_task, "log_task", configMINIMAL_STACK_SIZE + 166, NULL, tskIDLE_PRIORITY + 3, &log_task_handle) != pdPASS)
     {
         PRINTF("Task creation failed!.\r\n");
         while (1);
     }
 
     /* Create transmitter tasks */
-    if (xTaskCreate(tx_0_task, "TX0", configMINIMAL_STACK_SIZE + 166, NULL, tskIDLE_PRIORITY + 2, NULL) != pdPASS)
+    for (uint32_t id = 0; id < BENCH_PRODUCERS; id++)
     {
-        PRINTF("Task creation failed!.\r\n");
-        while (1);
-    }
-
-    if (xTaskCreate(tx_1_task, "TX1", configMINIMAL_STACK_SIZE + 166, NULL, tskIDLE_PRIORITY + 2, NULL) != pdPASS)
-    {
-        PRINTF("Task creation failed!.\r\n");
-        while (1);
-    }
+        char name[configMAX_TASK_NAME_LEN];
 
-    if (xTaskCreate(tx_2_task, "TX2", configMINIMAL_STACK_SIZE + 166, NULL, tskIDLE_PRIORITY + 2, NULL) != pdPASS)
-    {
-        PRINTF("Task creation failed!.\r\n");
-        while (1);
+        (void)snprintf(name, sizeof(name), "TX%u", id);
+        if (xTaskCreate(tx_task, name, configMINIMAL_STACK_SIZE + 166, (void *)id, tskIDLE_PRIORITY + 2, NULL) != pdPASS)
+        {
+            PRINTF("Task creation failed!.\r\n");
+            while (1);
+        }
     }
 
     vTaskStartScheduler();
@@ -98,56 +215,263 @@ int main(void)
 /*******************************************************************************
  * Transmitter tasks
  ******************************************************************************/
-static void tx_0_task(void *pvParameters)
+/* Producer id sends the original patterns: id % 3 == 0 counts up, 1 counts
+ * down (BENCH_ITERATIONS messages each), 2 counts up in even steps over the
+ * same range, so it sends half as many. */
+static void tx_task(void *pvParameters)
 {
+    uint32_t id = (uint32_t)pvParameters;
+    uint32_t count = ((id % 3U) == 2U) ? (BENCH_ITERATIONS / 2U) : BENCH_ITERATIONS;
     Message_t msg;
-    msg.thread_id = 0;
-    for (uint16_t i = 0; i <= 65535; i++)
+
+    msg.thread_id = (uint8_t)id;
+    for (uint32_t i = 0; i < count; i++)
     {
-        msg.data = i;
-        xQueueSend(log_queue, &msg, portMAX_DELAY);
-        vTaskDelay(pdMS_TO_TICKS(1));
+        switch (id % 3U)
+        {
+            case 0:  msg.data = (uint16_t)i;            break;
+            case 1:  msg.data = (uint16_t)(65535U - i); break;
+            default: msg.data = (uint16_t)(i * 2U);     break;
+        }
+        log_post(&msg);
+        vTaskDelay(pdMS_TO_TICKS(BENCH_PERIOD_MS));
     }
+    tx_stats[id].done = true;
     vTaskSuspend(NULL);
 }
 
-static void tx_1_task(void *pvParameters)
+/* Enqueue one message, timing how long the producer is blocked, and wake
+ * the logger when the pending count reaches LOG_WAKE_COUNT. */
+static void log_post(Message_t *msg)
 {
-    Message_t msg;
-    msg.thread_id = 1;
-    for (int i = 65535; i >= 0; i--)
+    TxStats_t *st = &tx_stats[msg->thread_id];
+    uint32_t t0 = DWT->CYCCNT;
+    uint32_t dt, pending;
+    bool waited = false;
+#if LOG_USE_RING
+    uint32_t pos;
+    Message_t *slot;
+
+    /* Full ring: the only case that touches the kernel, to let the logger run */
+    while ((slot = MPSC_Reserve(&log_ring, &pos, &pending)) == NULL)
     {
-        msg.data = i;
-        xQueueSend(log_queue, &msg, portMAX_DELAY);
-        vTaskDelay(pdMS_TO_TICKS(1));
+        xTaskNotifyGive(log_task_handle);
+#if BENCH_DROP_WHEN_FULL
+        st->dropped++;
+        return;
+#else
+        waited = true;
+        vTaskDelay(1);
+#endif
     }
-    vTaskSuspend(NULL);
-}
+    msg->t_post = DWT->CYCCNT;
+    *slot = *msg;
+    MPSC_Commit(&log_ring, pos);
+#else
+    msg->t_post = t0;
+    if (xQueueSend(log_queue, msg, 0) != pdTRUE)
+    {
+        xTaskNotifyGive(log_task_handle);
+#if BENCH_DROP_WHEN_FULL
+        st->dropped++;
+        return;
+#else
+        waited = true;
+        xQueueSend(log_queue, msg, portMAX_DELAY);
+#endif
+    }
+    pending = uxQueueMessagesWaiting(log_queue);
+#endif
 
-static void tx_2_task(void *pvParameters)
-{
-    Message_t msg;
-    msg.thread_id = 2;
-    for (uint16_t i = 0; i <= 65535; i += 2)
+    dt = DWT->CYCCNT - t0;
+    st->sent++;
+    if (waited)
     {
-        msg.data = i;
-        xQueueSend(log_queue, &msg, portMAX_DELAY);
-        vTaskDelay(pdMS_TO_TICKS(1));
+        st->blocked++;
     }
-    vTaskSuspend(NULL);
+    if (pending > max_occupancy)
+    {
+        max_occupancy = pending;   /* racy max between producers: good enough for a peak */
+    }
+    st->blocked_cycles += dt;
+    if (dt > st->max_blocked_cycles)
+    {
+        st->max_blocked_cycles = dt;
+    }
+
+#if LOG_USE_RING
+    if (pending == LOG_WAKE_COUNT)
+#else
+    if (pending >= LOG_WAKE_COUNT)
+#endif
+    {
+        xTaskNotifyGive(log_task_handle);
+    }
+}
+
+static bool log_pop(Message_t *msg)
+{
+#if LOG_USE_RING
+    return MPSC_Pop(&log_ring, msg);
+#else
+    return (xQueueReceive(log_queue, msg, 0) == pdTRUE);
+#endif
+}
+
+static uint32_t log_pending(void)
+{
+#if LOG_USE_RING
+    return MPSC_Count(&log_ring);
+#else
+    return uxQueueMessagesWaiting(log_queue);
+#endif
 }
 
 /*******************************************************************************
  * Receiver task
  ******************************************************************************/
+/* Drain everything pending per wakeup, format it into one buffer and write it
+ * with a single UART call. */
 static void log_task(void *pvParameters)
 {
-    Message_t msg;
+    static Message_t batch[LOG_BATCH_MAX];
+    static uint8_t tx_buf[LOG_BATCH_MAX * LOG_TX_BYTES_PER_MSG + 1];
+    uint32_t n, i, len;
+    bool reported = false;
+
+    bench_start_ticks = xTaskGetTickCount();
+
     while (1)
     {
-        if (xQueueReceive(log_queue, &msg, portMAX_DELAY) == pdTRUE)
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_WAKE_DEADLINE_MS));
+        log_wakeups++;
+
+        do
+        {
+            for (n = 0; n < LOG_BATCH_MAX; n++)
+            {
+                if (!log_pop(&batch[n]))
+                {
+                    break;
+                }
+            }
+
+            len = 0;
+            for (i = 0; i < n; i++)
+            {
+#if LOG_BINARY
+                len += BINLOG_Encode(&tx_buf[len], BINLOG_FMT_RX,
+                                     (uint16_t)(batch[i].t_post >> BINLOG_TS_SHIFT),
+                                     batch[i].thread_id, batch[i].data);
+#else
+                int w = snprintf((char *)&tx_buf[len], sizeof(tx_buf) - len,
+                                 "Datos recibidos del Th%d = %u\r\n",
+                                 batch[i].thread_id, batch[i].data);
+
+                /* snprintf returns what it would have written: never step
+                 * past the terminator it actually stored */
+                if (w > 0)
+                {
+                    len += ((uint32_t)w < sizeof(tx_buf) - len) ? (uint32_t)w : (sizeof(tx_buf) - len - 1U);
+                }
+#endif
+            }
+            if (len > 0)
+            {
+                uint32_t t_print;
+
+                (void)DbgConsole_SendDataReliable(tx_buf, len);
+                t_print = DWT->CYCCNT;
+                for (i = 0; i < n; i++)
+                {
+                    log_latency(&batch[i], t_print);
+                }
+            }
+            log_received += n;
+        } while (n == LOG_BATCH_MAX);
+
+        if (!reported && bench_done() && log_pending() == 0)
+        {
+            log_report(xTaskGetTickCount() - bench_start_ticks);
+            reported = true;
+#if BENCH_EXIT_WHEN_DONE
+            exit(0);
+#endif
+        }
+    }
+}
+
+static bool bench_done(void)
+{
+    for (uint32_t id = 0; id < BENCH_PRODUCERS; id++)
+    {
+        if (!tx_stats[id].done)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Enqueue-to-print latency of one message, into its producer's histogram */
+static void log_latency(const Message_t *msg, uint32_t t_print)
+{
+    RxStats_t *rx = &rx_stats[msg->thread_id];
+    uint32_t lat = t_print - msg->t_post;
+    uint32_t us = lat / (SystemCoreClock / 1000000U);
+    uint32_t b = 0;
+
+    if (rx->received == 0 || lat < rx->lat_min_cycles)
+    {
+        rx->lat_min_cycles = lat;
+    }
+    if (lat > rx->lat_max_cycles)
+    {
+        rx->lat_max_cycles = lat;
+    }
+    rx->lat_sum_cycles += lat;
+    rx->received++;
+
+    /* bucket = floor(log2(us / LAT_BUCKET0_US)) + 1 */
+    if (us >= LAT_BUCKET0_US)
+    {
+        b = 32U - __CLZ(us / LAT_BUCKET0_US);
+        if (b > LAT_BUCKETS - 1U)
+        {
+            b = LAT_BUCKETS - 1U;
+        }
+    }
+    rx->lat_hist[b]++;
+}
+
+/* End-of-run summary: sustained rate, producer blocking, queue peak and
+ * per-producer latency distribution */
+static void log_report(TickType_t elapsed_ticks)
+{
+    uint32_t cpu_mhz = SystemCoreClock / 1000000U;
+    uint32_t elapsed_ms = elapsed_ticks * portTICK_PERIOD_MS;
+
+    PRINTF("\r\n== log bench: %s depth %d, %d producers x %u msgs every %d ms, wake %d msgs / %d ms, %s ==\r\n",
+           LOG_USE_RING ? "ring" : "queue", LOG_QUEUE_DEPTH, BENCH_PRODUCERS, BENCH_ITERATIONS,
+           BENCH_PERIOD_MS, LOG_WAKE_COUNT, LOG_WAKE_DEADLINE_MS, LOG_BINARY ? "binary" : "text");
+    PRINTF("msgs %u, time %u ms, rate %u msgs/s, wakeups %u, max occupancy %u/%d\r\n", log_received, elapsed_ms,
+           (elapsed_ms != 0U) ? (uint32_t)(((uint64_t)log_received * 1000U) / elapsed_ms) : 0U, log_wakeups,
+           max_occupancy, LOG_QUEUE_DEPTH);
+    for (uint32_t id = 0; id < BENCH_PRODUCERS; id++)
+    {
+        const TxStats_t *tx = &tx_stats[id];
+        const RxStats_t *rx = &rx_stats[id];
+
+        PRINTF("TX%u sent %u, blocked %u, dropped %u, post time total %u us, max %u us\r\n", id,
+               tx->sent, tx->blocked, tx->dropped, (uint32_t)(tx->blocked_cycles / cpu_mhz),
+               tx->max_blocked_cycles / cpu_mhz);
+        PRINTF("TX%u latency us: min %u, mean %u, max %u; hist", id, rx->lat_min_cycles / cpu_mhz,
+               (rx->received != 0U) ? (uint32_t)(rx->lat_sum_cycles / rx->received / cpu_mhz) : 0U,
+               rx->lat_max_cycles / cpu_mhz);
+        for (uint32_t b = 0; b < LAT_BUCKETS; b++)
         {
-            PRINTF("Datos recibidos del Th%d = %u\r\n", msg.thread_id, msg.data);
+            PRINTF(" %u", rx->lat_hist[b]);
         }
+        PRINTF("\r\n");
     }
 }
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+#
+# binlog_decode.py
+#
+#  Created on: 19 oct 2026
+#      Author: luisg
+#
+# Decodificador del log binario de freertos_queue.c (formato en binlog.h):
+# lee los registros de 9 bytes de un archivo, de stdin o de la UART y escribe
+# el texto que la tarjeta ya no formatea, con la hora desde el primer registro.
+#
+#   [0xA5][fmt_id][ts lo][ts hi][a0 lo][a0 hi][a1 lo][a1 hi][xor]
+#
+# Un registro cuyo XOR no cuadra (o con fmt_id desconocido) se descarta y se
+# busca el siguiente 0xA5. ts son los 16 bits altos de DWT->CYCCNT y dan la
+# vuelta cada 2^32 ciclos; se desenrolla tomando cada salto como un entero de
+# 16 bits con signo, porque los productores pueden llegar un poco desordenados.
+#
+#   binlog_decode.py captura.bin            (o "-" para stdin)
+#   binlog_decode.py /dev/ttyACM0 --serial  (requiere pyserial)
+#
+#   --mhz N              reloj del CPU (120 en BOARD_BootClockRUN)
+#   --check P N          no imprime; verifica la corrida del benchmark con P
+#                        productores de N mensajes (patrones de tx_task) y
+#                        regresa 1 si falta, sobra o se corrompió algo
+
+import argparse
+import sys
+
+SYNC = 0xA5
+RECORD_SIZE = 9
+TS_SHIFT = 16
+
+# La misma tabla que binlog.h
+FORMATS = {
+    0x01: "Datos recibidos del Th%d = %u",      # BINLOG_FMT_RX
+}
+
+
+class Decoder:
+    """Bytes -> (fmt_id, ts, a0, a1); guarda el registro partido entre lecturas"""
+
+    def __init__(self):
+        self.buf = b""
+        self.resyncs = 0        # 0xA5 con XOR o fmt_id malos
+        self.skipped = 0        # bytes descartados buscando 0xA5
+
+    def feed(self, data):
+        buf = self.buf + data
+        out = []
+        i = 0
+        while i + RECORD_SIZE <= len(buf):
+            if buf[i] != SYNC:
+                self.skipped += 1
+                i += 1
+                continue
+            rec = buf[i:i + RECORD_SIZE]
+            x = 0
+            for b in rec[1:RECORD_SIZE - 1]:
+                x ^= b
+            if x != rec[RECORD_SIZE - 1] or rec[1] not in FORMATS:
+                self.resyncs += 1
+                self.skipped += 1
+                i += 1
+                continue
+            out.append((rec[1],
+                        rec[2] | (rec[3] << 8),
+                        rec[4] | (rec[5] << 8),
+                        rec[6] | (rec[7] << 8)))
+            i += RECORD_SIZE
+        self.buf = buf[i:]
+        return out
+
+    def close(self):
+        """Lo que quedó al final no alcanza para un registro"""
+        self.skipped += len(self.buf)
+        self.buf = b""
+
+
+class Unwrap:
+    """ts de 16 bits -> ciclos desde el primer registro"""
+
+    def __init__(self):
+        self.last = None
+        self.ticks = 0
+
+    def __call__(self, ts):
+        if self.last is not None:
+            d = (ts - self.last) & 0xFFFF
+            if d >= 0x8000:
+                d -= 0x10000
+            self.ticks += d
+        self.last = ts
+        return self.ticks << TS_SHIFT
+
+
+def expected(producers, iterations):
+    """Lo que manda tx_task: id % 3 == 0 sube, 1 baja, 2 sube de dos en dos"""
+    exp = []
+    for pid in range(producers):
+        if pid % 3 == 0:
+            exp.append([i & 0xFFFF for i in range(iterations)])
+        elif pid % 3 == 1:
+            exp.append([(65535 - i) & 0xFFFF for i in range(iterations)])
+        else:
+            exp.append([(i * 2) & 0xFFFF for i in range(iterations // 2)])
+    return exp
+
+
+def check(recs, dec, unwrap, producers, iterations, hz):
+    exp = expected(producers, iterations)
+    got = [[] for _ in range(producers)]
+    last_t = [None] * producers
+    errors = 0
+
+    for fmt, ts, a0, a1 in recs:
+        t = unwrap(ts)
+        if fmt != 0x01 or a0 >= producers:
+            print("registro inesperado: fmt 0x%02X, Th%d = %u" % (fmt, a0, a1))
+            errors += 1
+            continue
+        # Cada productor encola en orden: su hora no puede ir para atrás
+        if last_t[a0] is not None and t < last_t[a0]:
+            print("Th%d: la hora regresa %d ciclos" % (a0, last_t[a0] - t))
+            errors += 1
+        last_t[a0] = t
+        got[a0].append(a1)
+
+    for pid in range(producers):
+        if got[pid] != exp[pid]:
+            n = min(len(got[pid]), len(exp[pid]))
+            first = next((k for k in range(n) if got[pid][k] != exp[pid][k]), n)
+            print("Th%d: %d mensajes de %d, el primero distinto es el #%d"
+                  % (pid, len(got[pid]), len(exp[pid]), first))
+            errors += 1
+    if dec.resyncs or dec.skipped:
+        print("%d registros corruptos, %d bytes descartados" % (dec.resyncs, dec.skipped))
+        errors += 1
+
+    total = sum(len(g) for g in got)
+    print("%d registros de %d productores, %.1f ms de log"
+          % (total, producers, (unwrap.ticks << TS_SHIFT) / hz * 1e3))
+    print("OK" if errors == 0 else "FALLÓ")
+    return 0 if errors == 0 else 1
+
+
+def show(recs, unwrap, hz):
+    for fmt, ts, a0, a1 in recs:
+        print("[%10.3f ms] " % (unwrap(ts) / hz * 1e3) + FORMATS[fmt] % (a0, a1))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decodificador del log binario (binlog.h)")
+    ap.add_argument("input", help="archivo, '-' para stdin o puerto con --serial")
+    ap.add_argument("--serial", action="store_true")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--mhz", type=float, default=120.0)
+    ap.add_argument("--check", nargs=2, type=int, metavar=("P", "N"))
+    args = ap.parse_args()
+
+    hz = args.mhz * 1e6
+    dec = Decoder()
+    unwrap = Unwrap()
+
+    if args.serial:
+        import serial
+        port = serial.Serial(args.input, args.baud, timeout=1)
+        try:
+            while True:
+                show(dec.feed(port.read(256)), unwrap, hz)
+                sys.stdout.flush()
+        except KeyboardInterrupt:
+            pass
+        return 0
+
+    if args.input == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.input, "rb") as f:
+            data = f.read()
+    recs = dec.feed(data)
+    dec.close()
+
+    if args.check:
+        return check(recs, dec, unwrap, args.check[0], args.check[1], hz)
+    show(recs, unwrap, hz)
+    if dec.resyncs or dec.skipped:
+        print("%d registros corruptos, %d bytes descartados" % (dec.resyncs, dec.skipped), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,17 @@
+/*
+ * board.h (port POSIX)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef BOARD_H_
+#define BOARD_H_
+
+#ifndef BOARD_DEBUG_UART_BAUDRATE
+#define BOARD_DEBUG_UART_BAUDRATE   115200U
+#endif
+
+void BOARD_InitDebugConsole(void);
+
+#endif /* BOARD_H_ */
@@ -0,0 +1,86 @@
+/*
+ * board_posix.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * La "tarjeta" para correr freertos_queue.c en Linux: el contador de ciclos
+ * y la UART de debug. DbgConsole_SendDataReliable ocupa la CPU lo que la
+ * UART tarda en sacar los bytes a BOARD_DEBUG_UART_BAUDRATE (8N1), como el
+ * envío por polling del SDK, y los descarta: el texto del reporte sale por
+ * PRINTF. Con BOARD_UART_CAPTURE=archivo en el ambiente los bytes se guardan
+ * ahí, para pasarlos por binlog_decode.py.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "fsl_device_registers.h"
+#include "board.h"
+
+/* Reloj de la K64F en el proyecto (BOARD_BootClockRUN) */
+uint32_t SystemCoreClock = 120000000U;
+
+posix_coredebug_t g_posix_coredebug;
+__thread uint32_t g_posix_excl;
+
+static posix_dwt_t s_dwt;
+static FILE       *s_uart_capture;
+
+/* ======= Helpers ======= */
+static uint64_t prv_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/* ======= API ======= */
+posix_dwt_t *POSIX_Dwt(void)
+{
+    s_dwt.CYCCNT = (uint32_t)((prv_now_ns() * (SystemCoreClock / 1000000U)) / 1000U);
+    return &s_dwt;
+}
+
+void BOARD_InitDebugConsole(void)
+{
+    const char *path = getenv("BOARD_UART_CAPTURE");
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    if ((path != NULL) && (path[0] != '\0'))
+    {
+        s_uart_capture = fopen(path, "wb");
+        if (s_uart_capture == NULL)
+        {
+            perror(path);
+            exit(2);
+        }
+    }
+}
+
+int DbgConsole_SendDataReliable(uint8_t *ch, size_t size)
+{
+    uint64_t end = prv_now_ns() + (((uint64_t)size * 10U * 1000000000U) / BOARD_DEBUG_UART_BAUDRATE);
+
+    if (s_uart_capture != NULL)
+    {
+        (void)fwrite(ch, 1U, size, s_uart_capture);
+        (void)fflush(s_uart_capture);
+    }
+    while (prv_now_ns() < end)
+    {
+    }
+    return 0;
+}
+
+void vAssertCalled(const char *file, unsigned long line)
+{
+    fprintf(stderr, "configASSERT: %s:%lu\n", file, line);
+    abort();
+}
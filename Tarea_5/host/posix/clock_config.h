@@ -0,0 +1,15 @@
+/*
+ * clock_config.h (port POSIX)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef CLOCK_CONFIG_H_
+#define CLOCK_CONFIG_H_
+
+static inline void BOARD_InitBootClocks(void)
+{
+}
+
+#endif /* CLOCK_CONFIG_H_ */
@@ -0,0 +1,18 @@
+/*
+ * fsl_debug_console.h (port POSIX)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * PRINTF va a stdout; DbgConsole_SendDataReliable (board_posix.c) modela el
+ * tiempo de la UART de debug.
+ */
+
+#ifndef FSL_DEBUG_CONSOLE_H_
+#define FSL_DEBUG_CONSOLE_H_
+
+#include <stdio.h>
+
+#define PRINTF  printf
+
+#endif /* FSL_DEBUG_CONSOLE_H_ */
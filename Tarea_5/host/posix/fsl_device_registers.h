@@ -0,0 +1,64 @@
+/*
+ * fsl_device_registers.h (port POSIX)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Lo poco de CMSIS/K64F que usan freertos_queue.c y mpsc_ring.c:
+ *   - DWT->CYCCNT: reloj monotónico de Linux escalado a SystemCoreClock, de
+ *     32 bits como en la tarjeta (da la vuelta igual). Escribirlo no lo
+ *     reinicia; solo se usan diferencias.
+ *   - LDREX/STREX: STREX es un compare-and-swap contra lo leído por el
+ *     LDREX del mismo hilo; falla si otra tarea movió el valor en medio.
+ */
+
+#ifndef FSL_DEVICE_REGISTERS_H_
+#define FSL_DEVICE_REGISTERS_H_
+
+#include <stdint.h>
+
+extern uint32_t SystemCoreClock;
+
+/* ======= DWT / CoreDebug ======= */
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} posix_dwt_t;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} posix_coredebug_t;
+
+/* Cada acceso a DWT actualiza CYCCNT antes de leerlo */
+posix_dwt_t *POSIX_Dwt(void);
+extern posix_coredebug_t g_posix_coredebug;
+
+#define DWT                         (POSIX_Dwt())
+#define CoreDebug                   (&g_posix_coredebug)
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+
+/* ======= Intrínsecos ======= */
+extern __thread uint32_t g_posix_excl;
+
+static inline uint32_t __LDREXW(volatile uint32_t *addr)
+{
+    g_posix_excl = __atomic_load_n(addr, __ATOMIC_SEQ_CST);
+    return g_posix_excl;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *addr)
+{
+    uint32_t expected = g_posix_excl;
+
+    return __atomic_compare_exchange_n(addr, &expected, value, false,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? 0U : 1U;
+}
+
+#define __CLREX()   do { } while (0)
+#define __DMB()     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __CLZ(x)    ((uint32_t)__builtin_clz(x))
+
+#endif /* FSL_DEVICE_REGISTERS_H_ */
@@ -0,0 +1,15 @@
+/*
+ * pin_mux.h (port POSIX)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef PIN_MUX_H_
+#define PIN_MUX_H_
+
+static inline void BOARD_InitBootPins(void)
+{
+}
+
+#endif /* PIN_MUX_H_ */
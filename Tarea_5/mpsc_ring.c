@@ -0,0 +1,79 @@
+/*
+ * mpsc_ring.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include <string.h>
+#include "mpsc_ring.h"
+#include "fsl_device_registers.h"   /* __LDREXW/__STREXW/__DMB (CMSIS) */
+
+bool MPSC_Init(mpsc_ring_t *r, void *storage, volatile uint32_t *seq, uint32_t slots, uint32_t item_size)
+{
+    if ((slots == 0U) || ((slots & (slots - 1U)) != 0U) || (item_size == 0U))
+    {
+        return false;
+    }
+
+    r->head      = 0U;
+    r->tail      = 0U;
+    r->mask      = slots - 1U;
+    r->item_size = item_size;
+    r->storage   = (uint8_t *)storage;
+    r->seq       = seq;
+    for (uint32_t i = 0; i < slots; i++)
+    {
+        seq[i] = 0U;    /* la posición i espera seq = i + 1: nada publicado */
+    }
+    return true;
+}
+
+void *MPSC_Reserve(mpsc_ring_t *r, uint32_t *pos, uint32_t *occupancy)
+{
+    uint32_t p;
+
+    /* fetch-add condicionado a que haya lugar; reintenta si otro productor
+       (u otra interrupción) tocó head entre LDREX y STREX */
+    do
+    {
+        p = __LDREXW(&r->head);
+        if ((p - r->tail) > r->mask)
+        {
+            __CLREX();
+            return NULL;
+        }
+    } while (__STREXW(p + 1U, &r->head) != 0U);
+
+    *pos       = p;
+    *occupancy = p + 1U - r->tail;
+    return &r->storage[(p & r->mask) * r->item_size];
+}
+
+void MPSC_Commit(mpsc_ring_t *r, uint32_t pos)
+{
+    /* Los datos deben verse antes que la secuencia */
+    __DMB();
+    r->seq[pos & r->mask] = pos + 1U;
+}
+
+bool MPSC_Pop(mpsc_ring_t *r, void *item)
+{
+    uint32_t t = r->tail;
+
+    /* Reservada pero sin publicar todavía: el consumidor espera en orden */
+    if (r->seq[t & r->mask] != t + 1U)
+    {
+        return false;
+    }
+    __DMB();
+    memcpy(item, &r->storage[(t & r->mask) * r->item_size], r->item_size);
+    __DMB();
+    r->tail = t + 1U;   /* libera la ranura para los productores */
+    return true;
+}
+
+uint32_t MPSC_Count(const mpsc_ring_t *r)
+{
+    return r->head - r->tail;
+}
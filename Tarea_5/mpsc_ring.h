@@ -0,0 +1,42 @@
+/*
+ * mpsc_ring.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Anillo lock-free de varios productores y un consumidor, con ranuras de
+ * tamaño fijo. Los productores reservan una ranura con LDREX/STREX sobre
+ * head, escriben ahí directamente y la publican con su número de secuencia;
+ * el consumidor solo lee ranuras ya publicadas, en orden. Ninguna operación
+ * entra al kernel ni deshabilita interrupciones.
+ */
+
+#ifndef MPSC_RING_H_
+#define MPSC_RING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    volatile uint32_t head;     /* siguiente posición a reservar (productores) */
+    volatile uint32_t tail;     /* siguiente posición a leer (consumidor) */
+    uint32_t mask;              /* slots - 1, slots potencia de 2 */
+    uint32_t item_size;
+    uint8_t *storage;           /* slots * item_size bytes */
+    volatile uint32_t *seq;     /* por ranura: posición + 1 cuando ya está escrita */
+} mpsc_ring_t;
+
+/* slots debe ser potencia de 2; seq[] con slots elementos */
+bool MPSC_Init(mpsc_ring_t *r, void *storage, volatile uint32_t *seq, uint32_t slots, uint32_t item_size);
+
+/* Productor: reserva una ranura (NULL si el anillo está lleno). *pos y
+ * *occupancy (ocupación contando esta ranura) sirven para decidir si avisar
+ * al consumidor. Escribir en el puntero y luego llamar MPSC_Commit(pos). */
+void *MPSC_Reserve(mpsc_ring_t *r, uint32_t *pos, uint32_t *occupancy);
+void  MPSC_Commit(mpsc_ring_t *r, uint32_t pos);
+
+/* Consumidor (uno solo): copia la siguiente ranura publicada */
+bool MPSC_Pop(mpsc_ring_t *r, void *item);
+uint32_t MPSC_Count(const mpsc_ring_t *r);
+
+#endif /* MPSC_RING_H_ */
@@ -316,3 +316,38 @@ void LCD_nokia_clear_range_FrameBuffer(uint8_t x, uint8_t y, uint16_t bytes){
         ptr[index] = 0;
     }
 }
+
+/*Sends columns x0..x1 of every bank as a single SPI burst. Vertical addressing
+ *makes a full-height column range contiguous in LCD RAM, so only the changed
+ *part of the screen goes out*/
+void LCD_nokia_send_columns_FB(uint8_t x0, uint8_t x1){
+    static uint8_t burst[FRAMEBUFF_TOTAL_SIZE];
+    dspi_transfer_t masterXfer;
+    uint16_t count = 0;
+    uint8_t x;
+    uint8_t bank;
+
+    if(x1>(FRAMEBUFF_HOR_SIZE-1)){
+        x1 = FRAMEBUFF_HOR_SIZE-1;
+    }
+    if(x0>x1){
+        return;
+    }
+    for(x=x0;x<=x1;x++){
+        for(bank=0;bank<FRAMEBUFF_VER_SIZE;bank++){
+            burst[count++] = LCDFrameBuffer[bank][x];
+        }
+    }
+
+    LCD_nokia_write_byte(LCD_CMD, 0x22); //Vertical addressing
+    LCD_nokia_goto_xy(x0, 0);
+
+    GPIO_PortSet(GPIO_DATA_OR_CMD_PIN, 1u << DATA_OR_CMD_PIN);
+    masterXfer.txData      = burst;
+    masterXfer.rxData      = NULL;
+    masterXfer.dataSize    = count;
+    masterXfer.configFlags = kDSPI_MasterCtar0 | kDSPI_MasterPcs0 | kDSPI_MasterPcsContinuous;
+    DSPI_MasterTransferBlocking(SPI0, &masterXfer);
+
+    LCD_nokia_write_byte(LCD_CMD, 0x20); //Back to horizontal addressing
+}
@@ -54,5 +54,7 @@ void LCD_nokia_clear_pixel(uint8_t x, uint8_t y);
 void LCD_nokia_sent_FrameBuffer();
 /*Clear x number of bytes from x,y point*/
 void LCD_nokia_clear_range_FrameBuffer(uint8_t x, uint8_t y, uint16_t bytes);
+/*Sends columns x0..x1 (all banks) of the FrameBuffer in one SPI burst*/
+void LCD_nokia_send_columns_FB(uint8_t x0, uint8_t x1);
 
 #endif /* LCD_NOKIA_H_ */
@@ -0,0 +1,249 @@
+/*
+ * alarm_sched.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "alarm_sched.h"
+#include "time_service.h"
+
+#define ALARM_NONE      0xFFU
+#define SECONDS_PER_DAY 86400U
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    alarm_spec_t spec;
+    uint32_t     next;      /* siguiente disparo (epoch) */
+    uint8_t      link;      /* siguiente en la lista ordenada */
+    bool         used;
+} alarm_slot_t;
+
+typedef struct
+{
+    alarm_slot_t slot[ALARM_MAX];
+    uint8_t      head;      /* la más próxima; es la programada en el RTC */
+    TaskHandle_t hWorker;
+} alarm_ctx_t;
+
+static alarm_ctx_t s_alarm;
+
+/* ======= Prototipos locales ======= */
+static uint32_t prv_NextFire(const alarm_spec_t *spec, uint32_t now);
+static void     prv_Insert(uint8_t id);
+static void     prv_Unlink(uint8_t id);
+static void     prv_Arm(void);
+
+/* ======= Helpers ======= */
+/* Siguiente epoch > now en que toca la alarma (0 si ya no volverá a tocar) */
+static uint32_t prv_NextFire(const alarm_spec_t *spec, uint32_t now)
+{
+    uint32_t t;
+
+    if (spec->kind == ALARM_ONESHOT)
+    {
+        return (spec->when > now) ? spec->when : 0U;
+    }
+
+    t = (now - (now % SECONDS_PER_DAY)) + spec->when;
+    if (t <= now)
+    {
+        t += SECONDS_PER_DAY;
+    }
+    if (spec->kind == ALARM_DAYMASK)
+    {
+        /* A lo más 6 días de avance: la máscara tiene al menos un día */
+        while ((spec->days & ALARM_DAY(((t / SECONDS_PER_DAY) + 4U) % 7U)) == 0U)
+        {
+            t += SECONDS_PER_DAY;
+        }
+    }
+    return t;
+}
+
+/* Inserción ordenada por next; a igual next, después de las existentes */
+static void prv_Insert(uint8_t id)
+{
+    uint8_t *pp = &s_alarm.head;
+
+    while ((*pp != ALARM_NONE) && (s_alarm.slot[*pp].next <= s_alarm.slot[id].next))
+    {
+        pp = &s_alarm.slot[*pp].link;
+    }
+    s_alarm.slot[id].link = *pp;
+    *pp = id;
+}
+
+static void prv_Unlink(uint8_t id)
+{
+    uint8_t *pp = &s_alarm.head;
+
+    while (*pp != ALARM_NONE)
+    {
+        if (*pp == id)
+        {
+            *pp = s_alarm.slot[id].link;
+            return;
+        }
+        pp = &s_alarm.slot[*pp].link;
+    }
+}
+
+/* El RTC solo conoce la primera de la lista */
+static void prv_Arm(void)
+{
+    TIME_ArmAlarm((s_alarm.head != ALARM_NONE) ? s_alarm.slot[s_alarm.head].next : 0U);
+}
+
+/* ======= API ======= */
+bool ALARM_Init(TaskHandle_t worker)
+{
+    for (uint8_t i = 0; i < ALARM_MAX; i++)
+    {
+        s_alarm.slot[i].used = false;
+        s_alarm.slot[i].link = ALARM_NONE;
+    }
+    s_alarm.head    = ALARM_NONE;
+    s_alarm.hWorker = worker;
+    TIME_SetAlarmTask(worker);
+    return (worker != NULL);
+}
+
+int ALARM_Add(const alarm_spec_t *spec)
+{
+    int id = -1;
+    uint32_t next;
+
+    if ((spec->kind != ALARM_ONESHOT) && (spec->when >= SECONDS_PER_DAY))
+    {
+        return -1;
+    }
+    if ((spec->kind == ALARM_DAYMASK) && ((spec->days & ALARM_EVERYDAY) == 0U))
+    {
+        return -1;
+    }
+    next = prv_NextFire(spec, TIME_GetEpoch());
+    if (next == 0U)
+    {
+        return -1;                 /* una sola vez, en el pasado */
+    }
+
+    taskENTER_CRITICAL();
+    for (uint8_t i = 0; i < ALARM_MAX; i++)
+    {
+        if (!s_alarm.slot[i].used)
+        {
+            s_alarm.slot[i].used = true;
+            s_alarm.slot[i].spec = *spec;
+            s_alarm.slot[i].next = next;
+            prv_Insert(i);
+            id = i;
+            break;
+        }
+    }
+    if ((id >= 0) && (s_alarm.head == (uint8_t)id))
+    {
+        prv_Arm();
+    }
+    taskEXIT_CRITICAL();
+    return id;
+}
+
+bool ALARM_Remove(uint8_t id)
+{
+    bool was_head;
+
+    if ((id >= ALARM_MAX) || !s_alarm.slot[id].used)
+    {
+        return false;
+    }
+    taskENTER_CRITICAL();
+    was_head = (s_alarm.head == id);
+    prv_Unlink(id);
+    s_alarm.slot[id].used = false;
+    if (was_head)
+    {
+        prv_Arm();
+    }
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+uint32_t ALARM_Service(void)
+{
+    uint32_t fired = 0U;
+    bool again;
+
+    taskENTER_CRITICAL();
+    do
+    {
+        uint32_t now = TIME_GetEpoch();
+
+        /* Cada vencida: sacar la cabeza es O(1); la periódica vuelve a su lugar */
+        while ((s_alarm.head != ALARM_NONE) && (s_alarm.slot[s_alarm.head].next <= now))
+        {
+            uint8_t id = s_alarm.head;
+            alarm_slot_t *a = &s_alarm.slot[id];
+
+            s_alarm.head = a->link;
+            fired |= (1UL << id);
+            a->next = prv_NextFire(&a->spec, now);
+            if (a->next != 0U)
+            {
+                prv_Insert(id);
+            }
+            else
+            {
+                a->used = false;
+            }
+        }
+        prv_Arm();
+
+        /* Si la nueva cabeza venció mientras se programaba, el RTC ya no la ve */
+        again = (s_alarm.head != ALARM_NONE) && (s_alarm.slot[s_alarm.head].next <= TIME_GetEpoch());
+    } while (again);
+    taskEXIT_CRITICAL();
+
+    return fired;
+}
+
+void ALARM_Resync(void)
+{
+    uint32_t now = TIME_GetEpoch();
+
+    taskENTER_CRITICAL();
+    s_alarm.head = ALARM_NONE;
+    for (uint8_t i = 0; i < ALARM_MAX; i++)
+    {
+        alarm_slot_t *a = &s_alarm.slot[i];
+
+        if (!a->used)
+        {
+            continue;
+        }
+        /* Una sola vez que quedó en el pasado: dispara ya, en el Service del worker */
+        a->next = (a->spec.kind == ALARM_ONESHOT) ? a->spec.when : prv_NextFire(&a->spec, now);
+        prv_Insert(i);
+    }
+    prv_Arm();
+    if ((s_alarm.head != ALARM_NONE) && (s_alarm.slot[s_alarm.head].next <= now))
+    {
+        xTaskNotifyGive(s_alarm.hWorker);
+    }
+    taskEXIT_CRITICAL();
+}
+
+bool ALARM_GetNext(uint32_t *epoch)
+{
+    bool any;
+
+    taskENTER_CRITICAL();
+    any = (s_alarm.head != ALARM_NONE);
+    if (any)
+    {
+        *epoch = s_alarm.slot[s_alarm.head].next;
+    }
+    taskEXIT_CRITICAL();
+    return any;
+}
@@ -0,0 +1,63 @@
+/*
+ * alarm_sched.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Alarmas configurables en ejecución: una sola vez, diarias o por días de la
+ * semana. Las activas van en una lista ordenada por su siguiente disparo y
+ * solo la primera está programada en la alarma del RTC (TAR), así que el
+ * CPU no revisa nada cada segundo: despierta únicamente cuando vence una.
+ */
+
+#ifndef ALARM_SCHED_H_
+#define ALARM_SCHED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* ======= Configuración ======= */
+#define ALARM_MAX          8U
+
+/* Máscara de días: bit 0 = domingo .. bit 6 = sábado (igual que time_cal_t.wday) */
+#define ALARM_DAY(wday)    (1U << (wday))
+#define ALARM_WEEKDAYS     0x3EU       /* lunes a viernes */
+#define ALARM_EVERYDAY     0x7FU
+
+/* ======= Tipos ======= */
+typedef enum
+{
+    ALARM_ONESHOT = 0,   /* when = epoch; se borra sola al disparar */
+    ALARM_DAILY,         /* when = segundos del día (0..86399) */
+    ALARM_DAYMASK        /* when = segundos del día, solo los días de 'days' */
+} alarm_kind_t;
+
+typedef struct
+{
+    alarm_kind_t kind;
+    uint32_t     when;
+    uint8_t      days;   /* solo ALARM_DAYMASK */
+} alarm_spec_t;
+
+/* ======= API ======= */
+/* worker: la tarea que recibe la notificación del RTC y llama ALARM_Service */
+bool     ALARM_Init(TaskHandle_t worker);
+
+/* Regresa el id (0..ALARM_MAX-1) o -1 si no hay lugar o la alarma no es válida */
+int      ALARM_Add(const alarm_spec_t *spec);
+bool     ALARM_Remove(uint8_t id);
+
+/* Desde worker al despertar: saca las alarmas vencidas, reprograma las
+   periódicas y el RTC. Regresa la máscara de ids que dispararon */
+uint32_t ALARM_Service(void);
+
+/* Recalcula todo tras un cambio de hora con salto (TIME_Set/TIME_SetEpoch) */
+void     ALARM_Resync(void);
+
+/* Siguiente disparo (epoch); false si no hay alarmas */
+bool     ALARM_GetNext(uint32_t *epoch);
+
+#endif /* ALARM_SCHED_H_ */
@@ -0,0 +1,190 @@
+/*
+ * clock_view.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "clock_view.h"
+
+#include <stdbool.h>
+
+#include "LCD_nokia.h"
+
+#define DIGITS          6U
+#define DIGIT_W         10U
+#define DIGIT_H         32U
+#define DIGIT_BANKS     (DIGIT_H / 8U)
+#define COLON_W         2U
+#define NO_DIGIT        0xFFU
+
+/* Segmentos: bit 0 = a (arriba) .. bit 6 = g (en medio) */
+#define SEG_A  (1U << 0)
+#define SEG_B  (1U << 1)
+#define SEG_C  (1U << 2)
+#define SEG_D  (1U << 3)
+#define SEG_E  (1U << 4)
+#define SEG_F  (1U << 5)
+#define SEG_G  (1U << 6)
+
+static const uint8_t s_segments[10] =
+{
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F,          /* 0 */
+    SEG_B | SEG_C,                                          /* 1 */
+    SEG_A | SEG_B | SEG_G | SEG_E | SEG_D,                  /* 2 */
+    SEG_A | SEG_B | SEG_G | SEG_C | SEG_D,                  /* 3 */
+    SEG_F | SEG_G | SEG_B | SEG_C,                          /* 4 */
+    SEG_A | SEG_F | SEG_G | SEG_C | SEG_D,                  /* 5 */
+    SEG_A | SEG_F | SEG_G | SEG_E | SEG_C | SEG_D,          /* 6 */
+    SEG_A | SEG_B | SEG_C,                                  /* 7 */
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_E | SEG_F | SEG_G,  /* 8 */
+    SEG_A | SEG_B | SEG_C | SEG_D | SEG_F | SEG_G           /* 9 */
+};
+
+/* Columna izquierda de cada dígito (HH MM SS) y de los dos ':' */
+static const uint8_t s_digit_x[DIGITS] = {3, 15, 31, 43, 59, 71};
+static const uint8_t s_colon_x[2]      = {27, 55};
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    uint8_t shown[DIGITS];   /* lo que hay en pantalla; NO_DIGIT = redibujar */
+} clockview_ctx_t;
+
+static clockview_ctx_t s_view;
+
+/* ======= Prototipos locales ======= */
+static uint32_t prv_GlyphColumn(uint8_t segs, uint8_t col);
+static void     prv_DrawDigit(uint8_t x, uint8_t digit);
+static void     prv_DrawColon(uint8_t x);
+
+/* ======= Dibujo ======= */
+/* Pixeles encendidos (bit n = fila n) de una columna del dígito: trazos de
+   2 px; los verticales parten la altura en dos mitades de 16 filas */
+static uint32_t prv_GlyphColumn(uint8_t segs, uint8_t col)
+{
+    uint32_t bits = 0U;
+    bool left  = (col < 2U);
+    bool right = (col >= (DIGIT_W - 2U));
+
+    if (!left && !right)
+    {
+        if (segs & SEG_A) { bits |= 0x00000003UL; }
+        if (segs & SEG_G) { bits |= 0x00018000UL; }
+        if (segs & SEG_D) { bits |= 0xC0000000UL; }
+    }
+    if (left)
+    {
+        if (segs & SEG_F) { bits |= 0x0000FFFEUL; }
+        if (segs & SEG_E) { bits |= 0x7FFF0000UL; }
+    }
+    if (right)
+    {
+        if (segs & SEG_B) { bits |= 0x0000FFFEUL; }
+        if (segs & SEG_C) { bits |= 0x7FFF0000UL; }
+    }
+    return bits;
+}
+
+static void prv_DrawDigit(uint8_t x, uint8_t digit)
+{
+    uint8_t col_bytes[DIGIT_BANKS][DIGIT_W];
+
+    for (uint8_t col = 0; col < DIGIT_W; col++)
+    {
+        uint32_t bits = prv_GlyphColumn(s_segments[digit], col);
+
+        for (uint8_t bank = 0; bank < DIGIT_BANKS; bank++)
+        {
+            col_bytes[bank][col] = (uint8_t)(bits >> (8U * bank));
+        }
+    }
+    for (uint8_t bank = 0; bank < DIGIT_BANKS; bank++)
+    {
+        LCD_nokia_write_xy_FB(x, bank, col_bytes[bank], DIGIT_W);
+    }
+}
+
+/* Dos puntos de 2x2 a 1/3 y 2/3 de la altura */
+static void prv_DrawColon(uint8_t x)
+{
+    static const uint8_t dots[DIGIT_BANKS][COLON_W] = {{0x00, 0x00}, {0x06, 0x06}, {0x60, 0x60}, {0x00, 0x00}};
+
+    for (uint8_t bank = 0; bank < DIGIT_BANKS; bank++)
+    {
+        LCD_nokia_write_xy_FB(x, bank, (uint8_t *)dots[bank], COLON_W);
+    }
+}
+
+/* ======= API ======= */
+void CLOCKVIEW_Init(void)
+{
+    for (uint8_t bank = 0; bank < 6U; bank++)
+    {
+        LCD_nokia_clear_range_FrameBuffer(0, bank, LCD_X);
+    }
+    for (uint8_t i = 0; i < DIGITS; i++)
+    {
+        s_view.shown[i] = NO_DIGIT;
+    }
+    prv_DrawColon(s_colon_x[0]);
+    prv_DrawColon(s_colon_x[1]);
+}
+
+void CLOCKVIEW_Update(const time_cal_t *now)
+{
+    uint8_t digits[DIGITS];
+    uint8_t x0 = LCD_X;
+    uint8_t x1 = 0U;
+    bool first = (s_view.shown[0] == NO_DIGIT);
+
+    digits[0] = now->hour / 10U;
+    digits[1] = now->hour % 10U;
+    digits[2] = now->minute / 10U;
+    digits[3] = now->minute % 10U;
+    digits[4] = now->second / 10U;
+    digits[5] = now->second % 10U;
+
+    for (uint8_t i = 0; i < DIGITS; i++)
+    {
+        if (digits[i] != s_view.shown[i])
+        {
+            prv_DrawDigit(s_digit_x[i], digits[i]);
+            s_view.shown[i] = digits[i];
+            if (s_digit_x[i] < x0)
+            {
+                x0 = s_digit_x[i];
+            }
+            x1 = (uint8_t)(s_digit_x[i] + DIGIT_W - 1U);
+        }
+    }
+
+    /* Primera vez: también los ':' y la línea de estado, toda la pantalla */
+    if (first)
+    {
+        x0 = 0U;
+        x1 = LCD_X - 1U;
+    }
+    if (x0 <= x1)
+    {
+        LCD_nokia_send_columns_FB(x0, x1);
+    }
+}
+
+void CLOCKVIEW_SetStatus(const char *text)
+{
+    uint8_t line[CLOCKVIEW_STATUS_CHARS];
+    uint8_t i = 0;
+
+    while ((text != NULL) && (text[i] != '\0') && (i < CLOCKVIEW_STATUS_CHARS))
+    {
+        line[i] = (uint8_t)text[i];
+        i++;
+    }
+    for (; i < CLOCKVIEW_STATUS_CHARS; i++)
+    {
+        line[i] = ' ';
+    }
+    LCD_nokia_write_string_xy_FB(0, CLOCKVIEW_STATUS_BANK, line, CLOCKVIEW_STATUS_CHARS);
+    LCD_nokia_send_columns_FB(0, (uint8_t)(CLOCKVIEW_STATUS_CHARS * CHAR_LENGTH - 1U));
+}
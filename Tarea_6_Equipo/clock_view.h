@@ -0,0 +1,36 @@
+/*
+ * clock_view.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Reloj HH:MM:SS con dígitos grandes de 7 segmentos (10x32 px, bancos 0..3)
+ * y una línea de estado de texto (banco 5). Se dibuja en el framebuffer y
+ * solo se envían las columnas de los dígitos que cambiaron, en una sola
+ * ráfaga SPI: en un segundo normal, 10 columnas x 6 bancos = 60 bytes.
+ *
+ * No toma lcd_mutex: quien llama lo tiene.
+ */
+
+#ifndef CLOCK_VIEW_H_
+#define CLOCK_VIEW_H_
+
+#include <stdint.h>
+
+#include "time_service.h"
+
+/* ======= Configuración ======= */
+#define CLOCKVIEW_STATUS_BANK   5U
+#define CLOCKVIEW_STATUS_CHARS  16U     /* 84 px / 5 px por caracter */
+
+/* ======= API ======= */
+/* Limpia el framebuffer y fuerza a redibujar todo en el siguiente Update */
+void CLOCKVIEW_Init(void);
+
+/* Redibuja los dígitos que cambiaron y los envía */
+void CLOCKVIEW_Update(const time_cal_t *now);
+
+/* Texto en la línea de estado (se rellena con espacios); NULL la borra */
+void CLOCKVIEW_SetStatus(const char *text);
+
+#endif /* CLOCK_VIEW_H_ */
@@ -10,7 +10,6 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
-#include "timers.h"
 #include "semphr.h"
 
 #include "fsl_device_registers.h"
@@ -18,46 +17,35 @@
 #include "pin_mux.h"
 #include "clock_config.h"
 #include "board.h"
-#include "event_groups.h"
 
 #include "SPI.h"
 #include "LCD_nokia.h"
 #include "LCD_nokia_images.h"
+#include "time_service.h"
+#include "alarm_sched.h"
+#include "clock_view.h"
+#include "time_sync.h"
 #include <stdio.h>
 
-// Definición de banderas para el grupo de eventos
-#define BIT_SECONDS (1 << 0)
-#define BIT_MINUTES (1 << 1)
-#define BIT_HOURS   (1 << 2)
+// Segundos del día de una hora HH:MM:SS
+#define TIME_OF_DAY(h, m, s) ((uint32_t)(h) * 3600U + (uint32_t)(m) * 60U + (uint32_t)(s))
 
-// Hora preestablecida para disparar la alarma
-#define ALARM_SECONDS 10
-#define ALARM_MINUTES 9
-#define ALARM_HOURS   9
+// Alarmas al arrancar; en ejecución se agregan/quitan con ALARM_Add/ALARM_Remove
+static const alarm_spec_t default_alarms[] = {
+    { ALARM_DAILY,   TIME_OF_DAY(9, 9, 10), 0 },              // la de siempre: 09:09:10 diario
+    { ALARM_DAYMASK, TIME_OF_DAY(7, 0, 0),  ALARM_WEEKDAYS }, // 07:00:00 de lunes a viernes
+};
 
 // Objetos de sincronización y comunicación de FreeRTOS
-SemaphoreHandle_t seconds_semaphore;
-SemaphoreHandle_t minutes_semaphore;
-SemaphoreHandle_t hours_semaphore;
-QueueHandle_t time_queue;
-EventGroupHandle_t event_group;
+QueueHandle_t time_queue;       // buzón de 1: siempre la hora más reciente
 SemaphoreHandle_t lcd_mutex;
-TimerHandle_t timer_1s;
+TaskHandle_t clock_handle;
+TaskHandle_t alarm_handle;
 
-// Prototipos de tareas y callback del timer
-void seconds_thread(void *pvParameters);
-void minutes_thread(void *pvParameters);
-void hours_thread(void *pvParameters);
+// Prototipos de tareas
+void clock_thread(void *pvParameters);
 void print_thread(void *pvParameters);
 void alarm_thread(void *pvParameters);
-void timer_callback(TimerHandle_t xTimer);
-
-// Estructura para enviar mensajes de tiempo por la cola
-typedef enum { seconds_type, minutes_type, hours_type } time_types_t;
-typedef struct {
-    time_types_t time_type;
-    uint8_t value;
-} time_msg_t;
 
 int main(void)
 {
@@ -73,142 +61,72 @@ int main(void)
     //LCD_nokia_bitmap(ITESO);
     vTaskDelay(pdMS_TO_TICKS(2000));
     LCD_nokia_clear();
+    CLOCKVIEW_Init();
 
-    // semaforos, cola, grupo de eventos y mutex
-    seconds_semaphore = xSemaphoreCreateBinary();
-    minutes_semaphore = xSemaphoreCreateBinary();
-    hours_semaphore = xSemaphoreCreateBinary();
-    time_queue = xQueueCreate(10, sizeof(time_msg_t));
-    event_group = xEventGroupCreate();
+    // cola y mutex
+    time_queue = xQueueCreate(1, sizeof(time_cal_t));
     lcd_mutex = xSemaphoreCreateMutex();
 
-    // Creación del timer de 1 segundo con auto-reload
-    timer_1s = xTimerCreate("Timer1s", pdMS_TO_TICKS(1000), pdTRUE, NULL, timer_callback);
-    xTimerStart(timer_1s, 0);
-
     // Creación de tareas con sus respectivas prioridades
-    xTaskCreate(seconds_thread, "Seconds", configMINIMAL_STACK_SIZE + 100, NULL, 1, NULL);
-    xTaskCreate(minutes_thread, "Minutes", configMINIMAL_STACK_SIZE + 100, NULL, 1, NULL);
-    xTaskCreate(hours_thread, "Hours", configMINIMAL_STACK_SIZE + 100, NULL, 1, NULL);
+    xTaskCreate(clock_thread, "Clock", configMINIMAL_STACK_SIZE + 100, NULL, 1, &clock_handle);
     xTaskCreate(print_thread, "Print", configMINIMAL_STACK_SIZE + 100, NULL, 2, NULL);
-    xTaskCreate(alarm_thread, "Alarm", configMINIMAL_STACK_SIZE + 100, NULL, 3, NULL);
+    xTaskCreate(alarm_thread, "Alarm", configMINIMAL_STACK_SIZE + 100, NULL, 3, &alarm_handle);
+
+    // El RTC cuenta los segundos y notifica a clock_thread una vez por segundo;
+    // su alarma (TAR) despierta a alarm_thread solo cuando vence la más próxima
+    TIME_Init(clock_handle);
+    ALARM_Init(alarm_handle);
+    for (uint32_t i = 0; i < sizeof(default_alarms) / sizeof(default_alarms[0]); i++) {
+        ALARM_Add(&default_alarms[i]);
+    }
+
+    // Hora y frecuencia del RTC ajustadas contra la PC por la UART de debug
+    TSYNC_Init(1);
 
     vTaskStartScheduler();
 
     while (1) {}
 }
 
-// Callback del timer libera el semáforo de segundos cada segundo
-void timer_callback(TimerHandle_t xTimer) {
-    xSemaphoreGive(seconds_semaphore);
-}
-
-// Tarea que cuenta segundos y dispara eventos cuando corresponde
-void seconds_thread(void *pvParameters) {
-    uint8_t seconds = 0;
-    time_msg_t msg;
-
-    for (;;) {
-        xSemaphoreTake(seconds_semaphore, portMAX_DELAY);
-        seconds++;
-        if (seconds == 60) {
-            seconds = 0;
-            xSemaphoreGive(minutes_semaphore);
-        }
-
-        if (seconds == ALARM_SECONDS) {
-            xEventGroupSetBits(event_group, BIT_SECONDS);
-        }
-
-        msg.time_type = seconds_type;
-        msg.value = seconds;
-        xQueueSend(time_queue, &msg, 0);
-    }
-}
-
-// Tarea que cuenta minutos y dispara eventos cuando corresponde
-void minutes_thread(void *pvParameters) {
-    uint8_t minutes = 0;
-    time_msg_t msg;
-
-    for (;;) {
-        xSemaphoreTake(minutes_semaphore, portMAX_DELAY);
-        minutes++;
-        if (minutes == 60) {
-            minutes = 0;
-            xSemaphoreGive(hours_semaphore);
-        }
-
-        if (minutes == ALARM_MINUTES) {
-            xEventGroupSetBits(event_group, BIT_MINUTES);
-        }
-
-        msg.time_type = minutes_type;
-        msg.value = minutes;
-        xQueueSend(time_queue, &msg, 0);
-    }
-}
-// Tarea que cuenta horas y dispara eventos cuando corresponde
-void hours_thread(void *pvParameters) {
-    uint8_t hours = 0;
-    time_msg_t msg;
+// Tarea que despierta una vez por segundo (RTC) y publica la hora
+void clock_thread(void *pvParameters) {
+    time_cal_t now;
 
     for (;;) {
-        xSemaphoreTake(hours_semaphore, portMAX_DELAY);
-        hours++;
-        if (hours == 24) {
-            hours = 0;
-        }
-
-        if (hours == ALARM_HOURS) {
-            xEventGroupSetBits(event_group, BIT_HOURS);
-        }
-
-        msg.time_type = hours_type;
-        msg.value = hours;
-        xQueueSend(time_queue, &msg, 0);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        TIME_Get(&now);
+        xQueueOverwrite(time_queue, &now);
     }
 }
-// Tarea que recibe mensajes de tiempo y actualiza la pantalla LCD
+// Tarea que recibe la hora y actualiza la pantalla LCD: solo los dígitos que
+// cambiaron, en una ráfaga SPI
 void print_thread(void *pvParameters) {
-    time_msg_t msg;
-    uint8_t hours = 0, minutes = 0, seconds = 0;
-    char buffer[16];
+    time_cal_t now;
 
     for (;;) {
-        if (xQueueReceive(time_queue, &msg, portMAX_DELAY) == pdPASS) {
-            switch (msg.time_type) {
-                case seconds_type: seconds = msg.value; break;
-                case minutes_type: minutes = msg.value; break;
-                case hours_type:   hours = msg.value; break;
-            }
-
-            // Formatear la hora como HH:MM:SS
-            snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d", hours, minutes, seconds);
-
-            // Mostrar la hora en la primera línea de la pantalla
+        if (xQueueReceive(time_queue, &now, portMAX_DELAY) == pdPASS) {
             xSemaphoreTake(lcd_mutex, portMAX_DELAY);
-            LCD_nokia_goto_xy(0, 0);
-            LCD_nokia_send_string((uint8_t *)buffer);
+            CLOCKVIEW_Update(&now);
             xSemaphoreGive(lcd_mutex);
         }
     }
 }
-// Tarea que espera que las tres banderas estén activadas para mostrar "ALARM"
+// Tarea que atiende la alarma del RTC: solo despierta cuando vence una
 void alarm_thread(void *pvParameters) {
-    const EventBits_t all_flags = BIT_SECONDS | BIT_MINUTES | BIT_HOURS;
+    char buffer[16];
 
     for (;;) {
-        // Espera hasta que las tres condiciones de tiempo coincidan con la alarma
-        xEventGroupWaitBits(event_group, all_flags, pdTRUE, pdTRUE, portMAX_DELAY);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t fired = ALARM_Service();
 
-        // Mostrar "ALARM" en la segunda línea de la pantalla
+        if (fired == 0) {
+            continue;
+        }
+
+        // Mostrar "ALARM n" (la de id más bajo) en la línea de estado
+        snprintf(buffer, sizeof(buffer), "ALARM %u", (unsigned)__builtin_ctz(fired));
         xSemaphoreTake(lcd_mutex, portMAX_DELAY);
-        LCD_nokia_goto_xy(0, 1);
-        LCD_nokia_send_string((uint8_t *)"ALARM");
+        CLOCKVIEW_SetStatus(buffer);
         xSemaphoreGive(lcd_mutex);
-
     }
 }
-
-
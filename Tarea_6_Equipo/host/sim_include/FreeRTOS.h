@@ -0,0 +1,37 @@
+/*
+ * FreeRTOS.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Sustituto mínimo para correr time_sync.c y time_service.c en la PC con
+ * tsync_sim.c: una sola tarea, el tiempo lo avanza el simulador (tick de
+ * 200 Hz como en ../FreeRTOSConfig.h) y no hay secciones críticas.
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t      TickType_t;
+typedef long          BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdTRUE   1
+#define pdFALSE  0
+#define pdPASS   pdTRUE
+#define pdFAIL   pdFALSE
+
+#define configTICK_RATE_HZ                           200U
+#define configMINIMAL_STACK_SIZE                     90U
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY 2U
+#define portMAX_DELAY                                ((TickType_t)0xFFFFFFFFU)
+#define pdMS_TO_TICKS(ms)                            ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000U))
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define portYIELD_FROM_ISR(x)                        ((void)(x))
+
+#endif /* FREERTOS_H */
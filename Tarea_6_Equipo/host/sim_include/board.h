@@ -0,0 +1,13 @@
+/*
+ * board.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef BOARD_H_
+#define BOARD_H_
+
+#define BOARD_DEBUG_UART_BAUDRATE   115200U
+
+#endif /* BOARD_H_ */
@@ -0,0 +1,21 @@
+/*
+ * fsl_clock.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef FSL_CLOCK_H_
+#define FSL_CLOCK_H_
+
+typedef enum
+{
+    kCLOCK_Rtc0
+} clock_ip_name_t;
+
+static inline void CLOCK_EnableClock(clock_ip_name_t name)
+{
+    (void)name;
+}
+
+#endif /* FSL_CLOCK_H_ */
@@ -0,0 +1,78 @@
+/*
+ * fsl_device_registers.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * RTC y UART0 de la K64F simulados por tsync_sim.c. Cada acceso a RTC o a
+ * UART0 pasa por el simulador: aplica lo que el código escribió desde el
+ * acceso anterior (TSR/TPR/TCR, un byte en D) y publica la cuenta del RTC
+ * al instante simulado actual.
+ */
+
+#ifndef FSL_DEVICE_REGISTERS_H_
+#define FSL_DEVICE_REGISTERS_H_
+
+#include <stdint.h>
+
+/* ======= RTC ======= */
+typedef struct
+{
+    volatile uint32_t TSR;
+    volatile uint32_t TPR;
+    volatile uint32_t TAR;
+    volatile uint32_t TCR;
+    volatile uint32_t CR;
+    volatile uint32_t SR;
+    volatile uint32_t IER;
+} RTC_Type;
+
+#define RTC_SR_TIF_MASK         0x01U
+#define RTC_SR_TAF_MASK         0x04U
+#define RTC_SR_TCE_MASK         0x10U
+#define RTC_CR_OSCE_MASK        0x100U
+#define RTC_IER_TAIE_MASK       0x04U
+#define RTC_IER_TSIE_MASK       0x10U
+#define RTC_TCR_TCR(x)          ((uint32_t)(x) & 0xFFU)
+#define RTC_TCR_CIR(x)          (((uint32_t)(x) & 0xFFU) << 8)
+
+/* ======= UART ======= */
+typedef struct
+{
+    volatile uint8_t  S1;
+    volatile uint16_t D;        /* SIM_UART_IDLE = nada escrito */
+    volatile uint8_t  C2;
+} UART_Type;
+
+#define SIM_UART_IDLE           0x100U
+#define UART_S1_TDRE_MASK       0x80U
+#define UART_S1_TC_MASK         0x40U
+#define UART_S1_RDRF_MASK       0x20U
+#define UART_S1_OR_MASK         0x08U
+#define UART_C2_RIE_MASK        0x20U
+
+RTC_Type  *SIM_Rtc(void);
+UART_Type *SIM_Uart(void);
+
+#define RTC                     (SIM_Rtc())
+#define UART0                   (SIM_Uart())
+
+/* ======= NVIC ======= */
+typedef enum
+{
+    RTC_IRQn,
+    RTC_Seconds_IRQn,
+    UART0_RX_TX_IRQn
+} IRQn_Type;
+
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t prio)
+{
+    (void)irq; (void)prio;
+}
+
+static inline void EnableIRQ(IRQn_Type irq)
+{
+    (void)irq;
+}
+
+#endif /* FSL_DEVICE_REGISTERS_H_ */
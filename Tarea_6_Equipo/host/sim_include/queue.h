@@ -0,0 +1,24 @@
+/*
+ * queue.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * xQueueReceive es donde la tarea espera: ahí tsync_sim.c hace correr al
+ * host simulado, que contesta por la ISR de la UART.
+ */
+
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include "FreeRTOS.h"
+
+typedef struct sim_queue *QueueHandle_t;
+
+/* En tsync_sim.c */
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+BaseType_t    xQueueReset(QueueHandle_t q);
+BaseType_t    xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks);
+BaseType_t    xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *woken);
+
+#endif /* QUEUE_H */
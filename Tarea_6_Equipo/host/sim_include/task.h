@@ -0,0 +1,37 @@
+/*
+ * task.h (host)
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+/* En tsync_sim.c */
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t depth, void *param,
+                       UBaseType_t prio, TaskHandle_t *handle);
+TickType_t xTaskGetTickCount(void);
+void       vTaskDelay(TickType_t ticks);
+
+/* Una sola tarea: suspender el scheduler no cambia nada */
+static inline void vTaskSuspendAll(void)
+{
+}
+
+static inline BaseType_t xTaskResumeAll(void)
+{
+    return pdFALSE;
+}
+
+static inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken)
+{
+    (void)task; (void)woken;
+}
+
+#endif /* TASK_H */
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+#
+# tsync_ref.py
+#
+#  Created on: 19 oct 2026
+#      Author: luisg
+#
+# Referencia de hora para time_sync.c: escucha la UART de debug, deja pasar
+# el texto de PRINTF a stdout y contesta cada "$TQ" con la hora de la PC.
+#
+#   tarjeta -> PC:  "$TQ <seq> <offset_us> <freq_ppb>\r\n"
+#   PC -> tarjeta:  "$TR <seq> <t2_ms> <t3_ms>\n"
+#
+# t2 se toma al recibir la línea y t3 justo antes de escribir la respuesta,
+# en ms desde 1970 en hora local (time_service.c guarda la hora local).
+# El "$TQ" se busca en cualquier parte de la línea: un PRINTF de otra tarea
+# puede quedar partido alrededor de la pregunta.
+#
+#   tsync_ref.py /dev/ttyACM0 [--csv sync.csv] [--utc]   (requiere pyserial)
+#
+#   --csv archivo   una línea por pregunta: t_s, seq, offset_us, freq_ppb
+#   --utc           contestar en UTC en vez de hora local
+
+import argparse
+import re
+import sys
+import time
+
+TQ = re.compile(rb"\$TQ (\d+) (-?\d+) (-?\d+)")
+
+
+def now_ms(utc):
+    """ms desde 1970 en la hora que guarda la tarjeta"""
+    t = time.time()
+    if utc:
+        return int(t * 1000)
+    return int((t + time.localtime(t).tm_gmtoff) * 1000)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Referencia de hora para time_sync.h")
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--csv")
+    ap.add_argument("--utc", action="store_true")
+    args = ap.parse_args()
+
+    import serial
+    port = serial.Serial(args.port, args.baud, timeout=1)
+    csv = open(args.csv, "w") if args.csv else None
+    if csv:
+        csv.write("t_s,seq,offset_us,freq_ppb\n")
+    t0 = time.time()
+
+    try:
+        while True:
+            line = port.readline()
+            if not line:
+                continue
+            t2 = now_ms(args.utc)
+            m = TQ.search(line)
+            if m is None:
+                sys.stdout.buffer.write(line)
+                sys.stdout.buffer.flush()
+                continue
+            seq, offset_us, freq_ppb = (int(v) for v in m.groups())
+            t3 = now_ms(args.utc)
+            port.write(b"$TR %d %d %d\n" % (seq, t2, t3))
+
+            # Lo que quede del PRINTF partido alrededor de la pregunta
+            rest = line[:m.start()] + line[m.end():].lstrip(b"\r\n")
+            if rest.strip():
+                sys.stdout.buffer.write(rest)
+            print("[tsync] seq %d  offset %+d us  freq %+.3f ppm" % (seq, offset_us, freq_ppb / 1000.0))
+            sys.stdout.flush()
+            if csv:
+                csv.write("%.3f,%d,%d,%d\n" % (time.time() - t0, seq, offset_us, freq_ppb))
+                csv.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if csv:
+            csv.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
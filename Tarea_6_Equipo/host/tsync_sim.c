@@ -0,0 +1,438 @@
+/*
+ * tsync_sim.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Corre time_sync.c y time_service.c tal cual contra un RTC, una UART y una
+ * PC simulados, 24 h de tiempo simulado en unos segundos:
+ *   - cristal de 32.768 kHz con error fijo (ppm) y una deriva diaria de
+ *     +/-2 ppm (temperatura); el RTC cuenta sus ciclos con la compensación
+ *     TCR/CIR que escribe TIME_SetRatePpb;
+ *   - la UART saca y recibe un byte cada 10 bits a 115200;
+ *   - la PC (la referencia, hora exacta) contesta como host/tsync_ref.py:
+ *     t2/t3 truncados a ms, 0-1 ms de latencia del USB-serial en cada
+ *     sentido, 1% de respuestas perdidas y 1% con 30 ms de más en un sentido.
+ * Cada segundo simulado se compara la hora del RTC (como la lee TIME_GetUs)
+ * contra la referencia. Reporta por hora y falla si en las últimas 12 h el
+ * error pasa de TSIM_PASS_MAX_US.
+ *
+ * Uso: tsync_sim [error del cristal en ppm] [semilla]
+ */
+
+#include <math.h>
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "fsl_device_registers.h"
+#include "board.h"
+
+#include "time_service.h"
+#include "time_sync.h"
+
+#define TSIM_START_NS        (1792411200ULL * 1000000000ULL)   /* 2026-10-19 12:00 local */
+#define TSIM_DAY_S           86400U
+#define TSIM_WANDER_PPM      2.0
+#define TSIM_LATENCY_NS      1000000ULL     /* 0..1 ms por sentido */
+#define TSIM_HOST_PROC_NS    200000ULL      /* PC: de t2 a t3 */
+#define TSIM_SPIKE_NS        30000000ULL
+#define TSIM_PASS_MAX_US     1000.0
+#define TSIM_BYTE_NS         ((10ULL * 1000000000ULL) / BOARD_DEBUG_UART_BAUDRATE)
+
+/* ======= Mundo simulado ======= */
+typedef struct
+{
+    /* RTC */
+    uint32_t tsr;
+    uint32_t pos;           /* ciclos dentro del segundo en curso */
+    uint32_t len;           /* ciclos del segundo en curso */
+    uint32_t cir;
+    int32_t  tcr;
+    uint32_t cic;           /* segundos hasta el compensado */
+    bool     running;
+    double   cycle_frac;
+    double   ppm;
+    /* Tiempo y host */
+    uint64_t now_ns;        /* referencia: hora exacta de la PC */
+    uint64_t start_ns;
+    bool     req_pending;
+    uint32_t req_seq;
+    uint64_t req_ns;        /* último bit de la pregunta en la PC */
+    char     tx[64];
+    uint8_t  tx_len;
+    bool     rx_active;
+    uint32_t rng;
+} sim_world_t;
+
+typedef struct
+{
+    double   max_us;
+    double   sum_sq;
+    uint32_t n;
+} sim_stats_t;
+
+struct sim_queue
+{
+    uint8_t     item[64];
+    UBaseType_t size;
+    bool        full;
+};
+
+static sim_world_t    s_w;
+static RTC_Type       s_rtc;
+static RTC_Type       s_rtc_pub;    /* lo último publicado: lo distinto lo escribió el código */
+static UART_Type      s_uart;
+static struct sim_queue s_queue;
+static TaskFunction_t s_task;
+static jmp_buf        s_done;
+static sim_stats_t    s_hour, s_tail;
+
+void UART0_RX_TX_IRQHandler(void);
+
+/* ======= Helpers ======= */
+static uint32_t prv_Rand(void)
+{
+    s_w.rng ^= s_w.rng << 13;
+    s_w.rng ^= s_w.rng >> 17;
+    s_w.rng ^= s_w.rng << 5;
+    return s_w.rng;
+}
+
+static uint64_t prv_RandNs(uint64_t max_ns)
+{
+    return ((uint64_t)prv_Rand() * max_ns) >> 32;
+}
+
+static double prv_Elapsed(void)
+{
+    return (double)(s_w.now_ns - s_w.start_ns) / 1e9;
+}
+
+/* Lo que leería TIME_GetUs: en el segundo compensado TPR arranca en TCR
+   (o se queda en 0 los primeros -TCR ciclos) y desborda en 32768 */
+static uint32_t prv_Tpr(void)
+{
+    int32_t tpr = (int32_t)s_w.pos + (32768 - (int32_t)s_w.len);
+
+    return (tpr < 0) ? 0U : (uint32_t)tpr;
+}
+
+static void prv_RtcCycles(uint64_t n)
+{
+    while (n > 0U)
+    {
+        uint32_t left = s_w.len - s_w.pos;
+
+        if (n < left)
+        {
+            s_w.pos += (uint32_t)n;
+            return;
+        }
+        n -= left;
+        s_w.pos = 0U;
+        s_w.tsr++;
+        if (s_w.cic == 0U)
+        {
+            s_w.cic = s_w.cir;
+            s_w.len = (uint32_t)(32768 - s_w.tcr);
+        }
+        else
+        {
+            s_w.cic--;
+            s_w.len = 32768U;
+        }
+    }
+}
+
+static void prv_Sample(void)
+{
+    double rtc_us = ((double)s_w.tsr * 1e6) + (((double)prv_Tpr() * 15625.0) / 512.0);
+    double err    = ((double)s_w.now_ns / 1e3) - rtc_us;
+    double a      = fabs(err);
+
+    if (a > s_hour.max_us)
+    {
+        s_hour.max_us = a;
+    }
+    s_hour.sum_sq += err * err;
+    s_hour.n++;
+    if (prv_Elapsed() > (TSIM_DAY_S / 2U))
+    {
+        if (a > s_tail.max_us)
+        {
+            s_tail.max_us = a;
+        }
+        s_tail.sum_sq += err * err;
+        s_tail.n++;
+    }
+}
+
+static void prv_Report(void)
+{
+    tsync_status_t st;
+    double e = s_w.ppm + (TSIM_WANDER_PPM * sin((2.0 * M_PI * prv_Elapsed()) / TSIM_DAY_S));
+
+    TSYNC_GetStatus(&st);
+    printf("%5.1f h  max %9.3f ms  rms %8.3f ms  cristal %+8.3f ppm  estimado %+8.3f ppm  muestras %u  rechazos %u  saltos %u\n",
+           prv_Elapsed() / 3600.0, s_hour.max_us / 1e3, sqrt(s_hour.sum_sq / (s_hour.n ? s_hour.n : 1U)) / 1e3,
+           e, -(double)st.freq_ppb / 1e3, (unsigned)st.samples, (unsigned)st.rejected, (unsigned)st.steps);
+    memset(&s_hour, 0, sizeof(s_hour));
+}
+
+/* Avanza la referencia y el cristal hasta t_ns; una muestra por segundo */
+static void prv_AdvanceTo(uint64_t t_ns)
+{
+    (void)SIM_Rtc();     /* aplica lo que el código escribió */
+
+    while (s_w.now_ns < t_ns)
+    {
+        uint64_t next = ((s_w.now_ns / 1000000000ULL) + 1U) * 1000000000ULL;
+        uint64_t step = ((next < t_ns) ? next : t_ns) - s_w.now_ns;
+        double   e    = s_w.ppm + (TSIM_WANDER_PPM * sin((2.0 * M_PI * prv_Elapsed()) / TSIM_DAY_S));
+        uint64_t n;
+
+        s_w.cycle_frac += ((double)step / 1e9) * 32768.0 * (1.0 + (e * 1e-6));
+        n = (uint64_t)s_w.cycle_frac;
+        s_w.cycle_frac -= (double)n;
+        if (s_w.running)
+        {
+            prv_RtcCycles(n);
+        }
+        s_w.now_ns += step;
+
+        if ((s_w.now_ns % 1000000000ULL) == 0U)
+        {
+            prv_Sample();
+            if (((s_w.now_ns - s_w.start_ns) % (3600ULL * 1000000000ULL)) == 0U)
+            {
+                prv_Report();
+            }
+        }
+    }
+    (void)SIM_Rtc();
+}
+
+/* Byte que la tarjeta terminó de sacar por la UART */
+static void prv_TxByte(char c)
+{
+    const char *q;
+
+    prv_AdvanceTo(s_w.now_ns + TSIM_BYTE_NS);
+    if (s_w.tx_len < (sizeof(s_w.tx) - 1U))
+    {
+        s_w.tx[s_w.tx_len++] = c;
+    }
+    if (c != '\n')
+    {
+        return;
+    }
+    s_w.tx[s_w.tx_len] = '\0';
+    s_w.tx_len = 0U;
+    q = strstr(s_w.tx, "$TQ ");
+    if (q != NULL)
+    {
+        s_w.req_seq     = (uint32_t)strtoul(q + 4, NULL, 10);
+        s_w.req_ns      = s_w.now_ns;
+        s_w.req_pending = true;
+    }
+}
+
+/* La PC contesta la pregunta pendiente; la respuesta entra byte por byte
+   por la ISR si llega antes de deadline_ns */
+static void prv_HostRespond(uint64_t deadline_ns)
+{
+    char     line[64];
+    uint64_t d1, d2, t_rx, t_tx, t;
+    int      n, i;
+    uint32_t r = prv_Rand() % 100U;
+
+    if (!s_w.req_pending || (r == 0U))
+    {
+        s_w.req_pending = false;
+        prv_AdvanceTo(deadline_ns);
+        return;
+    }
+    s_w.req_pending = false;
+
+    d1 = prv_RandNs(TSIM_LATENCY_NS) + ((r == 1U) ? TSIM_SPIKE_NS : 0U);
+    d2 = prv_RandNs(TSIM_LATENCY_NS);
+    t_rx = s_w.req_ns + d1;
+    t_tx = t_rx + TSIM_HOST_PROC_NS;
+    n = snprintf(line, sizeof(line), "$TR %u %llu %llu\n", (unsigned)s_w.req_seq,
+                 (unsigned long long)(t_rx / 1000000ULL), (unsigned long long)(t_tx / 1000000ULL));
+
+    t = t_tx + d2;
+    if ((t + ((uint64_t)n * TSIM_BYTE_NS)) > deadline_ns)
+    {
+        prv_AdvanceTo(deadline_ns);
+        return;
+    }
+    for (i = 0; i < n; i++)
+    {
+        t += TSIM_BYTE_NS;
+        prv_AdvanceTo(t);
+        s_w.rx_active = true;
+        s_uart.D  = (uint8_t)line[i];
+        s_uart.S1 = UART_S1_TDRE_MASK | UART_S1_TC_MASK | UART_S1_RDRF_MASK;
+        UART0_RX_TX_IRQHandler();
+        s_uart.D  = SIM_UART_IDLE;
+        s_uart.S1 = UART_S1_TDRE_MASK | UART_S1_TC_MASK;
+        s_w.rx_active = false;
+    }
+}
+
+/* ======= Registros ======= */
+RTC_Type *SIM_Rtc(void)
+{
+    if (s_rtc.TSR != s_rtc_pub.TSR)
+    {
+        s_w.tsr = s_rtc.TSR;
+        s_rtc.SR &= ~RTC_SR_TIF_MASK;
+    }
+    if (s_rtc.TPR != s_rtc_pub.TPR)
+    {
+        s_w.pos = s_rtc.TPR & TIME_TPR_MASK;
+        s_w.len = 32768U;
+    }
+    if (s_rtc.TCR != s_rtc_pub.TCR)
+    {
+        /* CIC sigue contando: los valores nuevos se usan al llegar a 0 */
+        s_w.cir = (s_rtc.TCR >> 8) & 0xFFU;
+        s_w.tcr = (int8_t)(s_rtc.TCR & 0xFFU);
+    }
+    s_w.running = ((s_rtc.SR & RTC_SR_TCE_MASK) != 0U);
+
+    s_rtc.TSR = s_w.tsr;
+    s_rtc.TPR = prv_Tpr();
+    s_rtc_pub = s_rtc;
+    return &s_rtc;
+}
+
+UART_Type *SIM_Uart(void)
+{
+    if (!s_w.rx_active && (s_uart.D != SIM_UART_IDLE))
+    {
+        char c = (char)s_uart.D;
+
+        s_uart.D = SIM_UART_IDLE;
+        prv_TxByte(c);
+    }
+    return &s_uart;
+}
+
+/* ======= FreeRTOS ======= */
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t depth, void *param,
+                       UBaseType_t prio, TaskHandle_t *handle)
+{
+    (void)name; (void)depth; (void)param; (void)prio;
+    s_task = fn;
+    if (handle != NULL)
+    {
+        *handle = (TaskHandle_t)&s_task;
+    }
+    return pdPASS;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)((s_w.now_ns - s_w.start_ns) / (1000000000ULL / configTICK_RATE_HZ));
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    prv_AdvanceTo(s_w.now_ns + ((uint64_t)ticks * (1000000000ULL / configTICK_RATE_HZ)));
+    if (prv_Elapsed() >= TSIM_DAY_S)
+    {
+        longjmp(s_done, 1);
+    }
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    (void)length;
+    if (item_size > sizeof(s_queue.item))
+    {
+        return NULL;
+    }
+    s_queue.size = item_size;
+    s_queue.full = false;
+    return &s_queue;
+}
+
+BaseType_t xQueueReset(QueueHandle_t q)
+{
+    q->full = false;
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *woken)
+{
+    (void)woken;
+    if (q->full)
+    {
+        return pdFAIL;
+    }
+    memcpy(q->item, item, q->size);
+    q->full = true;
+    return pdPASS;
+}
+
+/* La tarea espera aquí la respuesta: es cuando corre la PC */
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks)
+{
+    if (!q->full)
+    {
+        prv_HostRespond(s_w.now_ns + ((uint64_t)ticks * (1000000000ULL / configTICK_RATE_HZ)));
+    }
+    if (!q->full)
+    {
+        return pdFAIL;
+    }
+    memcpy(item, q->item, q->size);
+    q->full = false;
+    return pdPASS;
+}
+
+/* alarm_sched: sin alarmas en la simulación */
+void ALARM_Resync(void)
+{
+}
+
+int main(int argc, char **argv)
+{
+    double rms;
+
+    memset(&s_w, 0, sizeof(s_w));
+    s_w.ppm      = (argc > 1) ? atof(argv[1]) : 40.0;
+    s_w.rng      = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1U;
+    s_w.rng      = (s_w.rng != 0U) ? s_w.rng : 1U;
+    s_w.now_ns   = TSIM_START_NS;
+    s_w.start_ns = TSIM_START_NS;
+    s_w.len      = 32768U;
+    s_rtc.SR     = RTC_SR_TIF_MASK;          /* RTC sin hora: TIME_Init pone la de omisión */
+    s_rtc_pub    = s_rtc;
+    s_uart.D     = SIM_UART_IDLE;
+    s_uart.S1    = UART_S1_TDRE_MASK | UART_S1_TC_MASK;
+
+    printf("cristal %+.1f ppm (+/-%.0f ppm diario), semilla %u\n", s_w.ppm, TSIM_WANDER_PPM, (unsigned)s_w.rng);
+    (void)TIME_Init(NULL);
+    if (!TSYNC_Init(1) || (s_task == NULL))
+    {
+        printf("TSYNC_Init falló\n");
+        return 1;
+    }
+    if (setjmp(s_done) == 0)
+    {
+        s_task(NULL);
+    }
+
+    rms = sqrt(s_tail.sum_sq / (s_tail.n ? s_tail.n : 1U));
+    printf("últimas 12 h: max %.3f ms, rms %.3f ms\n", s_tail.max_us / 1e3, rms / 1e3);
+    return (s_tail.n > 0U) && (s_tail.max_us <= TSIM_PASS_MAX_US) ? 0 : 1;
+}
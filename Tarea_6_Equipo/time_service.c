@@ -0,0 +1,263 @@
+/*
+ * time_service.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "time_service.h"
+
+#include "fsl_device_registers.h"
+#include "fsl_clock.h"
+
+#include <stdint.h>
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    TaskHandle_t hNotify;
+    TaskHandle_t hAlarm;
+} time_ctx_t;
+
+static time_ctx_t s_time;
+
+/* ======= Prototipos locales ======= */
+static uint32_t prv_DaysFromCivil(int32_t y, uint32_t m, uint32_t d);
+static bool     prv_IsLeap(uint32_t y);
+static void     prv_WriteTime(uint32_t epoch, uint32_t tpr);
+
+/* ======= Calendario ======= */
+/* Días desde 1970-01-01 (algoritmo de H. Hinnant: años de marzo a febrero,
+   así febrero queda al final y los bisiestos no mueven el resto del año) */
+static uint32_t prv_DaysFromCivil(int32_t y, uint32_t m, uint32_t d)
+{
+    uint32_t era, yoe, doy, doe;
+
+    y  -= (m <= 2U) ? 1 : 0;
+    era = (uint32_t)(y / 400);
+    yoe = (uint32_t)(y - (int32_t)(era * 400U));                       /* 0..399 */
+    doy = ((153U * ((m > 2U) ? (m - 3U) : (m + 9U))) + 2U) / 5U + d - 1U;  /* 0..365 */
+    doe = (yoe * 365U) + (yoe / 4U) - (yoe / 100U) + doy;               /* 0..146096 */
+    return (era * 146097U) + doe - 719468U;
+}
+
+static bool prv_IsLeap(uint32_t y)
+{
+    return ((y % 4U) == 0U) && (((y % 100U) != 0U) || ((y % 400U) == 0U));
+}
+
+void TIME_EpochToCal(uint32_t epoch, time_cal_t *cal)
+{
+    uint32_t days = epoch / 86400U;
+    uint32_t secs = epoch % 86400U;
+    uint32_t z, era, doe, yoe, doy, mp;
+
+    cal->hour   = (uint8_t)(secs / 3600U);
+    cal->minute = (uint8_t)((secs / 60U) % 60U);
+    cal->second = (uint8_t)(secs % 60U);
+    cal->wday   = (uint8_t)((days + 4U) % 7U);     /* 1970-01-01 fue jueves */
+
+    z   = days + 719468U;
+    era = z / 146097U;
+    doe = z - (era * 146097U);
+    yoe = (doe - (doe / 1460U) + (doe / 36524U) - (doe / 146096U)) / 365U;
+    doy = doe - ((365U * yoe) + (yoe / 4U) - (yoe / 100U));
+    mp  = ((5U * doy) + 2U) / 153U;
+
+    cal->day   = (uint8_t)(doy - (((153U * mp) + 2U) / 5U) + 1U);
+    cal->month = (uint8_t)((mp < 10U) ? (mp + 3U) : (mp - 9U));
+    cal->year  = (uint16_t)((yoe + (era * 400U)) + ((cal->month <= 2U) ? 1U : 0U));
+}
+
+uint32_t TIME_CalToEpoch(const time_cal_t *cal)
+{
+    return (prv_DaysFromCivil(cal->year, cal->month, cal->day) * 86400U) +
+           ((uint32_t)cal->hour * 3600U) + ((uint32_t)cal->minute * 60U) + cal->second;
+}
+
+/* ======= RTC ======= */
+/* TSR y TPR solo se escriben con el contador detenido; tpr = 0 hace que el
+   siguiente segundo dure un segundo completo */
+static void prv_WriteTime(uint32_t epoch, uint32_t tpr)
+{
+    RTC->SR &= ~RTC_SR_TCE_MASK;
+    RTC->TPR = tpr;
+    RTC->TSR = epoch;
+    RTC->SR |= RTC_SR_TCE_MASK;
+}
+
+bool TIME_Init(TaskHandle_t notify_task)
+{
+    s_time.hNotify = notify_task;
+
+    CLOCK_EnableClock(kCLOCK_Rtc0);
+
+    /* Oscilador de 32 kHz; si ya corría (VBAT) la hora se conserva */
+    if ((RTC->CR & RTC_CR_OSCE_MASK) == 0U)
+    {
+        RTC->CR |= RTC_CR_OSCE_MASK;
+        for (volatile uint32_t i = 0; i < 0x600000U; i++)   /* arranque del cristal */
+        {
+        }
+    }
+
+    /* Hora inválida (primer arranque o sin batería): TIF se limpia escribiendo TSR */
+    if (RTC->SR & RTC_SR_TIF_MASK)
+    {
+        prv_WriteTime(TIME_DEFAULT_EPOCH, 0U);
+    }
+    else
+    {
+        RTC->SR |= RTC_SR_TCE_MASK;
+    }
+
+    if (s_time.hNotify != NULL)
+    {
+        RTC->IER |= RTC_IER_TSIE_MASK;
+        NVIC_SetPriority(RTC_Seconds_IRQn, TIME_IRQ_PRIORITY);
+        EnableIRQ(RTC_Seconds_IRQn);
+    }
+    return true;
+}
+
+uint32_t TIME_GetEpoch(void)
+{
+    uint32_t a, b;
+
+    /* TSR puede cambiar a media lectura: se lee hasta que dos coincidan */
+    do
+    {
+        a = RTC->TSR;
+        b = RTC->TSR;
+    } while (a != b);
+    return a;
+}
+
+void TIME_SetEpoch(uint32_t epoch)
+{
+    taskENTER_CRITICAL();
+    prv_WriteTime(epoch, 0U);
+    taskEXIT_CRITICAL();
+}
+
+/* TPR cuenta ciclos de 32.768 kHz dentro del segundo: 1 cuenta = 15625/512 us */
+uint64_t TIME_GetUs(void)
+{
+    uint32_t sec, tpr;
+
+    do
+    {
+        sec = RTC->TSR;
+        tpr = RTC->TPR & TIME_TPR_MASK;
+    } while (sec != RTC->TSR);
+    return ((uint64_t)sec * 1000000ULL) + (((uint64_t)tpr * 15625U) / 512U);
+}
+
+void TIME_StepUs(int64_t delta_us)
+{
+    uint64_t now;
+    uint32_t tpr;
+
+    taskENTER_CRITICAL();
+    now = (uint64_t)((int64_t)TIME_GetUs() + delta_us);
+    tpr = (uint32_t)(((now % 1000000ULL) * 512U) / 15625U);
+    prv_WriteTime((uint32_t)(now / 1000000ULL), tpr);
+    taskEXIT_CRITICAL();
+}
+
+/* Compensación del RTC: cada CIR+1 segundos, un segundo dura 32768 - TCR
+   ciclos. Entre los intervalos en que TCR no pasa de TIME_TCR_LUMP se busca
+   el que menos error de cuantización deja; si ni con 1 s cabe, 1 s con lo
+   que haga falta hasta TIME_TCR_MAX */
+int32_t TIME_SetRatePpb(int32_t ppb)
+{
+    int64_t  n, err, best_n, best_err;
+    uint32_t interval, best_i = 1U;
+
+    best_n   = (((int64_t)ppb * 32768) + ((ppb >= 0) ? 500000000 : -500000000)) / 1000000000;
+    best_n   = (best_n > TIME_TCR_MAX) ? TIME_TCR_MAX : ((best_n < -TIME_TCR_MAX) ? -TIME_TCR_MAX : best_n);
+    best_err = INT64_MAX;
+
+    for (interval = 1U; interval <= 256U; interval++)
+    {
+        n = (((int64_t)ppb * 32768 * (int64_t)interval) + ((ppb >= 0) ? 500000000 : -500000000)) / 1000000000;
+        if ((n < -TIME_TCR_LUMP) || (n > TIME_TCR_LUMP))
+        {
+            break;      /* intervalos más largos necesitan todavía más TCR */
+        }
+        err = ((n * 1000000000) / (32768 * (int64_t)interval)) - ppb;
+        err = (err < 0) ? -err : err;
+        if (err < best_err)
+        {
+            best_err = err;
+            best_n   = n;
+            best_i   = interval;
+        }
+    }
+
+    RTC->TCR = RTC_TCR_CIR(best_i - 1U) | RTC_TCR_TCR((uint8_t)(int8_t)best_n);
+    return (int32_t)((best_n * 1000000000) / (32768 * (int64_t)best_i));
+}
+
+void TIME_Get(time_cal_t *cal)
+{
+    TIME_EpochToCal(TIME_GetEpoch(), cal);
+}
+
+bool TIME_Set(const time_cal_t *cal)
+{
+    static const uint8_t mdays[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if ((cal->year < 1970U) || (cal->year > 2105U) || (cal->month < 1U) || (cal->month > 12U) ||
+        (cal->day < 1U) || (cal->day > mdays[cal->month - 1U]) ||
+        ((cal->month == 2U) && (cal->day == 29U) && !prv_IsLeap(cal->year)) ||
+        (cal->hour > 23U) || (cal->minute > 59U) || (cal->second > 59U))
+    {
+        return false;
+    }
+    TIME_SetEpoch(TIME_CalToEpoch(cal));
+    return true;
+}
+
+void TIME_SetAlarmTask(TaskHandle_t alarm_task)
+{
+    s_time.hAlarm = alarm_task;
+    RTC->TAR = 0U;                          /* limpia TAF; TSR nunca vuelve a 0 */
+    RTC->IER |= RTC_IER_TAIE_MASK;
+    NVIC_SetPriority(RTC_IRQn, TIME_IRQ_PRIORITY);
+    EnableIRQ(RTC_IRQn);
+}
+
+/* TAF se enciende cuando TSR == TAR e incrementa: TAR = epoch - 1 dispara
+   justo cuando TSR llega a epoch */
+void TIME_ArmAlarm(uint32_t epoch)
+{
+    RTC->TAR = (epoch != 0U) ? (epoch - 1U) : 0U;
+}
+
+/* ======= ISR ======= */
+/* Una notificación por segundo, justo cuando TSR incrementa */
+void RTC_Seconds_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(s_time.hNotify, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/* Alarma: se desarma (escribir TAR limpia TAF) y avisa; quien la atiende
+   programa la siguiente */
+void RTC_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (RTC->SR & RTC_SR_TAF_MASK)
+    {
+        RTC->TAR = 0U;
+        if (s_time.hAlarm != NULL)
+        {
+            vTaskNotifyGiveFromISR(s_time.hAlarm, &woken);
+        }
+    }
+    portYIELD_FROM_ISR(woken);
+}
@@ -0,0 +1,77 @@
+/*
+ * time_service.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Hora del reloj sobre el RTC de la K64F: el contador de segundos (TSR) corre
+ * con el cristal de 32.768 kHz, no con el tick de FreeRTOS, así que el
+ * retraso del daemon de timers o del scheduler no se acumula. La interrupción
+ * de segundos manda una sola notificación por segundo a la tarea registrada.
+ */
+
+#ifndef TIME_SERVICE_H_
+#define TIME_SERVICE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* ======= Configuración ======= */
+/* Hora al arrancar si el RTC perdió la hora (sin VBAT): 2026-01-01 00:00:00 */
+#define TIME_DEFAULT_EPOCH     1767225600UL
+#define TIME_IRQ_PRIORITY      (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1U)
+#define TIME_TPR_MASK          0x7FFFU      /* TPR[14:0]: fracción de segundo */
+#define TIME_TCR_MAX           127          /* |TCR| por intervalo de compensación */
+/* |TCR| preferido: el RTC aplica los TCR ciclos de golpe, así que son un
+   diente de sierra en la hora (8 = 244 us; con 127 llega a 3.9 ms, ver
+   host/tsync_sim.c). Más de 244 ppm ya no cabe y se usa intervalo de 1 s */
+#define TIME_TCR_LUMP          8
+
+/* ======= Tipos ======= */
+typedef struct
+{
+    uint16_t year;      /* 1970.. */
+    uint8_t  month;     /* 1..12 */
+    uint8_t  day;       /* 1..31 */
+    uint8_t  hour;      /* 0..23 */
+    uint8_t  minute;    /* 0..59 */
+    uint8_t  second;    /* 0..59 */
+    uint8_t  wday;      /* 0 = domingo .. 6 = sábado */
+} time_cal_t;
+
+/* ======= API ======= */
+/* Arranca el RTC y registra la tarea que recibe una notificación
+   (xTaskNotifyGive) por segundo; NULL = sin notificaciones */
+bool     TIME_Init(TaskHandle_t notify_task);
+
+/* Segundos desde 1970-01-01 00:00:00 */
+uint32_t TIME_GetEpoch(void);
+void     TIME_SetEpoch(uint32_t epoch);
+
+/* Microsegundos desde 1970 con la fracción del prescaler (resolución ~30.5 us) */
+uint64_t TIME_GetUs(void);
+/* Salto de fase: suma delta_us a la hora (incluida la fracción); después
+   llamar ALARM_Resync */
+void     TIME_StepUs(int64_t delta_us);
+
+/* Corrige la frecuencia del RTC en ppb (positivo = adelantar) con la
+   compensación de hardware (TCR/CIR); regresa lo que quedó aplicado tras
+   cuantizar. 0 = sin compensación */
+int32_t  TIME_SetRatePpb(int32_t ppb);
+
+void     TIME_Get(time_cal_t *cal);
+bool     TIME_Set(const time_cal_t *cal);     /* false si la fecha no es válida */
+
+/* Alarma del RTC (TAR): al llegar TSR a epoch se notifica (xTaskNotifyGive)
+   a alarm_task y la alarma queda desarmada; epoch 0 = desarmar */
+void     TIME_SetAlarmTask(TaskHandle_t alarm_task);
+void     TIME_ArmAlarm(uint32_t epoch);
+
+/* Conversiones sin estado */
+void     TIME_EpochToCal(uint32_t epoch, time_cal_t *cal);
+uint32_t TIME_CalToEpoch(const time_cal_t *cal);
+
+#endif /* TIME_SERVICE_H_ */
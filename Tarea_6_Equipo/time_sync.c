@@ -0,0 +1,267 @@
+/*
+ * time_sync.c
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ */
+
+#include "time_sync.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "task.h"
+#include "queue.h"
+
+#include "fsl_device_registers.h"
+#include "board.h"
+
+#include "time_service.h"
+#include "alarm_sched.h"
+
+/* ======= Contexto interno ======= */
+typedef struct
+{
+    char     text[TSYNC_LINE_MAX];
+    uint8_t  len;
+    uint64_t t_rx_us;       /* hora local al llegar el '\n' */
+} tsync_line_t;
+
+typedef struct
+{
+    QueueHandle_t  lines;
+    tsync_line_t   rx;          /* línea en construcción (ISR) */
+    tsync_status_t status;
+    uint64_t       last_t1;     /* t1 de la última muestra usada por el lazo */
+    uint32_t       seq;
+    bool           settled;     /* ya hubo una muestra después del último salto */
+} tsync_ctx_t;
+
+static tsync_ctx_t s_sync;
+
+/* ======= Prototipos locales ======= */
+static void    prv_Task(void *pvParameters);
+static uint64_t prv_SendQuery(void);
+static bool    prv_Exchange(int64_t *offset_us, int64_t *delay_us, uint64_t *t1_us);
+static bool    prv_ParseReply(const tsync_line_t *line, uint32_t seq, uint64_t *t2_ms, uint64_t *t3_ms);
+static void    prv_Discipline(int64_t offset_us, uint64_t t1_us);
+static int32_t prv_Clamp(int64_t ppb);
+
+/* ======= Helpers ======= */
+static int32_t prv_Clamp(int64_t ppb)
+{
+    return (int32_t)((ppb > TSYNC_MAX_PPB) ? TSYNC_MAX_PPB : ((ppb < -TSYNC_MAX_PPB) ? -TSYNC_MAX_PPB : ppb));
+}
+
+/* "$TR <seq> <t2_ms> <t3_ms>" */
+static bool prv_ParseReply(const tsync_line_t *line, uint32_t seq, uint64_t *t2_ms, uint64_t *t3_ms)
+{
+    char *p;
+
+    if (strncmp(line->text, "$TR ", 4) != 0)
+    {
+        return false;
+    }
+    if (strtoul(&line->text[4], &p, 10) != seq)
+    {
+        return false;
+    }
+    *t2_ms = strtoull(p, &p, 10);
+    *t3_ms = strtoull(p, &p, 10);
+    return (*t2_ms != 0U) && (*t3_ms >= *t2_ms);
+}
+
+/* La pregunta sale directo por la UART con el scheduler suspendido: ninguna
+   tarea escribe en medio ni retrasa t1, que se toma al salir el último bit.
+   Un PRINTF de otra tarea que quedó a medias solo queda partido alrededor de
+   la línea (la PC busca "$TQ" en cualquier parte de la línea). Las
+   interrupciones siguen corriendo; son ~3.5 ms a 115200 */
+static uint64_t prv_SendQuery(void)
+{
+    char     text[TSYNC_LINE_MAX];
+    int      n, i;
+    uint64_t t1;
+
+    n = snprintf(text, sizeof(text), "$TQ %u %d %d\r\n",
+                 (unsigned)s_sync.seq, (int)s_sync.status.offset_us, (int)s_sync.status.freq_ppb);
+
+    vTaskSuspendAll();
+    for (i = 0; i < n; i++)
+    {
+        while ((TSYNC_UART->S1 & UART_S1_TDRE_MASK) == 0U)
+        {
+        }
+        TSYNC_UART->D = (uint8_t)text[i];
+    }
+    while ((TSYNC_UART->S1 & UART_S1_TC_MASK) == 0U)
+    {
+    }
+    t1 = TIME_GetUs();
+    (void)xTaskResumeAll();
+    return t1;
+}
+
+/* Una pregunta y su respuesta. A t4 se le quita lo que tardó en llegar la
+   línea de respuesta: la PC marca t2 al terminar de recibir y t3 antes de
+   escribir, así los dos sentidos miden lo mismo */
+static bool prv_Exchange(int64_t *offset_us, int64_t *delay_us, uint64_t *t1_us)
+{
+    tsync_line_t line;
+    uint64_t t2_ms, t3_ms, t4;
+    int64_t  t2, t3;
+    TickType_t start = xTaskGetTickCount();
+
+    s_sync.seq++;
+    xQueueReset(s_sync.lines);
+    *t1_us = prv_SendQuery();
+
+    /* Se ignoran líneas que no sean la respuesta a esta pregunta */
+    for (;;)
+    {
+        TickType_t waited = xTaskGetTickCount() - start;
+
+        if ((waited >= pdMS_TO_TICKS(TSYNC_REPLY_TIMEOUT_MS)) ||
+            (xQueueReceive(s_sync.lines, &line, pdMS_TO_TICKS(TSYNC_REPLY_TIMEOUT_MS) - waited) != pdPASS))
+        {
+            return false;
+        }
+        if (prv_ParseReply(&line, s_sync.seq, &t2_ms, &t3_ms))
+        {
+            break;
+        }
+    }
+
+    t4 = line.t_rx_us - (((uint64_t)(line.len + 1U) * 10U * 1000000U) / TSYNC_BAUDRATE);
+    t2 = (int64_t)(t2_ms * 1000U) + 500;    /* la PC trunca a ms: centro del ms */
+    t3 = (int64_t)(t3_ms * 1000U) + 500;
+    *offset_us = ((t2 - (int64_t)*t1_us) + (t3 - (int64_t)t4)) / 2;
+    *delay_us  = ((int64_t)t4 - (int64_t)*t1_us) - (t3 - t2);
+    return true;
+}
+
+/* Lazo PI: la frecuencia integra offset / intervalo (error del cristal) y la
+   fase agrega una corrección temporal que cancela el offset en
+   TSYNC_PHASE_GAIN intervalos. Ambas van al RTC como una sola compensación */
+static void prv_Discipline(int64_t offset_us, uint64_t t1_us)
+{
+    tsync_status_t *st = &s_sync.status;
+    int64_t interval_s;
+    int64_t freq;
+
+    if (!st->synced || (offset_us > TSYNC_STEP_US) || (offset_us < -TSYNC_STEP_US))
+    {
+        /* Salto: la muestra ya no sirve para la frecuencia */
+        TIME_StepUs(offset_us);
+        ALARM_Resync();
+        st->synced = true;
+        st->steps++;
+        s_sync.settled = false;
+        return;
+    }
+    if (!s_sync.settled)
+    {
+        /* Primera muestra tras el salto: solo marca el inicio del intervalo */
+        s_sync.settled = true;
+        s_sync.last_t1 = t1_us;
+        return;
+    }
+
+    interval_s = (int64_t)((t1_us - s_sync.last_t1) / 1000000U);
+    if (interval_s < 1)
+    {
+        interval_s = 1;
+    }
+    s_sync.last_t1 = t1_us;
+
+    /* offset_us / interval_s = ppm; x1000 = ppb */
+    freq = st->freq_ppb + ((offset_us * 1000) / (interval_s * TSYNC_FREQ_GAIN));
+    st->freq_ppb    = prv_Clamp(freq);
+    st->applied_ppb = TIME_SetRatePpb(prv_Clamp(st->freq_ppb + ((offset_us * 1000) / (interval_s * TSYNC_PHASE_GAIN))));
+}
+
+static void prv_Task(void *pvParameters)
+{
+    int64_t  offset_us, delay_us;
+    uint64_t t1_us;
+
+    (void)pvParameters;
+
+    for (;;)
+    {
+        if (prv_Exchange(&offset_us, &delay_us, &t1_us) && (delay_us <= TSYNC_MAX_DELAY_US))
+        {
+            s_sync.status.offset_us = (int32_t)((offset_us > INT32_MAX) ? INT32_MAX :
+                                                ((offset_us < INT32_MIN) ? INT32_MIN : offset_us));
+            s_sync.status.delay_us  = (int32_t)delay_us;
+            s_sync.status.samples++;
+            prv_Discipline(offset_us, t1_us);
+        }
+        else
+        {
+            s_sync.status.rejected++;
+        }
+
+        /* Sin sincronizar o recién saltado se pregunta seguido */
+        vTaskDelay(pdMS_TO_TICKS(s_sync.settled ? TSYNC_POLL_MS : TSYNC_FAST_POLL_MS));
+    }
+}
+
+/* ======= API ======= */
+bool TSYNC_Init(UBaseType_t priority)
+{
+    memset(&s_sync, 0, sizeof(s_sync));
+    s_sync.lines = xQueueCreate(2, sizeof(tsync_line_t));
+    if (s_sync.lines == NULL)
+    {
+        return false;
+    }
+    if (xTaskCreate(prv_Task, "TSync", configMINIMAL_STACK_SIZE + 200, NULL, priority, NULL) != pdPASS)
+    {
+        return false;
+    }
+
+    TIME_SetRatePpb(0);
+    TSYNC_UART->C2 |= UART_C2_RIE_MASK;
+    NVIC_SetPriority(TSYNC_UART_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+    EnableIRQ(TSYNC_UART_IRQn);
+    return true;
+}
+
+void TSYNC_GetStatus(tsync_status_t *status)
+{
+    taskENTER_CRITICAL();
+    *status = s_sync.status;
+    taskEXIT_CRITICAL();
+}
+
+/* ======= ISR ======= */
+/* Arma la línea byte a byte; el '\n' se marca con la hora local en ese
+   instante, sin esperar a que la tarea despierte */
+void TSYNC_UART_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+    uint8_t s1 = TSYNC_UART->S1;            /* leer S1 y luego D limpia RDRF/OR */
+
+    if (s1 & (UART_S1_RDRF_MASK | UART_S1_OR_MASK))
+    {
+        char c = (char)TSYNC_UART->D;
+
+        if (c == '\n')
+        {
+            s_sync.rx.t_rx_us = TIME_GetUs();
+            s_sync.rx.text[s_sync.rx.len] = '\0';
+            if ((s_sync.rx.len > 0U) && (s_sync.rx.text[s_sync.rx.len - 1U] == '\r'))
+            {
+                s_sync.rx.text[s_sync.rx.len - 1U] = '\0';     /* len sigue contando bytes en la línea */
+            }
+            (void)xQueueSendFromISR(s_sync.lines, &s_sync.rx, &woken);
+            s_sync.rx.len = 0U;
+        }
+        else if (s_sync.rx.len < (TSYNC_LINE_MAX - 1U))
+        {
+            s_sync.rx.text[s_sync.rx.len++] = c;
+        }
+    }
+    portYIELD_FROM_ISR(woken);
+}
@@ -0,0 +1,72 @@
+/*
+ * time_sync.h
+ *
+ *  Created on: 19 oct 2026
+ *      Author: luisg
+ *
+ * Sincronización de la hora contra una PC por la UART de debug, al estilo
+ * NTP: la tarjeta pregunta y la PC (la referencia) contesta con su hora.
+ *
+ *   tarjeta -> PC:  "$TQ <seq> <offset_us> <freq_ppb>\r\n"   (t1 al salir el último bit)
+ *   PC -> tarjeta:  "$TR <seq> <t2_ms> <t3_ms>\n"            (t4 al llegar el '\n')
+ *
+ * La respuesta la da host/tsync_ref.py; host/tsync_sim.c corre este lazo
+ * contra un RTC y una PC simulados (24 h, cristal con error y deriva).
+ *
+ * t2/t3: ms desde 1970 en hora local de la PC (truncados), al recibir la
+ * pregunta y al escribir la respuesta. offset/freq son solo para que la PC
+ * registre la precisión. Con los cuatro tiempos:
+ *   offset = ((t2 - t1) + (t3 - t4)) / 2,   retardo = (t4 - t1) - (t3 - t2)
+ *
+ * Un offset grande (arranque, cambio de hora) se corrige con un salto; uno
+ * pequeño se corrige gradualmente con la compensación del RTC, junto con la
+ * estimación del error del cristal en ppm (lazo PI): la hora nunca retrocede
+ * ni se salta segundos una vez sincronizada.
+ */
+
+#ifndef TIME_SYNC_H_
+#define TIME_SYNC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+
+/* ======= Configuración ======= */
+#define TSYNC_UART               UART0
+#define TSYNC_UART_IRQn          UART0_RX_TX_IRQn
+#define TSYNC_UART_IRQHandler    UART0_RX_TX_IRQHandler
+#define TSYNC_BAUDRATE           BOARD_DEBUG_UART_BAUDRATE
+
+#define TSYNC_POLL_MS            32000U     /* periodo ya sincronizado */
+#define TSYNC_FAST_POLL_MS       2000U      /* sin sincronizar o tras un salto */
+#define TSYNC_REPLY_TIMEOUT_MS   500U
+#define TSYNC_MAX_DELAY_US       20000      /* muestras con más retardo se descartan */
+#define TSYNC_STEP_US            500000     /* offset para saltar en vez de corregir gradualmente */
+#define TSYNC_MAX_PPB            500000     /* límite de la corrección: 500 ppm */
+#define TSYNC_FREQ_GAIN          32         /* frecuencia: offset / (intervalo * FREQ_GAIN) */
+#define TSYNC_PHASE_GAIN         8          /* fase: se corrige en PHASE_GAIN intervalos */
+#define TSYNC_LINE_MAX           48U
+
+/* ======= Tipos ======= */
+typedef struct
+{
+    bool     synced;
+    int32_t  offset_us;     /* última medición (referencia - local) */
+    int32_t  delay_us;      /* retardo de ida y vuelta de esa medición */
+    int32_t  freq_ppb;      /* error estimado del cristal (la corrección) */
+    int32_t  applied_ppb;   /* corrección cargada en el RTC (frecuencia + fase) */
+    uint32_t samples;
+    uint32_t rejected;      /* sin respuesta, seq equivocado o retardo alto */
+    uint32_t steps;
+} tsync_status_t;
+
+/* ======= API ======= */
+/* Habilita RX por interrupción en la UART de debug y crea la tarea. Las
+   preguntas salen con el scheduler suspendido, así que PRINTF de otras
+   tareas puede seguir usando la UART; nadie más debe leer de ella */
+bool TSYNC_Init(UBaseType_t priority);
+
+void TSYNC_GetStatus(tsync_status_t *status);
+
+#endif /* TIME_SYNC_H_ */
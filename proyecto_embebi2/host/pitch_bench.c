@@ -0,0 +1,300 @@
+/*
+ * Banco de pruebas en la PC del detector de pitch de main.c (estimate_pitch,
+ * YIN de grueso a fino) contra la autocorrelación por todos los retardos que
+ * usaba antes, con la misma ventana y la misma FS:
+ *   - F0 de 82 a 590 Hz (pasos de 1%, 4 fases cada una) con seno, armónicos
+ *     1/k, diente de sierra y 2a armónica fuerte, sin y con ruido;
+ *   - ruido blanco, que no debe dar pitch;
+ *   - tiempo por llamada de cada uno y de un bloque del DSP (normal y con la
+ *     copia de la ventana para el hilo de pitch).
+ * main.c se compila tal cual con sim_include (Zephyr y registros de mentira);
+ * solo se usan sus funciones de pitch. Falla si el detector nuevo tiene
+ * errores gruesos (> 50 cents), error medio de más de PB_MEAN_MAX_CENTS o
+ * da pitch en más del 1% del ruido.
+ *
+ * Uso: pitch_bench [llamadas para medir tiempo]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define main autotune_main
+#include "main.c"
+#undef main
+
+#define PB_GROSS_CENTS       50.0
+#define PB_MEAN_MAX_CENTS    5.0
+#define PB_NOISE_WINDOWS     2000
+#define PB_TIME_CALLS        3000
+
+/* ======= Lo que main.c espera de Zephyr y del SDK (no se ejecuta) ======= */
+const struct device sim_adc1 = { "ADC_1" };
+const struct device sim_dac0 = { "DAC_0" };
+DMA_Type    sim_dma0;
+DMAMUX_Type sim_dmamux;
+ADC_Type    sim_adc1_regs;
+DAC_Type    sim_dac0_regs;
+PDB_Type    sim_pdb0;
+SIM_Type    sim_sim;
+uint32_t    SystemCoreClock = 120000000u;
+
+bool device_is_ready(const struct device *dev) { (void)dev; return true; }
+bool adc_is_ready_dt(const struct adc_dt_spec *spec) { (void)spec; return true; }
+int  adc_channel_setup_dt(const struct adc_dt_spec *spec) { (void)spec; return 0; }
+int  dac_channel_setup(const struct device *dev, const struct dac_channel_cfg *cfg) { (void)dev; (void)cfg; return 0; }
+int  k_msgq_put(struct k_msgq *q, const void *data, k_timeout_t t) { (void)q; (void)data; (void)t; return 0; }
+int  k_msgq_get(struct k_msgq *q, void *data, k_timeout_t t) { (void)q; (void)data; (void)t; return -1; }
+int  k_sem_take(struct k_sem *sem, k_timeout_t t) { (void)sem; (void)t; return -1; }
+void k_sem_give(struct k_sem *sem) { (void)sem; }
+uint32_t sys_clock_hw_cycles_per_sec(void) { return 120000000u; }
+uint32_t k_cycle_get_32(void) { return 0u; }
+int32_t  k_sleep(k_timeout_t t) { (void)t; return 0; }
+void irq_enable(unsigned int irq) { (void)irq; }
+void CLOCK_EnableClock(clock_ip_name_t name) { (void)name; }
+uint32_t CLOCK_GetBusClkFreq(void) { return 60000000u; }
+void *k_thread_create(struct k_thread *t, k_thread_stack_t *stack, size_t size, k_thread_entry_t entry,
+		      void *p1, void *p2, void *p3, int prio, uint32_t options, k_timeout_t delay)
+{
+	(void)stack; (void)size; (void)entry; (void)p1; (void)p2; (void)p3;
+	(void)prio; (void)options; (void)delay;
+	return t;
+}
+
+/* El hilo de pitch recibe la ventana ya copiada por el DSP */
+static void estimate_pitch_snap(void)
+{
+	pitch_snapshot();
+	estimate_pitch();
+}
+
+/* ======= Detector anterior (autocorrelación, antes del YIN) ======= */
+static void estimate_pitch_autocorr(void)
+{
+	float x[PITCH_BUF_SIZE];
+	int idx = pitch_index;
+	for (int i = 0; i < PITCH_BUF_SIZE; i++) {
+		x[i] = pitch_buf[idx];
+		idx++;
+		if (idx >= PITCH_BUF_SIZE) {
+			idx = 0;
+		}
+	}
+
+	float mean = 0.0f;
+	for (int i = 0; i < PITCH_BUF_SIZE; i++) {
+		mean += x[i];
+	}
+	mean /= (float)PITCH_BUF_SIZE;
+	for (int i = 0; i < PITCH_BUF_SIZE; i++) {
+		x[i] -= mean;
+	}
+
+	float energy = 0.0f;
+	for (int i = 0; i < PITCH_BUF_SIZE; i++) {
+		energy += x[i] * x[i];
+	}
+	if (energy < ENERGY_THRESHOLD) {
+		current_f0_hz = 0.0f;
+		return;
+	}
+
+	int lag_min = (int)(FS_HZ / F0_MAX_HZ);
+	int lag_max = (int)(FS_HZ / (float)PITCH_F0_MIN_HZ);
+	if (lag_max >= PITCH_BUF_SIZE) {
+		lag_max = PITCH_BUF_SIZE - 1;
+	}
+
+	float best_r = 0.0f;
+	int   best_lag = lag_min;
+	for (int lag = lag_min; lag <= lag_max; lag++) {
+		float r = 0.0f;
+		for (int n = 0; n < PITCH_BUF_SIZE - lag; n++) {
+			r += x[n] * x[n + lag];
+		}
+		if (r > best_r) {
+			best_r   = r;
+			best_lag = lag;
+		}
+	}
+
+	if (best_r > 0.0f) {
+		current_f0_hz = FS_HZ / (float)best_lag;
+	} else {
+		current_f0_hz = 0.0f;
+	}
+}
+
+/* ======= Señales ======= */
+enum { SIG_SINE, SIG_HARMONICS, SIG_SAW, SIG_STRONG_2ND, SIG_COUNT };
+
+static const char *const sig_names[SIG_COUNT] = {
+	"seno", "armonicos 1/k", "diente de sierra", "2a armonica fuerte"
+};
+
+static float gauss(void)
+{
+	float u = ((float)rand() + 1.0f) / ((float)RAND_MAX + 2.0f);
+	float v = ((float)rand() + 1.0f) / ((float)RAND_MAX + 2.0f);
+
+	return sqrtf(-2.0f * logf(u)) * cosf(6.2831853f * v);
+}
+
+static void fill(int kind, float f0, float phase, float noise)
+{
+	for (int n = 0; n < PITCH_BUF_SIZE; n++) {
+		float w = 6.2831853f * f0 * ((float)n / FS_HZ);
+		float y = 0.0f;
+
+		switch (kind) {
+		case SIG_SINE:
+			y = 0.5f * sinf(w + phase);
+			break;
+		case SIG_HARMONICS:
+			for (int k = 1; (k <= 8) && ((float)k * f0 < 7000.0f); k++) {
+				y += 0.25f / (float)k * sinf((float)k * (w + phase));
+			}
+			break;
+		case SIG_SAW:
+			y = 0.5f * (2.0f * fmodf(f0 * ((float)n / FS_HZ) + phase, 1.0f) - 1.0f);
+			break;
+		default:
+			y = 0.15f * sinf(w + phase) + 0.3f * sinf(2.0f * w) + 0.15f * sinf(3.0f * w + 1.0f);
+			break;
+		}
+		pitch_buf[n] = y + noise * gauss();
+	}
+	pitch_index = 0;
+}
+
+/* ======= Estadística ======= */
+typedef struct
+{
+	int    gross;
+	int    good;
+	double sum;
+	double max;
+} pb_stats_t;
+
+static void stats_add(pb_stats_t *s, float est, float f0)
+{
+	double cents = (est > 0.0f) ? fabs(1200.0 * log2((double)est / (double)f0)) : INFINITY;
+
+	if (cents > PB_GROSS_CENTS) {
+		s->gross++;
+		return;
+	}
+	s->good++;
+	s->sum += cents;
+	if (cents > s->max) {
+		s->max = cents;
+	}
+}
+
+static double stats_mean(const pb_stats_t *s)
+{
+	return (s->good > 0) ? (s->sum / s->good) : 0.0;
+}
+
+static double time_per_call_us(void (*estimate)(void), int calls)
+{
+	clock_t c0 = clock();
+
+	for (int i = 0; i < calls; i++) {
+		estimate();
+	}
+	return (double)(clock() - c0) * 1e6 / CLOCKS_PER_SEC / calls;
+}
+
+/* Tiempo de dsp_process_block: con update, el bloque cruza la frontera de
+   PITCH_UPDATE_SAMPLES y copia la ventana (pitch_request) */
+static double block_time_us(int update, int calls)
+{
+	for (int n = 0; n < FRAME_SIZE; n++) {
+		adc_buf[0][n] = (uint16_t)(2048.0f + 1500.0f * sinf(0.1f * (float)n));
+	}
+	silence      = false;
+	pitch_factor = 1.06f;
+
+	clock_t c0 = clock();
+
+	for (int i = 0; i < calls; i++) {
+		global_sample_count = update ? (uint32_t)(PITCH_UPDATE_SAMPLES - FRAME_SIZE) : 1u;
+		(void)atomic_set(&pitch_busy, 0);
+		dsp_process_block(0u);
+	}
+	return (double)(clock() - c0) * 1e6 / CLOCKS_PER_SEC / calls;
+}
+
+int main(int argc, char **argv)
+{
+	int calls = (argc > 1) ? atoi(argv[1]) : PB_TIME_CALLS;
+	int failures = 0;
+
+	srand(1);
+	printf("FS %u Hz, ventana %d muestras, retardos %d..%d\n",
+	       AUDIO_FS_HZ, PITCH_BUF_SIZE, (int)(FS_HZ / F0_MAX_HZ), PITCH_LAG_MAX);
+	printf("%-18s %5s | %-30s | %-30s\n", "senal", "ruido",
+	       "anterior: media/max cents, gruesos", "nuevo: media/max cents, gruesos");
+
+	for (int kind = 0; kind < SIG_COUNT; kind++) {
+		for (int nz = 0; nz < 2; nz++) {
+			float      noise = nz ? 0.05f : 0.0f;
+			pb_stats_t old_s = { 0 };
+			pb_stats_t new_s = { 0 };
+
+			for (float f0 = 82.0f; f0 <= 590.0f; f0 *= 1.01f) {
+				for (int r = 0; r < 4; r++) {
+					fill(kind, f0, 0.7f * (float)r, noise);
+					estimate_pitch_autocorr();
+					stats_add(&old_s, current_f0_hz, f0);
+					estimate_pitch_snap();
+					stats_add(&new_s, current_f0_hz, f0);
+				}
+			}
+			printf("%-18s %5.2f | %6.2f %7.2f %4d/%-4d       | %6.2f %7.2f %4d/%-4d\n",
+			       sig_names[kind], noise,
+			       stats_mean(&old_s), old_s.max, old_s.gross, old_s.good + old_s.gross,
+			       stats_mean(&new_s), new_s.max, new_s.gross, new_s.good + new_s.gross);
+			if ((new_s.gross > 0) || (stats_mean(&new_s) > PB_MEAN_MAX_CENTS)) {
+				failures++;
+			}
+		}
+	}
+
+	int voiced_old = 0;
+	int voiced_new = 0;
+	for (int r = 0; r < PB_NOISE_WINDOWS; r++) {
+		for (int n = 0; n < PITCH_BUF_SIZE; n++) {
+			pitch_buf[n] = 0.2f * gauss();
+		}
+		pitch_index = 0;
+		estimate_pitch_autocorr();
+		voiced_old += (current_f0_hz > 0.0f) ? 1 : 0;
+		estimate_pitch_snap();
+		voiced_new += (current_f0_hz > 0.0f) ? 1 : 0;
+	}
+	printf("ruido blanco con pitch: anterior %d/%d, nuevo %d/%d\n",
+	       voiced_old, PB_NOISE_WINDOWS, voiced_new, PB_NOISE_WINDOWS);
+	if (voiced_new * 100 > PB_NOISE_WINDOWS) {
+		failures++;
+	}
+
+	if (calls > 0) {
+		fill(SIG_HARMONICS, 220.0f, 0.3f, 0.05f);
+		double t_old = time_per_call_us(estimate_pitch_autocorr, calls);
+		double t_new = time_per_call_us(estimate_pitch_snap, calls);
+		printf("tiempo por llamada (PC): anterior %.1f us, nuevo %.1f us (x%.1f)\n",
+		       t_old, t_new, t_old / t_new);
+
+		/* Lo que queda en el DSP: el bloque normal y el que copia la ventana */
+		double t_blk = block_time_us(0, calls * 10);
+		double t_upd = block_time_us(1, calls * 10);
+		printf("bloque DSP de %d muestras (PC): %.2f us, con copia para pitch %.2f us; "
+		       "antes sumaba el detector (%.1f us); el bloque dura %.1f us\n",
+		       FRAME_SIZE, t_blk, t_upd, t_new, 1e6 * FRAME_SIZE / FS_HZ);
+	}
+
+	return (failures == 0) ? 0 : 1;
+}
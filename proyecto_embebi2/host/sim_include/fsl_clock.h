@@ -0,0 +1,11 @@
+#ifndef SIM_FSL_CLOCK_H_
+#define SIM_FSL_CLOCK_H_
+
+#include <stdint.h>
+
+typedef enum { kCLOCK_Dmamux0, kCLOCK_Dma0, kCLOCK_Pdb0 } clock_ip_name_t;
+
+void     CLOCK_EnableClock(clock_ip_name_t name);
+uint32_t CLOCK_GetBusClkFreq(void);
+
+#endif /* SIM_FSL_CLOCK_H_ */
@@ -0,0 +1,81 @@
+/* Registros del K64 que usa el audio por DMA de main.c, sin el hardware:
+   solo para que compile, los valores de los campos no importan */
+#ifndef SIM_FSL_DEVICE_REGISTERS_H_
+#define SIM_FSL_DEVICE_REGISTERS_H_
+
+#include <stdint.h>
+
+typedef enum { DMA0_IRQn = 0, DMA_Error_IRQn = 16, PDB0_IRQn = 52 } IRQn_Type;
+enum { kDmaRequestMux0ADC1 = 41 };
+
+typedef struct
+{
+	uint32_t SADDR; int16_t SOFF; uint16_t ATTR; uint32_t NBYTES_MLNO; int32_t SLAST;
+	uint32_t DADDR; int16_t DOFF;
+	union { uint16_t CITER_ELINKNO; uint16_t CITER_ELINKYES; };
+	int32_t DLAST_SGA; uint16_t CSR;
+	union { uint16_t BITER_ELINKNO; uint16_t BITER_ELINKYES; };
+} SIM_DMA_TCD_Type;
+typedef struct
+{
+	uint32_t ES; uint8_t CERQ, SERQ, SEEI, CERR, CINT;
+	SIM_DMA_TCD_Type TCD[16];
+} DMA_Type;
+typedef struct { uint8_t CHCFG[16]; } DMAMUX_Type;
+typedef struct { uint32_t SC1[2], SC2, SC3, R[2]; } ADC_Type;
+typedef struct { struct { uint8_t DATL, DATH; } DAT[16]; } DAC_Type;
+typedef struct { uint32_t SC, MOD, IDLY; struct { uint32_t C1, S, DLY[2]; } CH[2]; } PDB_Type;
+typedef struct { uint32_t SOPT7; } SIM_Type;
+
+extern DMA_Type    sim_dma0;
+extern DMAMUX_Type sim_dmamux;
+extern ADC_Type    sim_adc1_regs;
+extern DAC_Type    sim_dac0_regs;
+extern PDB_Type    sim_pdb0;
+extern SIM_Type    sim_sim;
+
+#define DMA0     (&sim_dma0)
+#define DMAMUX   (&sim_dmamux)
+#define ADC1     (&sim_adc1_regs)
+#define DAC0     (&sim_dac0_regs)
+#define PDB0     (&sim_pdb0)
+#define SIM      (&sim_sim)
+
+#define DMA_ATTR_SSIZE(x)               ((uint16_t)((x) << 8))
+#define DMA_ATTR_DSIZE(x)               ((uint16_t)(x))
+#define DMA_CITER_ELINKYES_ELINK_MASK   0x8000u
+#define DMA_CITER_ELINKYES_LINKCH(x)    ((uint16_t)((x) << 9))
+#define DMA_CITER_ELINKYES_CITER(x)     ((uint16_t)(x))
+#define DMA_CITER_ELINKYES_CITER_MASK   0x1FFu
+#define DMA_BITER_ELINKYES_ELINK_MASK   0x8000u
+#define DMA_BITER_ELINKYES_LINKCH(x)    ((uint16_t)((x) << 9))
+#define DMA_BITER_ELINKYES_BITER(x)     ((uint16_t)(x))
+#define DMA_CITER_ELINKNO_CITER(x)      ((uint16_t)(x))
+#define DMA_BITER_ELINKNO_BITER(x)      ((uint16_t)(x))
+#define DMA_CSR_INTMAJOR_MASK           0x2u
+#define DMA_CSR_INTHALF_MASK            0x4u
+#define DMA_CSR_MAJORELINK_MASK         0x20u
+#define DMA_CSR_MAJORLINKCH(x)          ((uint16_t)((x) << 8))
+#define DMA_CERQ_CERQ(x)                ((uint8_t)(x))
+#define DMA_SERQ_SERQ(x)                ((uint8_t)(x))
+#define DMA_SEEI_SEEI(x)                ((uint8_t)(x))
+#define DMA_CINT_CINT(x)                ((uint8_t)(x))
+#define DMA_CERR_CAEI_MASK              0x40u
+#define DMAMUX_CHCFG_ENBL_MASK          0x80u
+#define DMAMUX_CHCFG_SOURCE(x)          ((uint8_t)(x))
+#define ADC_SC1_ADCH(x)                 ((uint32_t)(x))
+#define ADC_SC2_ADTRG_MASK              0x40u
+#define ADC_SC2_DMAEN_MASK              0x4u
+#define ADC_SC3_ADCO_MASK               0x8u
+#define PDB_SC_PDBEN_MASK               0x80u
+#define PDB_SC_CONT_MASK                0x2u
+#define PDB_SC_LDOK_MASK                0x1u
+#define PDB_SC_SWTRIG_MASK              0x10000u
+#define PDB_SC_PDBEIE_MASK              0x20000u
+#define PDB_SC_TRGSEL(x)                ((uint32_t)(x) << 8)
+#define PDB_C1_EN(x)                    ((uint32_t)(x))
+#define PDB_C1_TOS(x)                   ((uint32_t)(x) << 8)
+#define PDB_S_ERR_MASK                  0xFFu
+#define SIM_SOPT7_ADC1ALTTRGEN_MASK     0x8000u
+
+#endif /* SIM_FSL_DEVICE_REGISTERS_H_ */
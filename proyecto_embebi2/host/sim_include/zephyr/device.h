@@ -0,0 +1,13 @@
+#ifndef SIM_ZEPHYR_DEVICE_H_
+#define SIM_ZEPHYR_DEVICE_H_
+
+#include <stdbool.h>
+
+struct device { const char *name; };
+
+extern const struct device sim_adc1, sim_dac0;
+
+#define DEVICE_DT_GET(node)   (&sim_dac0)
+bool device_is_ready(const struct device *dev);
+
+#endif /* SIM_ZEPHYR_DEVICE_H_ */
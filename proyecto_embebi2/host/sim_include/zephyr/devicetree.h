@@ -0,0 +1,20 @@
+/* El devicetree de frdm_k64f.overlay, resuelto a mano: /zephyr,user con
+   dac0 canal 0 a 12 bits y io-channels = <&adc1 14> */
+#ifndef SIM_ZEPHYR_DEVICETREE_H_
+#define SIM_ZEPHYR_DEVICETREE_H_
+
+#define DT_PATH(node)                          0
+#define DT_NODELABEL(label)                    0
+#define DT_NODE_EXISTS(node)                   1
+#define DT_NODE_HAS_PROP(node, prop)           1
+#define DT_SAME_NODE(a, b)                     1
+#define DT_PHANDLE(node, prop)                 0
+#define DT_PROP(node, prop)                    SIM_DT_##prop
+#define DT_FOREACH_PROP_ELEM(node, prop, fn)   fn(node, prop, 0)
+#define DT_IO_CHANNELS_CTLR_BY_IDX(node, idx)  0
+#define DT_IO_CHANNELS_INPUT_BY_IDX(node, idx) 14
+
+#define SIM_DT_dac_channel_id   0
+#define SIM_DT_dac_resolution   12
+
+#endif /* SIM_ZEPHYR_DEVICETREE_H_ */
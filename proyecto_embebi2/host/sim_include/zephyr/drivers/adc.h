@@ -0,0 +1,21 @@
+#ifndef SIM_ZEPHYR_DRIVERS_ADC_H_
+#define SIM_ZEPHYR_DRIVERS_ADC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+struct adc_dt_spec
+{
+	const struct device *dev;
+	uint8_t channel_id;
+};
+
+#define ADC_DT_SPEC_GET_BY_IDX(node, idx) \
+	{ .dev = &sim_adc1, .channel_id = DT_IO_CHANNELS_INPUT_BY_IDX(node, idx) }
+
+bool adc_is_ready_dt(const struct adc_dt_spec *spec);
+int  adc_channel_setup_dt(const struct adc_dt_spec *spec);
+
+#endif /* SIM_ZEPHYR_DRIVERS_ADC_H_ */
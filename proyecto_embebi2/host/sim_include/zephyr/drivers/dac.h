@@ -0,0 +1,18 @@
+#ifndef SIM_ZEPHYR_DRIVERS_DAC_H_
+#define SIM_ZEPHYR_DRIVERS_DAC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+struct dac_channel_cfg
+{
+	uint8_t channel_id;
+	uint8_t resolution;
+	bool    buffered;
+};
+
+int dac_channel_setup(const struct device *dev, const struct dac_channel_cfg *cfg);
+
+#endif /* SIM_ZEPHYR_DRIVERS_DAC_H_ */
@@ -0,0 +1,53 @@
+/* Zephyr mínimo para compilar main.c en la PC (pitch_bench.c): solo tiene
+   que compilar; la parte de hilos, colas e interrupciones no se ejecuta */
+#ifndef SIM_ZEPHYR_KERNEL_H_
+#define SIM_ZEPHYR_KERNEL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+#define BUILD_ASSERT(expr, msg)   _Static_assert(expr, msg)
+#define __aligned(x)              __attribute__((aligned(x)))
+
+typedef long atomic_t;
+typedef long atomic_val_t;
+static inline atomic_val_t atomic_add(atomic_t *a, atomic_val_t v) { atomic_val_t o = *a; *a += v; return o; }
+static inline atomic_val_t atomic_set(atomic_t *a, atomic_val_t v) { atomic_val_t o = *a; *a = v; return o; }
+static inline atomic_val_t atomic_get(const atomic_t *a) { return *a; }
+static inline atomic_val_t atomic_inc(atomic_t *a) { return atomic_add(a, 1); }
+static inline atomic_val_t atomic_dec(atomic_t *a) { return atomic_add(a, -1); }
+
+typedef struct { int ticks; } k_timeout_t;
+#define K_NO_WAIT        ((k_timeout_t){ 0 })
+#define K_FOREVER        ((k_timeout_t){ -1 })
+#define K_SECONDS(s)     ((k_timeout_t){ (s) })
+
+struct k_msgq { size_t msg_size; };
+#define K_MSGQ_DEFINE(name, size, depth, align) struct k_msgq name = { (size) }
+int k_msgq_put(struct k_msgq *q, const void *data, k_timeout_t timeout);
+int k_msgq_get(struct k_msgq *q, void *data, k_timeout_t timeout);
+
+struct k_sem { int count; };
+#define K_SEM_DEFINE(name, initial, limit) struct k_sem name = { (initial) }
+int  k_sem_take(struct k_sem *sem, k_timeout_t timeout);
+void k_sem_give(struct k_sem *sem);
+
+struct k_thread { int unused; };
+typedef uint8_t k_thread_stack_t;
+typedef void (*k_thread_entry_t)(void *p1, void *p2, void *p3);
+#define K_THREAD_STACK_DEFINE(name, size)  k_thread_stack_t name[size]
+#define K_THREAD_STACK_SIZEOF(name)        sizeof(name)
+void *k_thread_create(struct k_thread *t, k_thread_stack_t *stack, size_t size, k_thread_entry_t entry,
+		      void *p1, void *p2, void *p3, int prio, uint32_t options, k_timeout_t delay);
+
+uint32_t k_cycle_get_32(void);
+uint32_t sys_clock_hw_cycles_per_sec(void);
+int32_t  k_sleep(k_timeout_t timeout);
+
+#define IRQ_CONNECT(irq, prio, isr, arg, flags)  ((void)(isr))
+void irq_enable(unsigned int irq);
+
+#endif /* SIM_ZEPHYR_KERNEL_H_ */
@@ -0,0 +1,8 @@
+#ifndef SIM_ZEPHYR_SYS_PRINTK_H_
+#define SIM_ZEPHYR_SYS_PRINTK_H_
+
+#include <stdio.h>
+
+#define printk printf
+
+#endif /* SIM_ZEPHYR_SYS_PRINTK_H_ */
@@ -0,0 +1,7 @@
+#ifndef SIM_ZEPHYR_SYS_UTIL_H_
+#define SIM_ZEPHYR_SYS_UTIL_H_
+
+#define ARG_UNUSED(x)   (void)(x)
+#define ARRAY_SIZE(a)   (sizeof(a) / sizeof((a)[0]))
+
+#endif /* SIM_ZEPHYR_SYS_UTIL_H_ */
@@ -2,6 +2,7 @@
 #include <inttypes.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
@@ -11,14 +12,20 @@
 #include <zephyr/drivers/adc.h>
 #include <zephyr/drivers/dac.h>
 
-#define FS_HZ             5000.0f
+#include <fsl_device_registers.h>
+#include <fsl_clock.h>
 
-/* Periodo del timer en microsegundos (1 / 8 kHz = 125 us) */
-#define SAMPLE_PERIOD_US  ((uint32_t)(1000000u / (uint32_t)FS_HZ))
+/* Frecuencia de muestreo: la marca el PDB, no un k_timer (16 kHz .. 44.1 kHz) */
+#ifndef AUDIO_FS_HZ
+#define AUDIO_FS_HZ       16000u
+#endif
+#define FS_HZ             ((float)AUDIO_FS_HZ)
+
+BUILD_ASSERT((AUDIO_FS_HZ >= 16000u) && (AUDIO_FS_HZ <= 44100u), "AUDIO_FS_HZ fuera de rango");
 
 /* Tamaño de bloque (frames) */
 #define FRAME_SIZE        64
-#define QUEUE_DEPTH       4   /* profundidad de colas */
+#define QUEUE_DEPTH       1   /* a lo más una mitad del ping-pong esperando al DSP */
 /* params de autotune*/
 #define PITCH_ALPHA   1.0f
 #define CORR_STRENGTH 1.0f
@@ -77,44 +84,73 @@ static const struct dac_channel_cfg dac_ch_cfg = {
 #define DAC_MAX_F     ((float)((1u << DAC_BITS) - 1u))
 
 
-struct audio_block {
-	uint16_t data[FRAME_SIZE];
-};
+/* Buffers ping-pong: el DMA llena/lee una mitad mientras el DSP usa la otra */
+static uint16_t adc_buf[2][FRAME_SIZE] __aligned(4);
+static uint16_t dac_buf[2][FRAME_SIZE] __aligned(4);
 
-K_MSGQ_DEFINE(adc_to_dsp_q, sizeof(struct audio_block), QUEUE_DEPTH, 4);
-K_MSGQ_DEFINE(dsp_to_io_q,  sizeof(struct audio_block), QUEUE_DEPTH, 4);
+/* La ISR del DMA manda el índice de la mitad lista */
+K_MSGQ_DEFINE(block_ready_q, sizeof(uint8_t), QUEUE_DEPTH, 1);
 
-/* Semáforo de sampleo: timer da, audio_io_thread toma */
-K_SEM_DEFINE(sample_sem, 0, 1);
+static volatile uint32_t audio_blocks;
+static volatile uint32_t audio_overruns;   /* el DSP no terminó la mitad anterior a tiempo */
+static atomic_t          dsp_pending;      /* mitades encoladas o en proceso en el DSP */
+static atomic_t          dsp_busy_cycles;  /* ciclos procesando desde el último reporte */
+static atomic_t          dsp_block_max;    /* peor bloque desde el último reporte (ciclos) */
 
 /* ===================== AUTOTUNE: detector de pitch + pitch shifter ===================== */
 
 /* Rango de F0 (voz humana aprox) */
-#define F0_MIN_HZ       80.0f
+#define PITCH_F0_MIN_HZ 80u
 #define F0_MAX_HZ       600.0f
 
-/* Tamaño de ventana para pitch (en muestras) */
-#define PITCH_BUF_SIZE        256   /* 256/8000 = 32 ms de ventana */
+/* Ventana y periodo de actualización en ms: en muestras salen de AUDIO_FS_HZ */
+#define PITCH_WINDOW_MS       32u
+#define PITCH_UPDATE_MS       32u
+
+/* Tamaño de ventana para pitch (en muestras, múltiplo de PITCH_DECIM): 512 a 16 kHz */
+#define PITCH_BUF_SIZE        ((int)((AUDIO_FS_HZ * PITCH_WINDOW_MS) / 1000u) / PITCH_DECIM * PITCH_DECIM)
 
-/* Cada cuántas muestras actualizamos */
-#define PITCH_UPDATE_SAMPLES  264
+/* Cada cuántas muestras actualizamos (en frontera de bloque): 8 bloques a 16 kHz */
+#define PITCH_UPDATE_SAMPLES  ((int)((AUDIO_FS_HZ * PITCH_UPDATE_MS) / 1000u) / FRAME_SIZE * FRAME_SIZE)
+
+BUILD_ASSERT(PITCH_UPDATE_SAMPLES >= FRAME_SIZE, "PITCH_UPDATE_MS menor que un bloque");
 
 /* Umbral de energía para decidir si hay señal útil o silencio */
 #define ENERGY_THRESHOLD      0.01f
 
+/* Detector YIN de grueso a fino: primero con la señal diezmada, luego
+   solo unos cuantos retardos alrededor a la tasa completa */
+#define PITCH_DECIM           4
+#define PITCH_COARSE_SIZE     (PITCH_BUF_SIZE / PITCH_DECIM)
+#define PITCH_LAG_LIMIT       (PITCH_BUF_SIZE / 2 - PITCH_DECIM)  /* la ventana fina no baja de N/2 */
+#define PITCH_LAG_MAX         ((int)(AUDIO_FS_HZ / PITCH_F0_MIN_HZ))  /* periodo de la F0 más baja */
+#define YIN_THRESHOLD         0.20f   /* primer mínimo bajo este umbral = periodo */
+#define YIN_VOICED_MAX        0.35f   /* mínimo por encima: sin pitch claro */
+
+/* Recortar lag_max subiría en silencio la F0 más baja detectable */
+BUILD_ASSERT(PITCH_LAG_MAX <= PITCH_LAG_LIMIT, "PITCH_WINDOW_MS no cubre dos periodos de PITCH_F0_MIN_HZ");
+
 /* Buffer circular para detección de pitch */
 static float pitch_buf[PITCH_BUF_SIZE];
 static int   pitch_index = 0;
 static float current_f0_hz = 0.0f;
 
+/* Ventana en orden de tiempo para el hilo de pitch: el DSP la copia en la
+   frontera de actualización y el hilo la usa (y la modifica) hasta soltarla */
+static float    pitch_win[PITCH_BUF_SIZE];
+static atomic_t pitch_busy;
+static volatile uint32_t pitch_skipped;   /* actualizaciones con el hilo aún ocupado */
+K_SEM_DEFINE(pitch_sem, 0, 1);
+
 /* Buffer circular para pitch shifter */
 #define PROC_BUF_SIZE   2048
 static float proc_buf[PROC_BUF_SIZE];
 static int   write_pos = 0;
 static float read_pos  = 0.0f;
 
-/* Factor de pitch actual (1.0 = sin cambio) */
-static float pitch_factor = 0.5f;
+/* Factor de pitch actual (1.0 = sin cambio): lo escribe el hilo de pitch y
+   lo lee el DSP en cada muestra */
+static volatile float pitch_factor = 0.5f;
 
 static inline float fast_fabsf(float x)
 {
@@ -188,18 +224,38 @@ static inline void update_pitch_buffer(float sample)
 	}
 }
 
-/* ---- Estimar F0 por autocorrelación ---- */
-static void estimate_pitch(void)
+/* ---- Copiar el buffer circular a pitch_win, de la muestra más vieja a la
+   más nueva (dos memcpy: en el DSP cuesta poco más que leerlo) ---- */
+static void pitch_snapshot(void)
 {
-	float x[PITCH_BUF_SIZE];
-	int idx = pitch_index;
-	for (int i = 0; i < PITCH_BUF_SIZE; i++) {
-		x[i] = pitch_buf[idx];
-		idx++;
-		if (idx >= PITCH_BUF_SIZE) {
-			idx = 0;
-		}
+	int n = PITCH_BUF_SIZE - pitch_index;
+
+	memcpy(pitch_win, &pitch_buf[pitch_index], (size_t)n * sizeof(float));
+	memcpy(&pitch_win[n], pitch_buf, (size_t)pitch_index * sizeof(float));
+}
+
+/* ---- Función diferencia de YIN: d(tau) = sum (x[n] - x[n + tau])^2 ----
+   Con ventana fija (w) para que los retardos sean comparables */
+static float yin_diff(const float *x, int tau, int w)
+{
+	float d = 0.0f;
+
+	for (int n = 0; n < w; n++) {
+		float e = x[n] - x[n + tau];
+		d += e * e;
 	}
+	return d;
+}
+
+/* ---- Estimar F0 (YIN de grueso a fino + interpolación parabólica) ----
+   Costo fijo: con N = 512 y 80..600 Hz a 16 kHz son ~7k multiplicaciones,
+   contra ~70k de la autocorrelación por todos los retardos; a 44.1 kHz
+   (N = 1408) son ~40k, más que un bloque: por eso corre en su propio hilo */
+static void estimate_pitch(void)
+{
+	/* 1) La ventana ya viene en orden (pitch_snapshot) */
+	float *x = pitch_win;
+	float xd[PITCH_COARSE_SIZE];
 
 	/* 2) Quitar la media (DC) */
 	float mean = 0.0f;
@@ -223,36 +279,107 @@ static void estimate_pitch(void)
 
 	/*Rango de muestras correspondientes a los params de la voz*/
 	int lag_min = (int)(FS_HZ / F0_MAX_HZ);
-	int lag_max = (int)(FS_HZ / F0_MIN_HZ);
-	if (lag_max >= PITCH_BUF_SIZE) {
-		lag_max = PITCH_BUF_SIZE - 1;
+	int lag_max = PITCH_LAG_MAX;
+
+	/* 4) Grueso: diezmar (promedio de PITCH_DECIM, basta para F0 <= 600 Hz)
+	   y diferencia normalizada acumulada (CMND) de 1 a cmax */
+	for (int i = 0; i < PITCH_COARSE_SIZE; i++) {
+		float acc = 0.0f;
+		for (int k = 0; k < PITCH_DECIM; k++) {
+			acc += x[i * PITCH_DECIM + k];
+		}
+		xd[i] = acc * (1.0f / (float)PITCH_DECIM);
 	}
 
-	float best_r = 0.0f;
-	int   best_lag = lag_min;
+	int cmin = lag_min / PITCH_DECIM;
+	int cmax = (lag_max + PITCH_DECIM - 1) / PITCH_DECIM;
+	int cw   = PITCH_COARSE_SIZE - cmax - 1;
+	float cmnd[(PITCH_LAG_MAX + PITCH_DECIM - 1) / PITCH_DECIM + 2];
+	float running = 0.0f;
 
-	/* Autocorrelación, 
-	detecta que tanto se parecen, se tiene que elegir el retardo que maximice la similitud */
-	for (int lag = lag_min; lag <= lag_max; lag++) {
-		float r = 0.0f;
-		for (int n = 0; n < PITCH_BUF_SIZE - lag; n++) {
-			r += x[n] * x[n + lag];
+	if (cmin < 1) {
+		cmin = 1;
+	}
+	for (int tau = 1; tau <= cmax + 1; tau++) {
+		float d = yin_diff(xd, tau, cw);
+		running += d;
+		cmnd[tau] = (running > 0.0f) ? (d * (float)tau / running) : 1.0f;
+	}
+
+	/* Primer mínimo local bajo el umbral (evita octavas abajo); si no hay, el
+	   global. Su valor se interpola: diezmado, el periodo cae entre dos retardos */
+	int best = -1;
+	cmnd[0] = 1.0f;
+	for (int tau = cmin; tau <= cmax; tau++) {
+		float cm = cmnd[tau - 1];
+		float c0 = cmnd[tau];
+		float cp = cmnd[tau + 1];
+		if ((c0 > cm) || (c0 > cp)) {
+			continue;
 		}
-		if (r > best_r) {
-			best_r   = r;
-			best_lag = lag;
+		float den  = cm - 2.0f * c0 + cp;
+		float vmin = (den > 0.0f) ? (c0 - (cm - cp) * (cm - cp) / (8.0f * den)) : c0;
+		if (vmin < YIN_THRESHOLD) {
+			best = tau;
+			break;
+		}
+	}
+	if (best < 0) {
+		best = cmin;
+		for (int tau = cmin + 1; tau <= cmax; tau++) {
+			if (cmnd[tau] < cmnd[best]) {
+				best = tau;
+			}
+		}
+		if (cmnd[best] > YIN_VOICED_MAX) {
+			current_f0_hz = 0.0f;
+			return;
 		}
 	}
 
-	/* Convertir muestras a la  F0 */
-	if (best_r > 0.0f) {
-		current_f0_hz = FS_HZ / (float)best_lag;
-	} else {
+	/* 5) Fino: a la tasa completa, solo retardos a +-(PITCH_DECIM - 1) del grueso */
+	int lo = best * PITCH_DECIM - (PITCH_DECIM - 1);
+	int hi = best * PITCH_DECIM + (PITCH_DECIM - 1);
+	if (lo < lag_min) {
+		lo = lag_min;
+	}
+	if (hi > lag_max) {
+		hi = lag_max;
+	}
+	if (lo > hi) {
 		current_f0_hz = 0.0f;
+		return;
+	}
+
+	int   fw = PITCH_BUF_SIZE - lag_max - 1;
+	float d[2 * PITCH_DECIM + 1];          /* d(lo - 1) .. d(hi + 1) */
+	int   best_lag = lo;
+	for (int tau = lo - 1; tau <= hi + 1; tau++) {
+		d[tau - (lo - 1)] = yin_diff(x, tau, fw);
+	}
+	for (int tau = lo + 1; tau <= hi; tau++) {
+		if (d[tau - (lo - 1)] < d[best_lag - (lo - 1)]) {
+			best_lag = tau;
+		}
+	}
+
+	/* 6) Parábola por d(tau - 1), d(tau), d(tau + 1): retardo fraccional */
+	float dm = d[best_lag - 1 - (lo - 1)];
+	float d0 = d[best_lag - (lo - 1)];
+	float dp = d[best_lag + 1 - (lo - 1)];
+	float den = dm - 2.0f * d0 + dp;
+	float shift = 0.0f;
+	if (den > 0.0f) {
+		shift = 0.5f * (dm - dp) / den;
+		if (shift > 0.5f)  shift = 0.5f;
+		if (shift < -0.5f) shift = -0.5f;
 	}
+
+	/* Convertir muestras a la  F0 */
+	current_f0_hz = FS_HZ / ((float)best_lag + shift);
 }
 
-bool silence = false;
+volatile bool silence = false;
 
 static void update_pitch_factor(void)
 {
@@ -328,136 +455,286 @@ static inline float pitchshift_process_sample(float x_in)
 }
 
 
-static void sample_timer_cb(struct k_timer *timer)
+/* ===================== Audio IO por DMA ===================== */
+/*
+ * PDB0 corre en modo continuo a AUDIO_FS_HZ y dispara ADC1 por hardware.
+ * Cada conversión pide DMA (canal 0): ADC1->R[0] -> adc_buf, 2 bloques en
+ * anillo con interrupción a la mitad y al final. El canal 0 se liga
+ * (minor link) al canal 1, que copia una muestra de dac_buf a DAC0 en el
+ * mismo instante: ADC y DAC quedan en fase sin otro timer.
+ *
+ * El CPU solo entra una vez por bloque de FRAME_SIZE muestras.
+ */
+
+#define AUDIO_DMA_CH_ADC     0u
+#define AUDIO_DMA_CH_DAC     1u
+#define AUDIO_DMA_IRQ_PRIO   1
+#define AUDIO_PDB_CH_ADC1    1u     /* PDB0 canal 1 = ADC1 */
+#define AUDIO_RING_SAMPLES   (2u * FRAME_SIZE)
+#define AUDIO_RING_BYTES     (AUDIO_RING_SAMPLES * sizeof(uint16_t))
+
+#define ADC_INPUT_CHANNEL    DT_IO_CHANNELS_INPUT_BY_IDX(ZEPHYR_USER_NODE, 0)
+
+/* El PDB, el disparo y la petición de DMA de abajo son los de ADC1 */
+BUILD_ASSERT(DT_SAME_NODE(DT_IO_CHANNELS_CTLR_BY_IDX(ZEPHYR_USER_NODE, 0), DT_NODELABEL(adc1)),
+	     "io-channels de /zephyr,user debe ser ADC1");
+
+static volatile uint32_t audio_dma_errors;
+static volatile uint32_t audio_dma_last_es;   /* DMA0->ES del último error */
+static volatile uint32_t audio_pdb_errors;    /* conversiones que el DMA no alcanzó a leer */
+
+static void audio_dma_load_tcds(void);
+
+static void audio_dma_isr(const void *arg)
 {
-	ARG_UNUSED(timer);
-	k_sem_give(&sample_sem); //semafor al muestreo que queremos 
+	ARG_UNUSED(arg);
+
+	/* Lo que falta del major loop dice qué mitad terminó:
+	   <= FRAME_SIZE tras la mitad, recargado a 2*FRAME_SIZE al final */
+	uint16_t citer = DMA0->TCD[AUDIO_DMA_CH_ADC].CITER_ELINKYES & DMA_CITER_ELINKYES_CITER_MASK;
+	uint8_t  half  = (citer <= FRAME_SIZE) ? 0u : 1u;
+
+	DMA0->CINT = DMA_CINT_CINT(AUDIO_DMA_CH_ADC);
+	audio_blocks++;
+	/* Al terminar esta mitad el DMA empieza a sacar dac_buf de la otra: si el
+	   DSP todavía la tiene (en la cola o a medias), ese bloque sale tarde */
+	if (atomic_get(&dsp_pending) != 0) {
+		audio_overruns++;
+	}
+	if (k_msgq_put(&block_ready_q, &half, K_NO_WAIT) == 0) {
+		(void)atomic_inc(&dsp_pending);
+	}
 }
 
-K_TIMER_DEFINE(sample_timer, sample_timer_cb, NULL);
+/* Error de DMA (bus o TCD): el canal se detiene a medias. Se guarda ES y se
+   recargan los dos canales desde el inicio del anillo; el bloque en curso se
+   pierde, pero ADC y DAC siguen en fase */
+static void audio_dma_error_isr(const void *arg)
+{
+	ARG_UNUSED(arg);
+
+	DMA0->CERQ = DMA_CERQ_CERQ(AUDIO_DMA_CH_ADC);
+	audio_dma_last_es = DMA0->ES;
+	audio_dma_errors++;
+	DMA0->CERR = DMA_CERR_CAEI_MASK;
+	audio_dma_load_tcds();
+	DMA0->SERQ = DMA_SERQ_SERQ(AUDIO_DMA_CH_ADC);
+}
 
+static void audio_dma_load_tcds(void)
+{
+	/* Canal 0: ADC1 -> adc_buf, 16 bits por petición, anillo de 2 bloques.
+	   Cada muestra liga al canal 1; en la última, el minor link se suprime
+	   y lo hace el major link */
+	DMA0->TCD[AUDIO_DMA_CH_ADC].SADDR         = (uint32_t)&ADC1->R[0];
+	DMA0->TCD[AUDIO_DMA_CH_ADC].SOFF          = 0;
+	DMA0->TCD[AUDIO_DMA_CH_ADC].ATTR          = DMA_ATTR_SSIZE(1) | DMA_ATTR_DSIZE(1);
+	DMA0->TCD[AUDIO_DMA_CH_ADC].NBYTES_MLNO   = sizeof(uint16_t);
+	DMA0->TCD[AUDIO_DMA_CH_ADC].SLAST         = 0;
+	DMA0->TCD[AUDIO_DMA_CH_ADC].DADDR         = (uint32_t)&adc_buf[0][0];
+	DMA0->TCD[AUDIO_DMA_CH_ADC].DOFF          = sizeof(uint16_t);
+	DMA0->TCD[AUDIO_DMA_CH_ADC].DLAST_SGA     = -(int32_t)AUDIO_RING_BYTES;
+	DMA0->TCD[AUDIO_DMA_CH_ADC].CITER_ELINKYES = DMA_CITER_ELINKYES_ELINK_MASK |
+		DMA_CITER_ELINKYES_LINKCH(AUDIO_DMA_CH_DAC) | DMA_CITER_ELINKYES_CITER(AUDIO_RING_SAMPLES);
+	DMA0->TCD[AUDIO_DMA_CH_ADC].BITER_ELINKYES = DMA_BITER_ELINKYES_ELINK_MASK |
+		DMA_BITER_ELINKYES_LINKCH(AUDIO_DMA_CH_DAC) | DMA_BITER_ELINKYES_BITER(AUDIO_RING_SAMPLES);
+	DMA0->TCD[AUDIO_DMA_CH_ADC].CSR           = DMA_CSR_INTHALF_MASK | DMA_CSR_INTMAJOR_MASK |
+		DMA_CSR_MAJORELINK_MASK | DMA_CSR_MAJORLINKCH(AUDIO_DMA_CH_DAC);
+
+	/* Canal 1: dac_buf -> DAC0 DAT[0] (DATL/DATH en una escritura de 16 bits).
+	   Sin petición propia: solo corre cuando lo liga el canal 0 */
+	DMA0->TCD[AUDIO_DMA_CH_DAC].SADDR         = (uint32_t)&dac_buf[0][0];
+	DMA0->TCD[AUDIO_DMA_CH_DAC].SOFF          = sizeof(uint16_t);
+	DMA0->TCD[AUDIO_DMA_CH_DAC].ATTR          = DMA_ATTR_SSIZE(1) | DMA_ATTR_DSIZE(1);
+	DMA0->TCD[AUDIO_DMA_CH_DAC].NBYTES_MLNO   = sizeof(uint16_t);
+	DMA0->TCD[AUDIO_DMA_CH_DAC].SLAST         = -(int32_t)AUDIO_RING_BYTES;
+	DMA0->TCD[AUDIO_DMA_CH_DAC].DADDR         = (uint32_t)&DAC0->DAT[0].DATL;
+	DMA0->TCD[AUDIO_DMA_CH_DAC].DOFF          = 0;
+	DMA0->TCD[AUDIO_DMA_CH_DAC].DLAST_SGA     = 0;
+	DMA0->TCD[AUDIO_DMA_CH_DAC].CITER_ELINKNO = DMA_CITER_ELINKNO_CITER(AUDIO_RING_SAMPLES);
+	DMA0->TCD[AUDIO_DMA_CH_DAC].BITER_ELINKNO = DMA_BITER_ELINKNO_BITER(AUDIO_RING_SAMPLES);
+	DMA0->TCD[AUDIO_DMA_CH_DAC].CSR           = 0;
+}
 
-#define AUDIO_IO_STACK_SIZE  2048
-#define AUDIO_IO_PRIORITY    0   
+static void audio_dma_setup(void)
+{
+	CLOCK_EnableClock(kCLOCK_Dmamux0);
+	CLOCK_EnableClock(kCLOCK_Dma0);
+
+	DMAMUX->CHCFG[AUDIO_DMA_CH_ADC] = 0;
+	audio_dma_load_tcds();
+
+	DMAMUX->CHCFG[AUDIO_DMA_CH_ADC] = DMAMUX_CHCFG_ENBL_MASK |
+		DMAMUX_CHCFG_SOURCE((uint32_t)kDmaRequestMux0ADC1 & 0xFFu);
+	DMA0->SEEI = DMA_SEEI_SEEI(AUDIO_DMA_CH_ADC);
+	DMA0->SEEI = DMA_SEEI_SEEI(AUDIO_DMA_CH_DAC);
+	DMA0->SERQ = DMA_SERQ_SERQ(AUDIO_DMA_CH_ADC);
+
+	IRQ_CONNECT(DMA0_IRQn, AUDIO_DMA_IRQ_PRIO, audio_dma_isr, NULL, 0);
+	irq_enable(DMA0_IRQn);
+	IRQ_CONNECT(DMA_Error_IRQn, AUDIO_DMA_IRQ_PRIO, audio_dma_error_isr, NULL, 0);
+	irq_enable(DMA_Error_IRQn);
+}
 
-K_THREAD_STACK_DEFINE(audio_io_stack, AUDIO_IO_STACK_SIZE);
-static struct k_thread audio_io_thread_data;
+/* El driver de Zephyr ya inicializó y calibró ADC1 y encendió el DAC; aquí
+   se cambia ADC1 a disparo por hardware (PDB) con petición de DMA */
+static void audio_adc_setup(void)
+{
+	SIM->SOPT7 &= ~SIM_SOPT7_ADC1ALTTRGEN_MASK;     /* disparo de ADC1 = PDB0 */
+	ADC1->SC2 |= ADC_SC2_ADTRG_MASK | ADC_SC2_DMAEN_MASK;
+	ADC1->SC3 &= ~ADC_SC3_ADCO_MASK;
+	ADC1->SC1[0] = ADC_SC1_ADCH(ADC_INPUT_CHANNEL); /* sin AIEN: avisa el DMA */
+}
 
-/* Hilo de audio IO, más priodiad */
-static void audio_io_thread(void *p1, void *p2, void *p3)
+/* Error de secuencia: el PDB disparó ADC1 antes de que el DMA leyera la
+   conversión anterior (la muestra se pierde). Se limpia escribiendo 0 */
+static void audio_pdb_isr(const void *arg)
 {
-	struct audio_block in_block;
-	struct audio_block out_block;
-	int in_index  = 0;
-	int out_index = 0;
+	ARG_UNUSED(arg);
 
-	for (int i = 0; i < FRAME_SIZE; i++) {
-		out_block.data[i] = (uint16_t)(DAC_MAX_F / 2.0f);
+	if ((PDB0->CH[AUDIO_PDB_CH_ADC1].S & PDB_S_ERR_MASK) != 0u) {
+		audio_pdb_errors++;
+		PDB0->CH[AUDIO_PDB_CH_ADC1].S &= ~PDB_S_ERR_MASK;
 	}
-	uint16_t adc_raw;
-	struct adc_sequence seq = {
-		.buffer      = &adc_raw,
-		.buffer_size = sizeof(adc_raw),
-	};
+}
 
-	while (1) {
-		k_sem_take(&sample_sem, K_FOREVER);
+static void audio_pdb_start(void)
+{
+	CLOCK_EnableClock(kCLOCK_Pdb0);
+
+	IRQ_CONNECT(PDB0_IRQn, AUDIO_DMA_IRQ_PRIO, audio_pdb_isr, NULL, 0);
+	irq_enable(PDB0_IRQn);
+
+	PDB0->SC  = PDB_SC_PDBEN_MASK | PDB_SC_CONT_MASK | PDB_SC_PDBEIE_MASK |
+		    PDB_SC_TRGSEL(15u);  /* 15 = software */
+	PDB0->MOD = (CLOCK_GetBusClkFreq() / AUDIO_FS_HZ) - 1u;
+	PDB0->IDLY = 0;
+	PDB0->CH[AUDIO_PDB_CH_ADC1].DLY[0] = 0;
+	PDB0->CH[AUDIO_PDB_CH_ADC1].C1 = PDB_C1_EN(1u) | PDB_C1_TOS(1u);
+	PDB0->SC |= PDB_SC_LDOK_MASK;
+	PDB0->SC |= PDB_SC_SWTRIG_MASK;
+}
 
-		(void)adc_sequence_init_dt(&adc_channels[0], &seq);
-		int err = adc_read_dt(&adc_channels[0], &seq);
-		if (err < 0) {
-			adc_raw = (uint16_t)ADC_MID_F; 
+static void audio_io_start(void)
+{
+	for (int h = 0; h < 2; h++) {
+		for (int i = 0; i < FRAME_SIZE; i++) {
+			dac_buf[h][i] = (uint16_t)(DAC_MAX_F / 2.0f);
 		}
+	}
+	audio_adc_setup();
+	audio_dma_setup();
+	audio_pdb_start();
+}
 
-		in_block.data[in_index++] = adc_raw;
+/* ===================== Hilo de pitch ===================== */
 
-		if (in_index >= FRAME_SIZE) {
-			(void)k_msgq_put(&adc_to_dsp_q, &in_block, K_NO_WAIT);
-			in_index = 0;
-		}
-		uint16_t dac_code = out_block.data[out_index++];
-
-		if (out_index >= FRAME_SIZE) {
-			struct audio_block new_block;
-			if (k_msgq_get(&dsp_to_io_q, &new_block, K_NO_WAIT) == 0) {
-				out_block = new_block;
-				out_index = 0;
-				dac_code  = out_block.data[out_index++];
-			} else {
-				/* for (int i = 0; i < FRAME_SIZE; i++) {
-					out_block.data[i] = adc_raw;
-				} */
-				/* float x = ((float)adc_raw - ADC_MID_F) / ADC_MID_F;
-				float dac_f = (x * 0.5f + 0.5f) * DAC_MAX_F;
-				out_block = 
-				dac_code    = (uint16_t)(dac_f + 0.5f);
-				*/
-				out_index = 0; 
-			}
-			
-			
-		}
+/* Debajo del DSP: el bloque de audio lo interrumpe y siempre llega a tiempo;
+   el detector tiene PITCH_UPDATE_MS para terminar. La diezmada va en la pila */
+#define PITCH_STACK_SIZE   (3072 + PITCH_COARSE_SIZE * (int)sizeof(float))
+#define PITCH_PRIORITY     2
+
+K_THREAD_STACK_DEFINE(pitch_stack, PITCH_STACK_SIZE);
+static struct k_thread pitch_thread_data;
+
+static void pitch_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
 
-		(void)dac_write_value(dac_dev, DAC_CHANNEL_ID, dac_code);
+	while (1) {
+		k_sem_take(&pitch_sem, K_FOREVER);
+		estimate_pitch();
+		update_pitch_factor();
+		(void)atomic_set(&pitch_busy, 0);
+	}
+}
+
+/* Desde el DSP: si el hilo de pitch ya soltó la ventana anterior, copia la
+   actual y lo despierta; si no, esta actualización se salta */
+static void pitch_request(void)
+{
+	if (atomic_get(&pitch_busy) != 0) {
+		pitch_skipped++;
+		return;
 	}
+	(void)atomic_set(&pitch_busy, 1);
+	pitch_snapshot();
+	k_sem_give(&pitch_sem);
 }
 
 /* ===================== Hilo de AUTOTUNE ===================== */
 
-#define DSP_STACK_SIZE   4096
+#define DSP_STACK_SIZE   2048
 #define DSP_PRIORITY     1   /* procesamiento */
 
 K_THREAD_STACK_DEFINE(dsp_stack, DSP_STACK_SIZE);
 static struct k_thread dsp_thread_data;
 
-static void dsp_thread(void *p1, void *p2, void *p3)
-{
-	ARG_UNUSED(p1);
-	ARG_UNUSED(p2);
-	ARG_UNUSED(p3);
+static uint32_t global_sample_count = 0;
 
-	struct audio_block in_block;
-	struct audio_block out_block;
-	uint32_t global_sample_count = 0;
+/* Un bloque del ping-pong: adc_buf[half] -> dac_buf[half] (se reproduce un
+   bloque después). Peor caso: el bloque que copia la ventana para el pitch */
+static void dsp_process_block(uint8_t half)
+{
+	const uint16_t *in  = adc_buf[half];
+	uint16_t       *out = dac_buf[half];
 	float y_autotune;
 
-	while (1) {
-		/* Esperar un bloque desde el hilo de IO a procesar */
-		k_msgq_get(&adc_to_dsp_q, &in_block, K_FOREVER);
+	for (int n = 0; n < FRAME_SIZE; n++) {
+		/* 1) Pasar ADC (0..4095) a float aprox -1..1 */
+		float x = ((float)in[n] - ADC_MID_F) / ADC_MID_F;
 
-		for (int n = 0; n < FRAME_SIZE; n++) {
-			/* 1) Pasar ADC (0..4095) a float aprox -1..1 */
-			float x = ((float)in_block.data[n] - ADC_MID_F) / ADC_MID_F;
+		/* 2) Actualizar buffer de pitch (rama análisis) */
+		update_pitch_buffer(x);
 
-			/* 2) Actualizar buffer de pitch (rama análisis) */
-			update_pitch_buffer(x);
+		/* 3) Pitch shifter: aplicar factor a la señal directa */
+		if(silence){
+			pitch_factor        = 1.0f;
+			read_pos            = write_pos;  // alineas lectura con escritura
+			y_autotune = x; 
+		}else{
+			y_autotune = pitchshift_process_sample(x);
 
-			/* 3) Pitch shifter: aplicar factor a la señal directa */
-			if(silence){
-				pitch_factor        = 1.0f;
-				read_pos            = write_pos;  // alineas lectura con escritura
-				y_autotune = x; 
-			}else{
-				y_autotune = pitchshift_process_sample(x);
 
+		}
 
-			}
+		global_sample_count++; //numero de samples para actualizar el pitch 
+		if ((global_sample_count % PITCH_UPDATE_SAMPLES) == 0U) {
+			pitch_request();
+		}
+		//escalar para el dac
+		if (y_autotune >  0.999f) y_autotune =  0.999f;
+		if (y_autotune < -0.999f) y_autotune = -0.999f;
 
-			global_sample_count++; //numero de samples para actualizar el pitch 
-			if ((global_sample_count % PITCH_UPDATE_SAMPLES) == 0U) {
-				estimate_pitch();
-				update_pitch_factor();
-			}
-			//escalar para el dac
-			if (y_autotune >  0.999f) y_autotune =  0.999f;
-			if (y_autotune < -0.999f) y_autotune = -0.999f;
+		float dac_f       = (y_autotune * 0.5f + 0.5f) * DAC_MAX_F;
+		uint16_t dac_code = (uint16_t)(dac_f + 0.5f);
+		out[n] = dac_code;
+	}
+}
 
-			float dac_f       = (y_autotune * 0.5f + 0.5f) * DAC_MAX_F;
-			uint16_t dac_code = (uint16_t)(dac_f + 0.5f);
-			out_block.data[n] = dac_code;
-		}
+static void dsp_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
 
-		k_msgq_put(&dsp_to_io_q, &out_block, K_FOREVER); //manda el bloque para el dac
+	uint8_t half;
+
+	while (1) {
+		/* Esperar a que el DMA termine una mitad del ping-pong */
+		k_msgq_get(&block_ready_q, &half, K_FOREVER);
+
+		uint32_t t0 = k_cycle_get_32();
+		dsp_process_block(half);
+		uint32_t dt = k_cycle_get_32() - t0;
+
+		(void)atomic_add(&dsp_busy_cycles, (atomic_val_t)dt);
+		if (dt > (uint32_t)atomic_get(&dsp_block_max)) {
+			(void)atomic_set(&dsp_block_max, (atomic_val_t)dt);
+		}
+		(void)atomic_dec(&dsp_pending);
 	}
 }
 
@@ -518,25 +795,8 @@ int main(void)
 	printk("DAC listo: %s, canal %d, resolución %d bits\n",
 	       dac_dev->name, DAC_CHANNEL_ID, DAC_RESOLUTION);
 
-	/* ----- Arrancar timer de muestreo a ~8 kHz ----- */
-	printk("Iniciando k_timer de muestreo cada %u us (~%.1f Hz)\n",
-	       SAMPLE_PERIOD_US, (double)FS_HZ);
-
-	k_timer_start(&sample_timer,
-	              K_NO_WAIT,
-	              K_USEC(SAMPLE_PERIOD_US));
-
-	/* ----- Crear hilos de AUDIO IO y DSP ----- */
-	printk("Creando hilos de audio_io y dsp...\n");
-
-	k_thread_create(&audio_io_thread_data,
-	                audio_io_stack,
-	                K_THREAD_STACK_SIZEOF(audio_io_stack),
-	                audio_io_thread,
-	                NULL, NULL, NULL,
-	                AUDIO_IO_PRIORITY,
-	                0,
-	                K_NO_WAIT);
+	/* ----- Crear hilo DSP ----- */
+	printk("Creando hilo dsp...\n");
 
 	k_thread_create(&dsp_thread_data,
 	                dsp_stack,
@@ -547,9 +807,37 @@ int main(void)
 	                0,
 	                K_NO_WAIT);
 
-	
+	k_thread_create(&pitch_thread_data,
+	                pitch_stack,
+	                K_THREAD_STACK_SIZEOF(pitch_stack),
+	                pitch_thread,
+	                NULL, NULL, NULL,
+	                PITCH_PRIORITY,
+	                0,
+	                K_NO_WAIT);
+
+	/* ----- Arrancar PDB + ADC + DMA + DAC ----- */
+	printk("Audio por DMA: fs = %u Hz, bloques de %d muestras\n",
+	       AUDIO_FS_HZ, FRAME_SIZE);
+	audio_io_start();
+
+	/* Ciclos de un bloque: el DSP tiene que terminar cada uno en menos */
+	uint32_t block_budget = (uint32_t)(((uint64_t)sys_clock_hw_cycles_per_sec() * FRAME_SIZE) / AUDIO_FS_HZ);
+
+	/* Reporte: bloques, bloques perdidos, errores de DMA/PDB y carga del DSP */
 	while (1) {
+		uint32_t t0 = k_cycle_get_32();
 		k_sleep(K_SECONDS(5));
-	
+		uint32_t busy = (uint32_t)atomic_set(&dsp_busy_cycles, 0);
+		uint32_t worst = (uint32_t)atomic_set(&dsp_block_max, 0);
+		uint32_t total = k_cycle_get_32() - t0;
+
+		printk("bloques: %u, overruns: %u, err DMA: %u (ES 0x%08x), err PDB: %u, carga DSP: %u.%u %%\n",
+		       audio_blocks, audio_overruns,
+		       audio_dma_errors, audio_dma_last_es, audio_pdb_errors,
+		       (uint32_t)(((uint64_t)busy * 100u) / total),
+		       (uint32_t)((((uint64_t)busy * 1000u) / total) % 10u));
+		printk("peor bloque: %u de %u ciclos, pitch saltados: %u\n",
+		       worst, block_budget, pitch_skipped);
 	}
 }